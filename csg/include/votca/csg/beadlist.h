@@ -27,13 +27,17 @@
 #include <votca/tools/eigen.h>
 #include <votca/tools/types.h>
 
+// Local VOTCA includes
+#include "beadselection.h"
+
 namespace votca {
 namespace csg {
 /**
     \brief Generate lists of beads
 
     This class generates a list of beads based on some criteria, currently
-    only the bead type.
+    only the bead type or name. For per-frame use, pass a BeadSelection which
+    keeps the compiled selection between frames.
 
 */
 
@@ -44,10 +48,14 @@ class BeadList {
  public:
   /// \brief Select all beads of type <select>
   Index Generate(Topology &top, const std::string &select);
+  /// \brief Select all beads of a compiled selection
+  Index Generate(Topology &top, BeadSelection &select);
   /// \brief Select all beads of type <select> withn a radius <radius> of
   /// reference vector <ref>
   Index GenerateInSphericalSubvolume(Topology &top, const std::string &select,
                                      Eigen::Vector3d ref, double radius);
+  Index GenerateInSphericalSubvolume(Topology &top, BeadSelection &select,
+                                     Eigen::Vector3d ref, double radius);
 
   Index size() const { return beads_.size(); }
 
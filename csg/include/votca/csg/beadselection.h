@@ -0,0 +1,73 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_CSG_BEADSELECTION_H
+#define VOTCA_CSG_BEADSELECTION_H
+
+// Standard includes
+#include <string>
+#include <vector>
+
+// VOTCA includes
+#include <votca/tools/types.h>
+
+namespace votca {
+namespace csg {
+
+class Topology;
+
+/**
+    \brief Bead selection compiled into an index list
+
+    A selection string is either a wildcard pattern on the bead type or,
+    prefixed by "name:", a wildcard pattern on the bead name. Optionally the
+    selection can be restricted to beads in molecules whose name matches a
+    second pattern.
+
+    The selection is evaluated once per topology and cached as a list of bead
+    ids. The cache is only rebuilt if the revision of the topology changes, so
+    per-frame analyses do not have to evaluate the wildcards for every bead in
+    every frame. An instance is not thread safe, every worker needs its own.
+*/
+class BeadSelection {
+ public:
+  BeadSelection() = default;
+  explicit BeadSelection(const std::string &select,
+                         const std::string &molname = "");
+
+  const std::string &getSelection() const { return select_; }
+
+  /// \brief ids of all beads in top matching the selection
+  const std::vector<Index> &Select(const Topology &top);
+
+ private:
+  void Compile(const Topology &top);
+
+  std::string select_;
+  std::string pattern_;
+  std::string molname_;
+  bool by_name_ = false;
+
+  std::vector<Index> ids_;
+  Index revision_ = -1;
+};
+
+}  // namespace csg
+}  // namespace votca
+
+#endif  // VOTCA_CSG_BEADSELECTION_H
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_CSG_BOUNDARYCONDITIONDISPATCH_H
+#define VOTCA_CSG_BOUNDARYCONDITIONDISPATCH_H
+#pragma once
+
+// Standard includes
+#include <stdexcept>
+
+// Local VOTCA includes
+#include "boundarycondition.h"
+#include "openbox.h"
+#include "orthorhombicbox.h"
+#include "triclinicbox.h"
+
+namespace votca {
+namespace csg {
+
+/**
+ * @brief Calls a functor with the boundary condition cast to its concrete type
+ *
+ * BCShortestConnection is final in all box types, so inside the functor
+ * (usually a generic lambda) the minimum image calculation is resolved at
+ * compile time and can be inlined into the pair loop. The type switch is done
+ * once, e.g. per frame, instead of a virtual call per pair:
+ *
+ *   DispatchBoundaryCondition(top.getBoundary(), [&](const auto &bc) {
+ *     for (...) { Eigen::Vector3d r = bc.BCShortestConnection(u, v); }
+ *   });
+ *
+ * @return the value returned by the functor
+ */
+template <typename Functor>
+decltype(auto) DispatchBoundaryCondition(const BoundaryCondition &bc,
+                                         Functor &&f) {
+  switch (bc.getBoxType()) {
+    case BoundaryCondition::typeOrthorhombic:
+      return f(static_cast<const OrthorhombicBox &>(bc));
+    case BoundaryCondition::typeTriclinic:
+      return f(static_cast<const TriclinicBox &>(bc));
+    case BoundaryCondition::typeOpen:
+      return f(static_cast<const OpenBox &>(bc));
+    default:
+      throw std::runtime_error("unknown boundary condition type");
+  }
+}
+
+}  // namespace csg
+}  // namespace votca
+
+#endif  // VOTCA_CSG_BOUNDARYCONDITIONDISPATCH_H
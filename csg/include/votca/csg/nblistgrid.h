@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2019 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -54,8 +54,11 @@ class NBListGrid : public NBList {
   cell_t &getCell(const Eigen::Vector3d &r);
   cell_t &getCell(const Index &a, const Index &b, const Index &c);
 
-  void TestBead(const Topology &top, cell_t &cell, Bead *bead);
-  void TestCell(const Topology &top, cell_t &cell, Bead *bead);
+  // BC is the concrete boundary condition type, see DispatchBoundaryCondition
+  template <typename BC>
+  void TestBead(const Topology &top, const BC &bc, cell_t &cell, Bead *bead);
+  template <typename BC>
+  void TestCell(const Topology &top, const BC &bc, cell_t &cell, Bead *bead);
 };
 
 }  // namespace csg
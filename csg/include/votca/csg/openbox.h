@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2019 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -37,6 +37,11 @@ class OpenBox : public BoundaryCondition {
   eBoxtype getBoxType() const noexcept final { return typeOpen; }
 };
 
+inline Eigen::Vector3d OpenBox::BCShortestConnection(
+    const Eigen::Vector3d &r_i, const Eigen::Vector3d &r_j) const {
+  return r_j - r_i;
+}
+
 }  // namespace csg
 }  // namespace votca
 
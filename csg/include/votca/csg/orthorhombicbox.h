@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2019 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -18,6 +18,12 @@
 #ifndef VOTCA_CSG_ORTHORHOMBICBOX_H
 #define VOTCA_CSG_ORTHORHOMBICBOX_H
 
+// Standard includes
+#include <cmath>
+
+// VOTCA includes
+#include <votca/tools/types.h>
+
 // Local VOTCA includes
 #include "boundarycondition.h"
 
@@ -39,6 +45,15 @@ class OrthorhombicBox : public BoundaryCondition {
  protected:
 };
 
+inline Eigen::Vector3d OrthorhombicBox::BCShortestConnection(
+    const Eigen::Vector3d &r_i, const Eigen::Vector3d &r_j) const {
+  Eigen::Vector3d r_ij = r_j - r_i;
+  for (Index k = 0; k < 3; k++) {
+    r_ij[k] -= box_(k, k) * std::rint(r_ij[k] / box_(k, k));
+  }
+  return r_ij;
+}
+
 }  // namespace csg
 }  // namespace votca
 
@@ -401,7 +401,22 @@ class Topology {
   bool HasForce() { return has_force_; }
   void SetHasForce(const bool v) { has_force_ = v; }
 
+  /**
+   * @brief Revision of the bead and molecule layout
+   *
+   * The revision changes whenever beads or molecules are created, renamed or
+   * removed. It is unique among all topologies of the process, so it can be
+   * used to invalidate data that was derived from the layout, e.g. compiled
+   * bead selections.
+   */
+  Index getRevision() const { return revision_; }
+
  protected:
+  /// assign a new revision after the bead or molecule layout changed
+  void BumpRevision();
+
+  Index revision_ = 0;
+
   std::unique_ptr<BoundaryCondition> bc_;
 
   BoundaryCondition::eBoxtype autoDetectBoxType(
@@ -441,11 +456,13 @@ inline Bead *Topology::CreateBead(Bead::Symmetry symmetry, std::string name,
                                   std::string type, Index resnr, double m,
                                   double q) {
 
+  BumpRevision();
   beads_.push_back(Bead(beads_.size(), type, symmetry, name, resnr, m, q));
   return &beads_.back();
 }
 
 inline Molecule *Topology::CreateMolecule(std::string name) {
+  BumpRevision();
   molecules_.push_back(Molecule(molecules_.size(), name));
   return &molecules_.back();
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2019 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -18,6 +18,9 @@
 #ifndef VOTCA_CSG_TRICLINICBOX_H
 #define VOTCA_CSG_TRICLINICBOX_H
 
+// Standard includes
+#include <cmath>
+
 // Local VOTCA includes
 #include "boundarycondition.h"
 
@@ -39,6 +42,24 @@ class TriclinicBox : public BoundaryCondition {
  protected:
 };
 
+/*
+ This way of determining the shortest distance is only working for a set of
+ triclinic boxes, in particular
+ a_y = a_z = b_z = 0
+ a_x > 0, b_y > 0, c_z > 0
+ b_x < 0.5 a_x, c_x < 0.5 a_x, c_y < 0.5 b_y
+ GROMACS checks if these conditions are satisfied.
+ If a simple search algorithm is used to determine if a particle
+ is a within cutoff r_c, make sure that r_c < 0.5 min(a_x, b_y, c_z)
+ */
+inline Eigen::Vector3d TriclinicBox::BCShortestConnection(
+    const Eigen::Vector3d &r_i, const Eigen::Vector3d &r_j) const {
+  Eigen::Vector3d r_tp = r_j - r_i;
+  Eigen::Vector3d r_dp = r_tp - box_.col(2) * std::rint(r_tp.z() / box_(2, 2));
+  Eigen::Vector3d r_sp = r_dp - box_.col(1) * std::rint(r_dp.y() / box_(1, 1));
+  return r_sp - box_.col(0) * std::rint(r_sp.x() / box_(0, 0));
+}
+
 }  // namespace csg
 }  // namespace votca
 
@@ -1,6 +1,6 @@
 #! /bin/bash
 #
-# Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+# Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -104,11 +104,11 @@ if [[ ${with_errors} = "yes" ]]; then
     msg --color blue --to-stderr "Automatically setting block_length to 2, because CSG_RUNTEST was set"
     block_length=2
   fi
-  error_opts="--block-length ${block_length}"
-  ext_opt="${dist_type}.block"
+  # csg_stat averages over the blocks and calculates the errors on the fly
+  error_opts="--block-length ${block_length} --block-stats --block-output none"
 else
   suffix="$suffix"
-  ext_opt="${dist_type}.new"
+  error_opts=""
 fi
 
 
@@ -122,19 +122,6 @@ else
   # this will give a codacy warning :/
   critical csg_stat --nt "${tasks}" --options "${CSGXMLFILE}" --top "${topol}" \
     --trj "${traj}" --begin "${equi_time}" --first-frame "${first_frame}" ${error_opts} \
-    "${intra_opts}" --ext "${ext_opt}" ${maps:+--cg ${maps}}
+    "${intra_opts}" --ext "${dist_type}.new" ${maps:+--cg ${maps}}
   mark_done "rdf_calculation${suffix}"
 fi
-
-if [[ ${with_errors} = "yes" ]]; then
-  if ! is_done "${name}_${dist_type}_rdf_average"; then
-    for i in ${name}_*.dist.block; do
-      [[ -f $i ]] || die "${0##*/}: Could not find ${name}_*.dist.block after running csg_sat, that usually means the blocksize (cg.inverse.${sim_prog}.rdf.block_length) is too big."
-    done
-    msg "Calculating average rdfs and its errors for interaction ${name}"
-    # do not put quotes around strings that should expand to multiple files
-    # this will give a codacy warning :/
-    do_external table average --output "${name}.${dist_type}.new" "${name}"_*."${dist_type}".block
-    mark_done "${name}_${dist_type}_rdf_average"
-  fi
-fi
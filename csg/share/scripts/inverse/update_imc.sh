@@ -31,6 +31,7 @@ do_external imc_stat $sim_prog
 
 default_reg=$(csg_get_property cg.inverse.imc.default_reg)
 is_num "${default_reg}" || die "${0##*/}: value of cg.inverse.imc.default_reg should be a number"
+algorithm=$(csg_get_property cg.inverse.imc.algorithm)
 
 imc_groups=$(csg_get_interaction_property --all inverse.imc.group)
 imc_groups=$(remove_duplicate $imc_groups)
@@ -42,7 +43,7 @@ for group in $imc_groups; do
   reg="$(csg_get_property cg.inverse.imc.${group}.reg ${default_reg})" #filter me away
   is_num "${reg}" || die "${0##*/}: value of cg.inverse.imc.${group}.reg should be a number"
   msg "solving linear equations for imc group '$group' (regularization ${reg})"
-  critical csg_imc_solve --imcfile "${group}.imc" --gmcfile "${group}.gmc" --idxfile "${group}.idx" --regularization "${reg}"
+  critical csg_imc_solve --imcfile "${group}.imc" --gmcfile "${group}.gmc" --idxfile "${group}.idx" --regularization "${reg}" --algorithm "${algorithm}"
 done
 
 for_all "non-bonded bonded" do_external update imc_single
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Local VOTCA includes
+#include "votca/csg/beadlist.h"
+#include "votca/csg/boundaryconditiondispatch.h"
+#include "votca/csg/nblist.h"
+#include "votca/csg/nblistgrid.h"
+#include "votca/csg/topology.h"
+
+using namespace votca;
+using namespace votca::csg;
+
+namespace {
+
+// returns the best time in seconds of all repetitions, the sum of the results
+// is accumulated in checksum, so the compiler cannot drop the payload
+template <class T>
+double Time(T &&payload, Index repetitions, double &checksum) {
+  double best = std::numeric_limits<double>::max();
+  for (Index i = 0; i < repetitions; i++) {
+    std::chrono::time_point<std::chrono::steady_clock> start =
+        std::chrono::steady_clock::now();
+    checksum += payload();
+    std::chrono::time_point<std::chrono::steady_clock> end =
+        std::chrono::steady_clock::now();
+    best = std::min(
+        best,
+        std::chrono::duration_cast<std::chrono::duration<double> >(end - start)
+            .count());
+  }
+  return best;
+}
+
+// counts pairs within the cutoff, without storing them
+class PairCounter {
+ public:
+  bool FoundPair(Bead *, Bead *, const Eigen::Vector3d &, double dist) {
+    count_++;
+    sum_ += dist;
+    return false;
+  }
+  Index count_ = 0;
+  double sum_ = 0.0;
+};
+
+void FillTopology(Topology &top, const Eigen::Matrix3d &box,
+                  const Eigen::MatrixXd &pos) {
+  top.setBox(box);
+  Molecule *mol = top.CreateMolecule("UNKNOWN");
+  std::string type = "CG";
+  top.RegisterBeadType(type);
+  for (Index i = 0; i < pos.cols(); i++) {
+    Bead *b = top.CreateBead(Bead::spherical, "A", type, 0, 1.0, 0.0);
+    b->setPos(pos.col(i));
+    mol->AddBead(b, type);
+  }
+}
+
+// minimum images of all pairs of beads through the virtual interface and
+// through the dispatched one, returns false if both disagree
+bool RunMinimumImage(const Topology &top, const std::string &name,
+                     Index nbeads, Index repetitions) {
+  std::vector<Eigen::Vector3d> pos;
+  for (Index i = 0; i < nbeads; i++) {
+    pos.push_back(top.getBead(i)->getPos());
+  }
+  const BoundaryCondition &bc_virtual = top.getBoundary();
+
+  double checksum_virtual = 0.0;
+  double t_virtual = Time(
+      [&]() {
+        double sum = 0.0;
+        for (Index i = 0; i < nbeads; i++) {
+          for (Index j = i + 1; j < nbeads; j++) {
+            sum += bc_virtual.BCShortestConnection(pos[i], pos[j])
+                       .squaredNorm();
+          }
+        }
+        return sum;
+      },
+      repetitions, checksum_virtual);
+
+  double checksum_dispatch = 0.0;
+  double t_dispatch = Time(
+      [&]() {
+        auto all_pairs = [&](const auto &bc) {
+          double sum = 0.0;
+          for (Index i = 0; i < nbeads; i++) {
+            for (Index j = i + 1; j < nbeads; j++) {
+              sum += bc.BCShortestConnection(pos[i], pos[j]).squaredNorm();
+            }
+          }
+          return sum;
+        };
+        return DispatchBoundaryCondition(top.getBoundary(), all_pairs);
+      },
+      repetitions, checksum_dispatch);
+
+  double ns = 1e9 / (0.5 * double(nbeads) * double(nbeads - 1));
+  std::cout << std::setw(14) << name << std::fixed << std::setprecision(2)
+            << std::setw(14) << t_virtual * ns << std::setw(14)
+            << t_dispatch * ns << std::setw(10) << t_virtual / t_dispatch
+            << std::endl;
+
+  double tolerance = 1e-8 * (std::abs(checksum_virtual) + 1.0);
+  if (std::abs(checksum_virtual - checksum_dispatch) > tolerance) {
+    std::cerr << name << ": virtual and dispatched minimum image differ "
+              << checksum_virtual << " vs " << checksum_dispatch << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// neighbour search with the simple and the grid list, returns false if both
+// find a different number of pairs
+bool RunNeighbourSearch(Topology &top, const std::string &name, double cutoff,
+                        Index repetitions) {
+  BeadList beads;
+  beads.Generate(top, "CG");
+
+  PairCounter simple_counter;
+  double checksum_simple = 0.0;
+  double t_simple = Time(
+      [&]() {
+        NBList nb;
+        nb.setCutoff(cutoff);
+        nb.SetMatchFunction(&simple_counter, &PairCounter::FoundPair);
+        nb.Generate(beads, false);
+        return simple_counter.sum_;
+      },
+      repetitions, checksum_simple);
+
+  PairCounter grid_counter;
+  double checksum_grid = 0.0;
+  double t_grid = Time(
+      [&]() {
+        NBListGrid nb;
+        nb.setCutoff(cutoff);
+        nb.SetMatchFunction(&grid_counter, &PairCounter::FoundPair);
+        nb.Generate(beads, false);
+        return grid_counter.sum_;
+      },
+      repetitions, checksum_grid);
+
+  std::cout << std::setw(14) << name << std::setw(14) << t_simple * 1e3
+            << std::setw(14) << t_grid * 1e3 << std::setw(10)
+            << simple_counter.count_ / repetitions << std::endl;
+
+  if (simple_counter.count_ != grid_counter.count_) {
+    std::cerr << name << ": simple and grid search found "
+              << simple_counter.count_ << " vs " << grid_counter.count_
+              << " pairs" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+
+  bool quick = (argc > 1 && std::string(argv[1]) == "--quick");
+  Index nbeads = quick ? 500 : 4000;
+  Index repetitions = quick ? 2 : 10;
+  double cutoff = 1.2;
+
+  Eigen::Matrix3d ortho = 6.0 * Eigen::Matrix3d::Identity();
+  Eigen::Matrix3d tric = ortho;
+  tric(0, 1) = 1.5;
+  tric(0, 2) = 1.0;
+  tric(1, 2) = 0.5;
+
+  // the same fractional coordinates in all boxes
+  Eigen::MatrixXd frac =
+      0.5 * (Eigen::MatrixXd::Random(3, nbeads).array() + 1.0);
+  Topology top_ortho;
+  FillTopology(top_ortho, ortho, ortho * frac);
+  Topology top_tric;
+  FillTopology(top_tric, tric, tric * frac);
+  Topology top_open;
+  FillTopology(top_open, Eigen::Matrix3d::Zero(), ortho * frac);
+
+  std::cout << "minimum image of all pairs, " << nbeads << " beads, best of "
+            << repetitions << " runs" << std::endl;
+  std::cout << std::setw(14) << "box" << std::setw(14) << "virtual[ns]"
+            << std::setw(14) << "dispatch[ns]" << std::setw(10) << "speedup"
+            << std::endl;
+  bool ok = true;
+  ok = RunMinimumImage(top_ortho, "orthorhombic", nbeads, repetitions) && ok;
+  ok = RunMinimumImage(top_tric, "triclinic", nbeads, repetitions) && ok;
+  ok = RunMinimumImage(top_open, "open", nbeads, repetitions) && ok;
+
+  std::cout << std::endl
+            << "neighbour search, cutoff " << cutoff << std::endl;
+  std::cout << std::setw(14) << "box" << std::setw(14) << "simple[ms]"
+            << std::setw(14) << "grid[ms]" << std::setw(10) << "pairs"
+            << std::endl;
+  ok = RunNeighbourSearch(top_ortho, "orthorhombic", cutoff, repetitions) &&
+       ok;
+  ok = RunNeighbourSearch(top_tric, "triclinic", cutoff, repetitions) && ok;
+  return ok ? 0 : 1;
+}
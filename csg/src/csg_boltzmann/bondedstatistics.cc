@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2019 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,29 +16,99 @@
  */
 
 #include "bondedstatistics.h"
+#include <cmath>
+#include <stdexcept>
+#include <votca/tools/tokenizer.h>
 
 using namespace votca::tools;
 
 namespace votca {
 namespace csg {
 
+void StreamedValues::Add(double value) {
+  Index bin = std::lround(value / resolution_);
+  if (counts_.empty()) {
+    offset_ = bin;
+  } else if (bin < offset_) {
+    counts_.insert(counts_.begin(), offset_ - bin, 0.0);
+    offset_ = bin;
+  }
+  if (bin - offset_ >= Index(counts_.size())) {
+    counts_.resize(bin - offset_ + 1, 0.0);
+  }
+  counts_[bin - offset_] += 1.0;
+  autocorrelation_.Add(value);
+}
+
+void StreamedValues::AppendHistogram(std::vector<double> &centers,
+                                     std::vector<double> &counts) const {
+  for (Index i = 0; i < Index(counts_.size()); ++i) {
+    if (counts_[i] > 0) {
+      centers.push_back(double(offset_ + i) * resolution_);
+      counts.push_back(counts_[i]);
+    }
+  }
+}
+
 void BondedStatistics::BeginCG(Topology *top, Topology *) {
   bonded_values_.clear();
+  streamed_.clear();
+  streamed_by_name_.clear();
   for (auto &interaction : top->BondedInteractions()) {
-    bonded_values_.CreateArray(interaction->getName());
+    if (streaming_) {
+      streamed_by_name_[interaction->getName()] = Index(streamed_.size());
+      streamed_.emplace_back(interaction->getName(), resolution_);
+    } else {
+      bonded_values_.CreateArray(interaction->getName());
+    }
   }
 }
 
 void BondedStatistics::EndCG() {}
 
 void BondedStatistics::EvalConfiguration(Topology *conf, Topology *) {
-  InteractionContainer &ic = conf->BondedInteractions();
-  InteractionContainer::iterator ia;
+  AddFrame(Evaluate(*conf));
+}
+
+std::vector<double> BondedStatistics::Evaluate(const Topology &conf) {
+  const InteractionContainer &ic = conf.BondedInteractions();
+  std::vector<double> values;
+  values.reserve(ic.size());
+  for (const auto &interaction : ic) {
+    values.push_back(interaction->EvaluateVar(conf));
+  }
+  return values;
+}
+
+void BondedStatistics::AddFrame(const std::vector<double> &values) {
+  if (streaming_) {
+    if (values.size() != streamed_.size()) {
+      throw std::runtime_error(
+          "BondedStatistics: number of bonded interactions changed");
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+      streamed_[i].Add(values[i]);
+    }
+    return;
+  }
+  if (values.size() != bonded_values_.Data().size()) {
+    throw std::runtime_error(
+        "BondedStatistics: number of bonded interactions changed");
+  }
+  DataCollection<double>::iterator is = bonded_values_.begin();
+  for (double value : values) {
+    (*is)->push_back(value);
+    ++is;
+  }
+}
 
-  DataCollection<double>::iterator is;
-  for (ia = ic.begin(), is = bonded_values_.begin(); ia != ic.end();
-       ++ia, ++is) {
-    (*is)->push_back((*ia)->EvaluateVar(*conf));
+void BondedStatistics::SelectStreamed(
+    const std::string &pattern,
+    std::vector<const StreamedValues *> &sel) const {
+  for (const auto &pair : streamed_by_name_) {
+    if (tools::wildcmp(pattern, pair.first)) {
+      sel.push_back(&streamed_[pair.second]);
+    }
   }
 }
 
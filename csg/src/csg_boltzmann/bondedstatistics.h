@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2019 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -19,10 +19,53 @@
 #define VOTCA_CSG_BONDEDSTATISTICS_H
 
 #include "../../include/votca/csg/cgobserver.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 #include <votca/tools/datacollection.h>
+#include <votca/tools/multitaucorrelator.h>
+#include <votca/tools/table.h>
 
 namespace votca {
 namespace csg {
+
+/**
+ * \brief histogram and autocorrelation of one interaction, accumulated frame
+ * by frame
+ *
+ * Values are binned with a fixed resolution and the autocorrelation is
+ * collected by a multiple-tau correlator, so the memory depends on the range
+ * of the values but not on the number of frames.
+ */
+class StreamedValues {
+ public:
+  StreamedValues(std::string name, double resolution)
+      : name_(std::move(name)), resolution_(resolution) {}
+
+  void Add(double value);
+
+  const std::string &getName() const { return name_; }
+  Index Samples() const { return autocorrelation_.Samples(); }
+
+  /// \brief append centers and counts of all occupied bins
+  void AppendHistogram(std::vector<double> &centers,
+                       std::vector<double> &counts) const;
+
+  /// \brief x: lag in frames, y: normalized autocorrelation
+  tools::Table Autocorrelation() const {
+    return autocorrelation_.getCorrelation();
+  }
+
+ private:
+  std::string name_;
+  double resolution_;
+  // bin index of counts_[0], bin i is centered at i*resolution_
+  Index offset_ = 0;
+  std::vector<double> counts_;
+  tools::MultiTauCorrelator autocorrelation_;
+};
+
 /**
  * \brief Class calculates data associated with bond interactions
  *
@@ -40,11 +83,35 @@ class BondedStatistics : public votca::csg::CGObserver {
   void EvalConfiguration(Topology *conf,
                          Topology *conf_atom = nullptr) override;
 
+  /// \brief evaluate all bonded interactions of conf, in the order of the
+  /// arrays in BondedValues()
+  static std::vector<double> Evaluate(const Topology &conf);
+  /// \brief append the values of one frame as returned by Evaluate()
+  void AddFrame(const std::vector<double> &values);
+
   tools::DataCollection<double> &BondedValues() { return bonded_values_; }
 
+  /// \brief accumulate StreamedValues instead of storing all values, must be
+  /// called before BeginCG
+  void setStreaming(double resolution) {
+    streaming_ = true;
+    resolution_ = resolution;
+  }
+  bool Streaming() const { return streaming_; }
+
+  /// \brief append the streamed interactions matching the wildcard pattern,
+  /// sorted by name like DataCollection::select
+  void SelectStreamed(const std::string &pattern,
+                      std::vector<const StreamedValues *> &sel) const;
+
  protected:
   tools::DataCollection<double> bonded_values_;
+
+  bool streaming_ = false;
+  double resolution_ = 0.0;
+  std::vector<StreamedValues> streamed_;
+  std::map<std::string, Index> streamed_by_name_;
 };
 }  // namespace csg
 }  // namespace votca
-#endif  // VOTCA_CSG_BOLZMANNINVERSION_H
+#endif  // VOTCA_CSG_BONDEDSTATISTICS_H
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -28,6 +28,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <votca/tools/getline.h>
 #include <votca/tools/rangeparser.h>
@@ -45,6 +46,10 @@ class CsgBoltzmann final : public CsgApplication {
   }
   bool DoTrajectory() { return !OptionsMap().count("excl"); }
   bool DoMapping() { return true; }
+  // frames are mapped and evaluated in parallel, synchronization keeps the
+  // time series in order, which cor and autocor rely on
+  bool DoThreaded() { return true; }
+  bool SynchronizeThreads() { return true; }
 
   void Initialize();
   bool EvaluateOptions();
@@ -53,17 +58,43 @@ class CsgBoltzmann final : public CsgApplication {
   void InteractiveMode();
   bool EvaluateTopology(Topology *top, Topology *top_ref);
 
+  std::unique_ptr<CsgApplication::Worker> ForkWorker();
+  void MergeWorker(Worker *worker);
+
  protected:
   ExclusionList CreateExclusionList(Topology *top_atomistic,
                                     Molecule &atomistic, Topology *top_cg,
                                     Molecule &cg);
   BondedStatistics bs_;
 };
+class BondedWorker : public CsgApplication::Worker {
+ public:
+  void EvalConfiguration(Topology *top, Topology *) override {
+    values_ = BondedStatistics::Evaluate(*top);
+  }
+  std::vector<double> values_;
+};
+
+std::unique_ptr<CsgApplication::Worker> CsgBoltzmann::ForkWorker() {
+  return std::make_unique<BondedWorker>();
+}
+
+void CsgBoltzmann::MergeWorker(Worker *worker) {
+  bs_.AddFrame(dynamic_cast<BondedWorker *>(worker)->values_);
+}
+
 void CsgBoltzmann::Initialize() {
   CsgApplication::Initialize();
   AddProgramOptions("Special options")(
       "excl", boost::program_options::value<string>(),
-      "write atomistic exclusion list to file");
+      "write atomistic exclusion list to file")(
+      "stream",
+      "accumulate histograms and autocorrelations frame by frame instead of "
+      "storing all values, vals and cor are not available")(
+      "resolution",
+      boost::program_options::value<double>()->default_value(0.001),
+      "bin width of the accumulated histograms (nm or rad), used with "
+      "--stream");
 
   AddObserver(&bs_);
 }
@@ -73,6 +104,13 @@ bool CsgBoltzmann::EvaluateOptions() {
   if (OptionsMap().count("excl")) {
     CheckRequired("cg", "excl options needs a mapping file");
   }
+  if (OptionsMap().count("stream")) {
+    double resolution = OptionsMap()["resolution"].as<double>();
+    if (resolution <= 0) {
+      throw std::runtime_error("resolution has to be positive");
+    }
+    bs_.setStreaming(resolution);
+  }
   return true;
 }
 
@@ -156,13 +194,13 @@ void CsgBoltzmann::InteractiveMode() {
       "help: show this help\n"
       "q: quit\n"
       "list: list all available bonds\n"
-      "vals <file> <selection>: write values to file\n"
+      "vals <file> <selection>: write values to file (not with --stream)\n"
       "hist <file> <selection>: create histogram\n"
       "tab <file> <selection>: create tabulated potential\n"
       "autocor <file> <selection>: calculate autocorrelation, only one row "
       "allowed in selection!\n"
       "cor <file> <selection>: calculate correlations, first row is correlated "
-      "with all other rows";
+      "with all other rows (not with --stream)";
 
   cout << help_text << endl;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2019 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -27,6 +27,22 @@
 namespace votca {
 namespace csg {
 
+namespace {
+// IntegratedCorrelationTime for the logarithmically spaced lags of a
+// multiple-tau correlator, every point stands for the lags since the previous
+double IntegratedCorrelationTime(const tools::Table &corr,
+                                 double window = 5.0) {
+  double tau = 0.5;
+  for (Index i = 1; i < corr.size(); i++) {
+    tau += corr.y(i) * (corr.x(i) - corr.x(i - 1));
+    if (corr.x(i) >= window * tau) {
+      break;
+    }
+  }
+  return tau;
+}
+}  // namespace
+
 void StdAnalysis::Register(std::map<std::string, AnalysisTool *> &lib) {
   lib["list"] = this;
   lib["vals"] = this;
@@ -36,6 +52,11 @@ void StdAnalysis::Register(std::map<std::string, AnalysisTool *> &lib) {
 
 void StdAnalysis::Command(BondedStatistics &bs, const std::string &cmd,
                           std::vector<std::string> &args) {
+  if (bs.Streaming() && (cmd == "vals" || cmd == "cor")) {
+    std::cout << "error, " << cmd
+              << " needs the stored values, run without --stream" << std::endl;
+    return;
+  }
   if (cmd == "vals") {
     WriteValues(bs, args);
   }
@@ -45,7 +66,14 @@ void StdAnalysis::Command(BondedStatistics &bs, const std::string &cmd,
   if (cmd == "autocor") {
     WriteAutocorrelation(bs, args);
   }
-  if (cmd == "list") {
+  if (cmd == "list" && bs.Streaming()) {
+    std::vector<const StreamedValues *> sel;
+    bs.SelectStreamed("*", sel);
+    std::cout << "Available bonded interactions:" << std::endl;
+    for (const StreamedValues *values : sel) {
+      std::cout << values->getName() << " " << std::endl;
+    }
+  } else if (cmd == "list") {
     votca::tools::DataCollection<double>::selection *sel =
         bs.BondedValues().select("*");
     std::cout << "Available bonded interactions:" << std::endl;
@@ -80,8 +108,9 @@ void StdAnalysis::Help(const std::string &cmd, std::vector<std::string> &) {
     std::cout
         << "autocor <file> <interaction>\n"
         << "calculate autocorrelation function of first item in selection. "
-           "The output is periodic since FFTW3 is used to "
-           "calcualte correlations.\n";
+           "The series is zero padded, so the output is not periodic, and "
+           "the integrated correlation time is printed. With --stream the "
+           "lags are spaced logarithmically.\n";
   }
   if (cmd == "list") {
     std::cout << "list\nlists all available interactions\n";
@@ -109,19 +138,47 @@ void StdAnalysis::WriteValues(BondedStatistics &bs,
 void StdAnalysis::WriteAutocorrelation(BondedStatistics &bs,
                                        std::vector<std::string> &args) {
   std::ofstream out;
+  if (bs.Streaming()) {
+    std::vector<const StreamedValues *> sel;
+    for (size_t i = 1; i < args.size(); i++) {
+      bs.SelectStreamed(args[i], sel);
+    }
+    if (sel.empty()) {
+      std::cout << "error, no interaction selected" << std::endl;
+      return;
+    }
+    tools::Table corr = sel[0]->Autocorrelation();
+    out.open(args[0]);
+    for (Index i = 0; i < corr.size(); i++) {
+      out << corr.x(i) << " " << corr.y(i) << "\n";
+    }
+    out.close();
+    std::cout << "calculated autocorrelation of " << sel[0]->getName()
+              << ", written to " << args[0]
+              << ", integrated correlation time "
+              << IntegratedCorrelationTime(corr) << " frames" << std::endl;
+    return;
+  }
   votca::tools::DataCollection<double>::selection *sel = nullptr;
 
   for (size_t i = 1; i < args.size(); i++) {
     sel = bs.BondedValues().select(args[i], sel);
   }
 
-  votca::tools::CrossCorrelate c;
-  c.AutoCorrelate(*sel);
+  votca::tools::DataCollection<double>::selection first;
+  first.push_back(&(*sel)[0]);
+  std::vector<double> corr =
+      votca::tools::CrossCorrelate::LinearAutoCorrelate(first)[0];
   out.open(args[0]);
-  out << c << std::endl;
+  for (size_t t = 0; t < corr.size(); t++) {
+    out << t << " " << corr[t] << "\n";
+  }
   out.close();
   std::cout << "calculated autocorrelation for " << sel->size()
-            << " data rows, written to " << args[0] << std::endl;
+            << " data rows, written to " << args[0]
+            << ", integrated correlation time "
+            << votca::tools::CrossCorrelate::IntegratedCorrelationTime(corr)
+            << " frames" << std::endl;
   delete sel;
 }
 
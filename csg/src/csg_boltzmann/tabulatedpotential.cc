@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -33,6 +33,36 @@ using namespace votca::tools;
 
 namespace votca {
 namespace csg {
+
+namespace {
+// fills h with the interactions selected by args[1], args[2], ... and returns
+// the number of data rows used
+size_t ProcessSelection(BondedStatistics &bs, const vector<string> &args,
+                        Histogram &h) {
+  if (bs.Streaming()) {
+    vector<const StreamedValues *> sel;
+    for (size_t i = 1; i < args.size(); i++) {
+      bs.SelectStreamed(args[i], sel);
+    }
+    vector<double> centers;
+    vector<double> counts;
+    for (const StreamedValues *values : sel) {
+      values->AppendHistogram(centers, counts);
+    }
+    h.ProcessWeighted(centers, counts);
+    return sel.size();
+  }
+  DataCollection<double>::selection *sel = nullptr;
+  for (size_t i = 1; i < args.size(); i++) {
+    sel = bs.BondedValues().select(args[i], sel);
+  }
+  h.ProcessData(sel);
+  size_t rows = sel->size();
+  delete sel;
+  return rows;
+}
+}  // namespace
+
 /******************************************************************************
  * Public Facing Methods
  ******************************************************************************/
@@ -197,36 +227,22 @@ pair<Index, Index> TabulatedPotential::getSmoothIterations() const {
 void TabulatedPotential::WriteHistogram(BondedStatistics &bs,
                                         vector<string> &args) {
   ofstream out;
-  DataCollection<double>::selection *sel = nullptr;
-
-  for (size_t i = 1; i < args.size(); i++) {
-    sel = bs.BondedValues().select(args[i], sel);
-  }
   Histogram h(hist_options_);
-  h.ProcessData(sel);
+  size_t rows = ProcessSelection(bs, args, h);
   out.open(args[0]);
   out << h;
   out.close();
-  cout << "histogram created using " << sel->size() << " data-rows, written to "
+  cout << "histogram created using " << rows << " data-rows, written to "
        << args[0] << endl;
-  delete sel;
 }
 
 void TabulatedPotential::WritePotential(BondedStatistics &bs,
                                         vector<string> &args) {
   ofstream out;
-  DataCollection<double>::selection *sel = nullptr;
-
-  // Appends all the interactions that are specified in args to selection
-  // pointer given by sel
-
-  for (size_t i = 1; i < args.size(); i++) {
-    sel = bs.BondedValues().select(args[i], sel);
-  }
-
   Histogram h(tab_options_);
 
-  h.ProcessData(sel);
+  // Collects all the interactions that are specified in args
+  size_t rows = ProcessSelection(bs, args, h);
   for (Index i = 0; i < tab_smooth1_; ++i) {
     Smooth_(h.getPdf(), tab_options_.periodic_);
   }
@@ -244,9 +260,8 @@ void TabulatedPotential::WritePotential(BondedStatistics &bs,
         << " " << F[i] << endl;
   }
   out.close();
-  cout << "histogram created using " << sel->size() << " data-rows, written to "
+  cout << "histogram created using " << rows << " data-rows, written to "
        << args[0] << endl;
-  delete sel;
 }
 
 /******************************************************************************
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,22 +16,20 @@
  */
 
 // Standard includes
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 
-// Third party includes
-#include <boost/program_options.hpp>
-#include <boost/tokenizer.hpp>
+// VOTCA includes
+#include <votca/tools/tokenizer.h>
 
 // Local VOTCA includes
-#include <votca/csg/topologyreader.h>
-#include <votca/csg/trajectoryreader.h>
-#include <votca/csg/version.h>
+#include <votca/csg/csgapplication.h>
 
 using namespace std;
-namespace po = boost::program_options;
 using namespace votca::csg;
-using namespace votca::tools;
+using votca::Index;
 
 /**
  *  *** Analyze particle distribution as a function of a coordinate ***
@@ -40,298 +38,225 @@ using namespace votca::tools;
  *  binned value of a chose coordinate, it outputs the time-averaged number of
  *  particles, listed by particle types.
  */
-void help_text(void) {
-  votca::csg::HelpTextHeader("csg_part_dist");
-  cout << "This program reads a topology and (set of) trajectory(ies). For "
-          "every\n"
-          "binned value of a chosen coordinate, it outputs the time-averaged "
-          "number of\n"
-          "particles, listed by particle types.\n\n";
-}
+class PartDistApp : public CsgApplication {
 
-void check_option(po::options_description &desc, po::variables_map &vm,
-                  const string &option) {
-  if (!vm.count(option)) {
-    cout << "csg_part_dist \n\n";
-    cout << desc << endl << "parameter " << option << " is not specified\n";
-    exit(1);
-  }
-}
+  string ProgramName() override { return "part_dist"; }
 
-int main(int argc, char **argv) {
-  string top_file, trj_file, ptypes_file, out_file, grid, comment,
-      coordinate = "z";
-  double min, max, step, coord;
-
-  votca::Index first_frame(0), last_frame(-1);
-
-  // Load topology+trajectory formats
-  TopologyReader::RegisterPlugins();
-  TrajectoryReader::RegisterPlugins();
+  void HelpText(ostream &out) override {
+    out << "This program reads a topology and (set of) trajectory(ies). For "
+           "every\n"
+           "binned value of a chosen coordinate, it outputs the time-averaged "
+           "number of\n"
+           "particles, listed by particle types.";
+  }
 
-  // read program options
-  namespace po = boost::program_options;
+  void Initialize() override;
+  bool EvaluateOptions() override;
+
+  bool DoTrajectory() override { return true; }
+  // do a threaded analyzis, splitting in time domain
+  bool DoThreaded() override { return true; }
+  // the histograms are just summed up, the order of the frames does not matter
+  bool SynchronizeThreads() override { return false; }
+
+  // looks up the particle type of every bead once
+  bool EvaluateTopology(Topology *top, Topology *top_ref) override;
+  // writes the table after all frames were parsed
+  void EndEvaluate() override;
+
+  std::unique_ptr<CsgApplication::Worker> ForkWorker(void) override;
+  void MergeWorker(Worker *worker) override;
+
+ public:
+  using Occupancy = Eigen::Matrix<Index, Eigen::Dynamic, Eigen::Dynamic>;
+
+  double min_;
+  double max_;
+  double step_;
+  Index n_bins_;
+  // dimension of the analyzed coordinate, 0,1,2 for x,y,z
+  Index dim_;
+  bool shift_com_;
+
+  // particle types in the order of the output columns
+  std::vector<Index> ptypes_;
+  // id and column in ptypes_ of every bead included in the analysis
+  std::vector<std::pair<Index, Index> > selected_;
+
+  Occupancy p_occ_;
+  Index analyzed_frames_ = 0;
+};
+
+// Each thread has a worker with its own histogram
+class PartDistWorker : public CsgApplication::Worker {
+ public:
+  void EvalConfiguration(Topology *top, Topology *top_ref) override;
+
+  const PartDistApp *app_data_;
+  PartDistApp::Occupancy p_occ_;
+  Index analyzed_frames_ = 0;
+};
 
-  // Declare the supported options.
-  po::options_description desc("Allowed options");
+int main(int argc, char **argv) {
+  PartDistApp app;
+  return app.Exec(argc, argv);
+}
 
-  // let cg_engine add some program options
-  desc.add_options()("top", po::value<string>(&top_file), "topology file")(
-      "trj", po::value<string>(&trj_file), "trajectory file")(
-      "grid", po::value<string>(&grid), "output grid spacing (min:step:max)")(
-      "out", po::value<string>(&out_file),
+void PartDistApp::Initialize() {
+  CsgApplication::Initialize();
+  AddProgramOptions("Distribution options")(
+      "grid", boost::program_options::value<string>(),
+      "output grid spacing (min:step:max)")(
+      "out", boost::program_options::value<string>(),
       "output particle distribution table")(
-      "ptypes", po::value<string>(&ptypes_file),
+      "ptypes", boost::program_options::value<string>(),
       "particle types to include in the analysis\n"
       " arg: file - particle types separated by space"
-      "\n default: all particle types")("first_frame",
-                                        po::value<votca::Index>(&first_frame),
-                                        "first frame considered for analysis")(
-      "last_frame", po::value<votca::Index>(&last_frame),
-      "last frame considered for analysis")(
-      "coord", po::value<string>(&coordinate),
+      "\n default: all particle types")(
+      "coord", boost::program_options::value<string>()->default_value("z"),
       "coordinate analyzed ('x', 'y', or 'z' (default))")(
       "shift_com", "shift center of mass to zero")(
-      "comment", po::value<string>(&comment),
-      "store a comment in the output table")("help",
-                                             "produce this help message");
-
-  // now read in the command line
-  po::variables_map vm;
-  try {
-    po::store(po::parse_command_line(argc, argv, desc), vm);
-    po::notify(vm);
-  } catch (po::error &err) {
-    cout << "error parsing command line: " << err.what() << endl;
-    return -1;
-  }
-
-  // does the user want help?
-  if (vm.count("help")) {
-    help_text();
-    cout << desc << endl;
-    return 0;
-  }
-
-  check_option(desc, vm, "top");
-  check_option(desc, vm, "trj");
-  check_option(desc, vm, "out");
-  check_option(desc, vm, "grid");
+      "comment", boost::program_options::value<string>(),
+      "store a comment in the output table");
+}
 
-  if (coordinate.compare("x") != 0 && coordinate.compare("y") != 0 &&
-      coordinate.compare("z") != 0) {
-    cout << "Bad format for coordinate: " << coordinate << endl;
-    return 1;
+bool PartDistApp::EvaluateOptions() {
+  CsgApplication::EvaluateOptions();
+  CheckRequired("trj", "no trajectory file specified");
+  CheckRequired("out", "no output file specified");
+  CheckRequired("grid", "no grid specified");
+
+  string coordinate = OptionsMap()["coord"].as<string>();
+  if (coordinate == "x") {
+    dim_ = 0;
+  } else if (coordinate == "y") {
+    dim_ = 1;
+  } else if (coordinate == "z") {
+    dim_ = 2;
+  } else {
+    throw std::runtime_error("Bad format for coordinate: " + coordinate);
   }
+  shift_com_ = OptionsMap().count("shift_com") > 0;
 
-  // Parse grid
-  vector<string> toks = Tokenizer(grid, ":").ToVector();
+  vector<string> toks =
+      votca::tools::Tokenizer(OptionsMap()["grid"].as<string>(), ":")
+          .ToVector();
   if (toks.size() != 3) {
-    cout << "Wrong range format, use min:step:max\n";
-    return 1;
+    throw std::runtime_error("Wrong range format, use min:step:max");
   }
-  min = std::stod(toks[0]);
-  step = std::stod(toks[1]);
-  max = std::stod(toks[2]);
-  // Calculate number of bins
-  votca::Index n_bins = (votca::Index)((max - min) / (1. * step) + 1);
-  vector<votca::Index> ptypes;
-  Topology top;
-  Eigen::MatrixXi p_occ;
-  votca::Index analyzed_frames(0);
-  try {
-
-    // Load topology
-    std::unique_ptr<TopologyReader> reader = std::unique_ptr<TopologyReader>(
-        TopReaderFactory().Create(vm["top"].as<string>()));
-    if (reader == nullptr) {
-      throw std::runtime_error("input format not supported: " +
-                               vm["top"].as<string>());
-    }
-
-    reader->ReadTopology(vm["top"].as<string>(), top);
+  min_ = std::stod(toks[0]);
+  step_ = std::stod(toks[1]);
+  max_ = std::stod(toks[2]);
+  n_bins_ = (Index)((max_ - min_) / step_ + 1);
+  return true;
+}
 
-    // Read the particle types file and save to variable ptypes
-    if (vm.count("ptypes")) {
-      ifstream fl_ptypes;
-      fl_ptypes.open(vm["ptypes"].as<string>());
-      if (!fl_ptypes.is_open()) {
-        throw std::runtime_error("can't open " + vm["ptypes"].as<string>());
-      }
-      // build the list of particle types
-      if (fl_ptypes.eof()) {
-        throw std::runtime_error("file " + vm["ptypes"].as<string>() +
-                                 " is empty");
-      }
-      while (!fl_ptypes.eof()) {
-        // Not very elegant, but makes sure we don't count the same element
-        // twice
-        std::string string_tmp = "__";
-        fl_ptypes >> string_tmp;
-        if (string_tmp != "" && string_tmp != "__") {
-          ptypes.push_back(std::stol(string_tmp));
-        }
-      }
-      fl_ptypes.close();
-
-    } else {
-      // Include all particle types
-      for (const auto &mol : top.Molecules()) {
-        for (votca::Index i = 0; i < mol.BeadCount(); ++i) {
-          bool flag_found = false;
-          votca::Index part_type = std::stol(mol.getBead(i)->getType());
-          for (votca::Index ptype : ptypes) {
-            if (part_type == ptype) {
-              flag_found = true;
-            }
-          }
-          if (!flag_found) {
-            ptypes.push_back(part_type);
-          }
-        }
-      }
+bool PartDistApp::EvaluateTopology(Topology *top, Topology *) {
+  ptypes_.clear();
+  if (OptionsMap().count("ptypes")) {
+    string ptypes_file = OptionsMap()["ptypes"].as<string>();
+    ifstream fl_ptypes;
+    fl_ptypes.open(ptypes_file);
+    if (!fl_ptypes.is_open()) {
+      throw std::runtime_error("can't open " + ptypes_file);
     }
-
-    p_occ = Eigen::MatrixXi::Zero(ptypes.size(), ptypes.size());
-
-    // If we need to shift the center of mass, calculate the number of
-    // particles (only the ones that belong to the particle type index
-    // ptypes)
-    votca::Index n_part = 0;
-    if (vm.count("shift_com")) {
-      for (const auto &mol : top.Molecules()) {
-        for (votca::Index i = 0; i < mol.BeadCount(); ++i) {
-          votca::Index part_type = std::stol(mol.getBead(i)->getType());
-          for (votca::Index ptype : ptypes) {
-            if (part_type == ptype) {
-              ++n_part;
-            }
-          }
+    string type;
+    while (fl_ptypes >> type) {
+      ptypes_.push_back(std::stol(type));
+    }
+    if (ptypes_.empty()) {
+      throw std::runtime_error("file " + ptypes_file + " is empty");
+    }
+  }
+  bool all_types = ptypes_.empty();
+
+  // the type string is only converted once per bead, not in every frame
+  selected_.clear();
+  for (const auto &mol : top->Molecules()) {
+    for (Index i = 0; i < mol.BeadCount(); ++i) {
+      const Bead *bead = mol.getBead(i);
+      Index part_type = std::stol(bead->getType());
+      auto slot = std::find(ptypes_.begin(), ptypes_.end(), part_type);
+      if (slot == ptypes_.end()) {
+        if (!all_types) {
+          continue;
         }
+        slot = ptypes_.insert(ptypes_.end(), part_type);
       }
+      selected_.push_back({bead->getId(), Index(slot - ptypes_.begin())});
     }
+  }
 
-    // Now load trajectory
-    std::unique_ptr<TrajectoryReader> trajreader =
-        std::unique_ptr<TrajectoryReader>(
-            TrjReaderFactory().Create(vm["trj"].as<string>()));
-    if (trajreader == nullptr) {
-      throw std::runtime_error("input format not supported: " +
-                               vm["trj"].as<string>());
-    }
-    trajreader->Open(vm["trj"].as<string>());
-
-    // Read the trajectory. Analyze each frame to obtain
-    // particle occupancy as a function of coordinate z.
-    bool moreframes = true;
-    bool not_the_last = true;
-    while (moreframes) {
-      // Read frame
-      votca::Index frame_id = 0;
-      if (frame_id == 0) {
-        moreframes = trajreader->FirstFrame(top);
-      } else {
-        moreframes = trajreader->NextFrame(top);
-      }
+  p_occ_ = Occupancy::Zero(ptypes_.size(), n_bins_);
+  analyzed_frames_ = 0;
+  return true;
+}
 
-      // Was this the last frame we read?
-      if (last_frame == -1) {
-        not_the_last = 1;
-      } else {
-        if (frame_id <= last_frame) {
-          not_the_last = 1;
-        } else {
-          not_the_last = 0;
-        }
-      }
+std::unique_ptr<CsgApplication::Worker> PartDistApp::ForkWorker() {
+  auto worker = std::make_unique<PartDistWorker>();
+  worker->app_data_ = this;
+  return worker;
+}
 
-      // Calculate new center of mass position in the direction of 'coordinate'
-      double com = 0.;
-      if (vm.count("shift_com")) {
-        for (const auto &mol : top.Molecules()) {
-          for (votca::Index i = 0; i < mol.BeadCount(); ++i) {
-            votca::Index part_type = std::stol(mol.getBead(i)->getType());
-            for (votca::Index ptype : ptypes) {
-              if (part_type == ptype) {
-                if (coordinate.compare("x") == 0) {
-                  com += mol.getBead(i)->getPos().x();
-                } else if (coordinate.compare("y") == 0) {
-                  com += mol.getBead(i)->getPos().y();
-                } else {
-                  com += mol.getBead(i)->getPos().z();
-                }
-              }
-            }
-          }
-        }
-        com /= (double)n_part;
-      }
+void PartDistWorker::EvalConfiguration(Topology *top, Topology *) {
+  const PartDistApp &app = *app_data_;
+  if (p_occ_.size() == 0) {
+    p_occ_ = PartDistApp::Occupancy::Zero(app.ptypes_.size(), app.n_bins_);
+  }
 
-      // Analyze frame
-      if (moreframes && frame_id >= first_frame && not_the_last) {
-        ++analyzed_frames;
-        // Loop over each atom property
-        for (const auto &mol : top.Molecules()) {
-          for (votca::Index i = 0; i < mol.BeadCount(); ++i) {
-            votca::Index part_type = std::stol(mol.getBead(i)->getType());
-            for (votca::Index j = 0; j < votca::Index(ptypes.size()); ++j) {
-              if (part_type == ptypes[j]) {
-                if (coordinate.compare("x") == 0) {
-                  coord = mol.getBead(i)->getPos().x();
-                } else if (coordinate.compare("y") == 0) {
-                  coord = mol.getBead(i)->getPos().y();
-                } else {
-                  coord = mol.getBead(i)->getPos().z();
-                }
-
-                if (coord - com > min && coord - com < max) {
-                  p_occ(j,
-                        (votca::Index)std::floor((coord - com - min) / step))++;
-                }
-              }
-            }
-          }
-        }
-      }
-      ++frame_id;
+  // center of mass position in the direction of the coordinate
+  double com = 0.;
+  if (app.shift_com_ && !app.selected_.empty()) {
+    for (const auto &bead : app.selected_) {
+      com += top->getBead(bead.first)->getPos()[app.dim_];
     }
+    com /= (double)app.selected_.size();
+  }
 
-    trajreader->Close();
+  for (const auto &bead : app.selected_) {
+    double coord = top->getBead(bead.first)->getPos()[app.dim_] - com;
+    if (coord > app.min_ && coord < app.max_) {
+      p_occ_(bead.second, (Index)std::floor((coord - app.min_) / app.step_))++;
+    }
+  }
+  analyzed_frames_++;
+}
 
-  } catch (std::exception &error) {
-    cerr << "An error occured!" << endl << error.what() << endl;
+void PartDistApp::MergeWorker(Worker *worker) {
+  PartDistWorker *myWorker = dynamic_cast<PartDistWorker *>(worker);
+  if (myWorker->p_occ_.size() > 0) {
+    p_occ_ += myWorker->p_occ_;
   }
+  analyzed_frames_ += myWorker->analyzed_frames_;
+}
 
-  // Output particle occupancy
-  try {
-    ofstream fl_out;
-    fl_out.open(vm["out"].as<string>());
-    if (!fl_out.is_open()) {
-      throw std::runtime_error("can't open " + vm["out"].as<string>());
-    }
+void PartDistApp::EndEvaluate() {
+  string out_file = OptionsMap()["out"].as<string>();
+  ofstream fl_out;
+  fl_out.open(out_file);
+  if (!fl_out.is_open()) {
+    throw std::runtime_error("can't open " + out_file);
+  }
 
-    fl_out << "#z\t" << flush;
-    for (votca::Index ptype : ptypes) {
-      fl_out << "type " << ptype << "\t" << flush;
-    }
-    fl_out << endl;
-    for (votca::Index k = 0; k < n_bins; ++k) {
-      fl_out << min + (double)k * step << "\t" << flush;
-      for (votca::Index j = 0; j < votca::Index(ptypes.size()); ++j) {
-        if (p_occ(j, k) == 0) {
-          fl_out << 0 << "\t" << flush;
-        } else {
-          fl_out << p_occ(j, k) / (1. * (double)analyzed_frames) << "\t"
-                 << flush;
-        }
+  if (OptionsMap().count("comment")) {
+    fl_out << "# " << OptionsMap()["comment"].as<string>() << "\n";
+  }
+  fl_out << "#z\t";
+  for (Index ptype : ptypes_) {
+    fl_out << "type " << ptype << "\t";
+  }
+  fl_out << "\n";
+  for (Index k = 0; k < n_bins_; ++k) {
+    fl_out << min_ + (double)k * step_ << "\t";
+    for (Index j = 0; j < Index(ptypes_.size()); ++j) {
+      if (p_occ_(j, k) == 0) {
+        fl_out << 0 << "\t";
+      } else {
+        fl_out << (double)p_occ_(j, k) / (double)analyzed_frames_ << "\t";
       }
-      fl_out << endl;
     }
-    fl_out.close();
-  } catch (std::exception &error) {
-    cerr << "An error occured!" << endl << error.what() << endl;
+    fl_out << "\n";
   }
-  cout << "The table was written to " << vm["out"].as<string>() << endl;
-
-  return 0;
+  fl_out.close();
+  cout << "The table was written to " << out_file << endl;
 }
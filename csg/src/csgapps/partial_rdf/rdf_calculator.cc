@@ -134,6 +134,8 @@ RDFCalculator::interaction_t *RDFCalculator::AddInteraction(Property *p) {
   i->max_ = p->get("max").as<double>();
   i->norm_ = 1.0;
   i->p_ = p;
+  i->type1_ = p->get("type1").value();
+  i->type2_ = p->get("type2").value();
 
   // initialize the current and average histogram
   Index n = (Index)((i->max_ - i->min_) / i->step_ + 1.000000001);
@@ -164,6 +166,17 @@ void RDFCalculator::LoadOptions(const std::string &file) {
   options_.LoadFromXML(file);
   bonded_ = options_.Select("cg.bonded");
   nonbonded_ = options_.Select("cg.non-bonded");
+
+  gridsearch_ = true;
+  if (options_.exists("cg.nbsearch")) {
+    if (options_.get("cg.nbsearch").as<std::string>() == "grid") {
+      gridsearch_ = true;
+    } else if (options_.get("cg.nbsearch").as<std::string>() == "simple") {
+      gridsearch_ = false;
+    } else {
+      throw std::runtime_error("cg.nbsearch invalid, can be grid or simple");
+    }
+  }
 }
 
 // evaluate current conformation
@@ -229,46 +242,31 @@ class IMCNBSearchHandler {
 
 // process non-bonded interactions for current frame
 void RDFCalculator::Worker::DoNonbonded(Topology *top) {
-  for (Property *prop : rdfcalculator_->nonbonded_) {
-    std::string name = prop->get("name").value();
-
-    interaction_t &i = *rdfcalculator_->interactions_[name];
+  for (auto &interaction_ : rdfcalculator_->interactions_) {
+    interaction_t &i = *interaction_.second;
 
     // generate the bead lists
     BeadList beads1, beads2;
 
-    beads1.GenerateInSphericalSubvolume(*top, prop->get("type1").value(),
-                                        rdfcalculator_->boxc_,
-                                        rdfcalculator_->subvol_rad_);
-    beads2.GenerateInSphericalSubvolume(*top, prop->get("type2").value(),
-                                        rdfcalculator_->boxc_,
-                                        rdfcalculator_->subvol_rad_);
+    beads1.GenerateInSphericalSubvolume(
+        *top, selections_[i.index_].first, rdfcalculator_->boxc_,
+        rdfcalculator_->subvol_rad_);
+    beads2.GenerateInSphericalSubvolume(
+        *top, selections_[i.index_].second, rdfcalculator_->boxc_,
+        rdfcalculator_->subvol_rad_);
 
     cur_beadlist_1_count_ = (double)beads1.size();
     cur_beadlist_2_count_ = (double)beads2.size();
 
     // same types, so put factor 1/2 because of already counted interactions
-    if (prop->get("type1").value() == prop->get("type2").value()) {
+    if (i.type1_ == i.type2_) {
       cur_beadlist_2_count_ /= 2.0;
     }
 
     // generate the neighbour list
     std::unique_ptr<NBList> nb;
 
-    bool gridsearch = true;
-
-    if (rdfcalculator_->options_.exists("cg.nbsearch")) {
-      if (rdfcalculator_->options_.get("cg.nbsearch").as<std::string>() ==
-          "grid") {
-        gridsearch = true;
-      } else if (rdfcalculator_->options_.get("cg.nbsearch")
-                     .as<std::string>() == "simple") {
-        gridsearch = false;
-      } else {
-        throw std::runtime_error("cg.nbsearch invalid, can be grid or simple");
-      }
-    }
-    if (gridsearch) {
+    if (rdfcalculator_->gridsearch_) {
       nb = std::make_unique<NBListGrid>();
     } else {
       nb = std::make_unique<NBList>();
@@ -285,7 +283,7 @@ void RDFCalculator::Worker::DoNonbonded(Topology *top) {
     nb->SetMatchFunction(&h, &IMCNBSearchHandler::FoundPair);
 
     // is it same types or different types?
-    if (prop->get("type1").value() == prop->get("type2").value()) {
+    if (i.type1_ == i.type2_) {
       nb->Generate(beads1);
     } else {
       nb->Generate(beads1, beads2);
@@ -363,10 +361,13 @@ std::unique_ptr<CsgApplication::Worker> RDFCalculator::ForkWorker() {
   auto worker = std::make_unique<RDFCalculator::Worker>();
 
   worker->current_hists_.resize(interactions_.size());
+  worker->selections_.resize(interactions_.size());
   worker->rdfcalculator_ = this;
 
   for (auto &interaction_ : interactions_) {
     interaction_t *i = interaction_.second.get();
+    worker->selections_[i->index_] = {BeadSelection(i->type1_),
+                                      BeadSelection(i->type2_)};
     worker->current_hists_[i->index_].Initialize(
         i->average_.getMin(), i->average_.getMax(), i->average_.getNBins());
   }
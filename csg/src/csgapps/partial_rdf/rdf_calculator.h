@@ -36,6 +36,7 @@
 #include <votca/tools/property.h>
 
 // Local VOTCA includes
+#include <votca/csg/beadselection.h>
 #include <votca/csg/csgapplication.h>
 
 namespace votca {
@@ -89,6 +90,7 @@ class RDFCalculator {
   struct interaction_t {
     Index index_;
     Property *p_;
+    std::string type1_, type2_;
     HistogramNew average_;
     double min_, max_, step_;
     double norm_;
@@ -127,6 +129,8 @@ class RDFCalculator {
   double subvol_rad_;
   Eigen::Vector3d boxc_;  // center of box
   bool do_vol_corr_;
+  // use the grid search for neighbors (cg.nbsearch)
+  bool gridsearch_ = true;
 
   /// list of bonded interactions
   std::vector<Property *> bonded_;
@@ -151,6 +155,8 @@ class RDFCalculator {
   class Worker : public CsgApplication::Worker {
    public:
     std::vector<HistogramNew> current_hists_;
+    // compiled selections type1 and type2 for each interaction
+    std::vector<std::pair<BeadSelection, BeadSelection>> selections_;
     RDFCalculator *rdfcalculator_;
     double cur_vol_;
     double cur_beadlist_1_count_;  // need to normalize to avg density for
@@ -15,9 +15,6 @@
  *
  */
 
-// VOTCA includes
-#include <votca/tools/tokenizer.h>
-
 // Local VOTCA includes
 #include "votca/csg/beadlist.h"
 #include "votca/csg/topology.h"
@@ -28,28 +25,14 @@ namespace csg {
 using namespace std;
 
 Index BeadList::Generate(Topology &top, const string &select) {
-  topology_ = &top;
-  bool selectByName = false;
-  string pSelect;  // parsed selection string
-
-  if (select.substr(0, 5) == "name:") {
-    // select according to bead name instead of type
-    pSelect = select.substr(5);
-    selectByName = true;
-  } else {
-    pSelect = select;
-  }
+  BeadSelection selection(select);
+  return Generate(top, selection);
+}
 
-  for (auto &bead : top.Beads()) {
-    if (!selectByName) {
-      if (tools::wildcmp(pSelect, bead.getType())) {
-        beads_.push_back(&bead);
-      }
-    } else {
-      if (tools::wildcmp(pSelect, bead.getName())) {
-        beads_.push_back(&bead);
-      }
-    }
+Index BeadList::Generate(Topology &top, BeadSelection &select) {
+  topology_ = &top;
+  for (Index id : select.Select(top)) {
+    beads_.push_back(top.getBead(id));
   }
   return size();
 }
@@ -58,31 +41,21 @@ Index BeadList::GenerateInSphericalSubvolume(Topology &top,
                                              const string &select,
                                              Eigen::Vector3d ref,
                                              double radius) {
-  topology_ = &top;
-  bool selectByName = false;
-  string pSelect;  // parsed selection string
-
-  if (select.substr(0, 5) == "name:") {
-    // select according to bead name instead of type
-    pSelect = select.substr(5);
-    selectByName = true;
-  } else {
-    pSelect = select;
-  }
+  BeadSelection selection(select);
+  return GenerateInSphericalSubvolume(top, selection, ref, radius);
+}
 
-  for (auto &bead : top.Beads()) {
-    if (topology_->BCShortestConnection(ref, bead.getPos()).norm() > radius) {
+Index BeadList::GenerateInSphericalSubvolume(Topology &top,
+                                             BeadSelection &select,
+                                             Eigen::Vector3d ref,
+                                             double radius) {
+  topology_ = &top;
+  for (Index id : select.Select(top)) {
+    Bead *bead = top.getBead(id);
+    if (topology_->BCShortestConnection(ref, bead->getPos()).norm() > radius) {
       continue;
     }
-    if (!selectByName) {
-      if (tools::wildcmp(pSelect, bead.getType())) {
-        beads_.push_back(&bead);
-      }
-    } else {
-      if (tools::wildcmp(pSelect, bead.getName())) {
-        beads_.push_back(&bead);
-      }
-    }
+    beads_.push_back(bead);
   }
   return size();
 }
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <unordered_map>
+
+// VOTCA includes
+#include <votca/tools/tokenizer.h>
+
+// Local VOTCA includes
+#include "votca/csg/beadselection.h"
+#include "votca/csg/topology.h"
+
+namespace votca {
+namespace csg {
+
+BeadSelection::BeadSelection(const std::string &select,
+                             const std::string &molname)
+    : select_(select), molname_(molname) {
+  if (select_.substr(0, 5) == "name:") {
+    // select according to bead name instead of type
+    pattern_ = select_.substr(5);
+    by_name_ = true;
+  } else {
+    pattern_ = select_;
+  }
+}
+
+const std::vector<Index> &BeadSelection::Select(const Topology &top) {
+  if (revision_ != top.getRevision()) {
+    Compile(top);
+  }
+  return ids_;
+}
+
+void BeadSelection::Compile(const Topology &top) {
+  ids_.clear();
+  // a topology only has a handful of distinct types or names, so the
+  // wildcard is evaluated only once for each of them
+  std::unordered_map<std::string, bool> matches;
+  auto match = [&](const Bead &bead) {
+    std::string key = by_name_ ? bead.getName() : bead.getType();
+    auto it = matches.find(key);
+    if (it == matches.end()) {
+      it = matches.emplace(key, tools::wildcmp(pattern_, key) != 0)
+               .first;
+    }
+    return it->second;
+  };
+
+  if (molname_.empty()) {
+    for (Index i = 0; i < top.BeadCount(); i++) {
+      const Bead &bead = *top.getBead(i);
+      if (match(bead)) {
+        ids_.push_back(bead.getId());
+      }
+    }
+  } else {
+    for (const auto &mol : top.Molecules()) {
+      if (!tools::wildcmp(molname_, mol.getName())) {
+        continue;
+      }
+      for (Index i = 0; i < mol.BeadCount(); i++) {
+        const Bead &bead = *mol.getBead(i);
+        if (match(bead)) {
+          ids_.push_back(bead.getId());
+        }
+      }
+    }
+  }
+  revision_ = top.getRevision();
+}
+
+}  // namespace csg
+}  // namespace votca
@@ -35,6 +35,9 @@ using namespace std;
 
 bool XMLTopologyReader::ReadTopology(string filename, Topology &top) {
   top_ = &top;
+  // the reader is reused for the topologies of all threads, molecules of a
+  // previous read would duplicate the bonded interactions
+  ClearMolecules();
 
   tools::Property options;
   options.LoadFromXML(filename);
@@ -396,7 +399,9 @@ void XMLTopologyReader::ParseDihedral(tools::Property &p) {
   }
 }
 
-XMLTopologyReader::~XMLTopologyReader() {
+XMLTopologyReader::~XMLTopologyReader() { ClearMolecules(); }
+
+void XMLTopologyReader::ClearMolecules() {
   // Clean  molecules_ map
   for (auto &molecule_ : molecules_) {
     XMLMolecule *xmlMolecule = molecule_.second;
@@ -406,6 +411,7 @@ XMLTopologyReader::~XMLTopologyReader() {
     xmlMolecule->beads.clear();
     delete xmlMolecule;
   }
+  molecules_.clear();
 }
 
 }  // namespace csg
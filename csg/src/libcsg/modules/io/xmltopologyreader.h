@@ -103,6 +103,7 @@ class XMLTopologyReader : public TopologyReader {
   void ParseBond(tools::Property &p);
   void ParseAngle(tools::Property &p);
   void ParseDihedral(tools::Property &p);
+  void ClearMolecules();
 
  private:
   Topology *top_;
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -19,6 +19,7 @@
 #include <iostream>
 
 // Local VOTCA includes
+#include "votca/csg/boundaryconditiondispatch.h"
 #include "votca/csg/nblist.h"
 #include "votca/csg/topology.h"
 
@@ -49,41 +50,44 @@ void NBList::Generate(BeadList &list1, BeadList &list2, bool do_exclusions) {
   assert(&(list1.getTopology()) == &(list2.getTopology()));
   const Topology &top = list1.getTopology();
 
-  for (iter1 = list1.begin(); iter1 != list1.end(); ++iter1) {
-    if (&list1 == &list2) {
-      iter2 = iter1;
-      ++iter2;
-    } else {
-      iter2 = list2.begin();
-    }
+  // the minimum image convention is resolved once for the whole search
+  DispatchBoundaryCondition(top.getBoundary(), [&](const auto &bc) {
+    for (iter1 = list1.begin(); iter1 != list1.end(); ++iter1) {
+      if (&list1 == &list2) {
+        iter2 = iter1;
+        ++iter2;
+      } else {
+        iter2 = list2.begin();
+      }
 
-    if (iter2 == list2.end()) {
-      continue;
-    }
-    if (*iter1 == *iter2) {
-      continue;
-    }
+      if (iter2 == list2.end()) {
+        continue;
+      }
+      if (*iter1 == *iter2) {
+        continue;
+      }
 
-    for (; iter2 != list2.end(); ++iter2) {
-      Eigen::Vector3d u = (*iter1)->getPos();
-      Eigen::Vector3d v = (*iter2)->getPos();
+      for (; iter2 != list2.end(); ++iter2) {
+        Eigen::Vector3d u = (*iter1)->getPos();
+        Eigen::Vector3d v = (*iter2)->getPos();
 
-      Eigen::Vector3d r = top.BCShortestConnection(u, v);
-      double d = r.norm();
-      if (d < cutoff_) {
-        if (do_exclusions_) {
-          if (top.getExclusions().IsExcluded(*iter1, *iter2)) {
-            continue;
+        Eigen::Vector3d r = bc.BCShortestConnection(u, v);
+        double d = r.norm();
+        if (d < cutoff_) {
+          if (do_exclusions_) {
+            if (top.getExclusions().IsExcluded(*iter1, *iter2)) {
+              continue;
+            }
           }
-        }
-        if ((*match_function_)(*iter1, *iter2, r, d)) {
-          if (!FindPair(*iter1, *iter2)) {
-            AddPair(pair_creator_(*iter1, *iter2, r));
+          if ((*match_function_)(*iter1, *iter2, r, d)) {
+            if (!FindPair(*iter1, *iter2)) {
+              AddPair(pair_creator_(*iter1, *iter2, r));
+            }
           }
         }
       }
     }
-  }
+  });
 }
 
 }  // namespace csg
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
  */
 
 // Local VOTCA includes
+#include "votca/csg/boundaryconditiondispatch.h"
 #include "votca/csg/nblistgrid.h"
 #include "votca/csg/topology.h"
 #include "votca/tools/NDimVector.h"
@@ -46,10 +47,12 @@ void NBListGrid::Generate(BeadList &list1, BeadList &list2,
     getCell(iter->getPos()).beads_.push_back(iter);
   }
 
-  for (auto &iter : list2) {
-    cell_t &cell = getCell(iter->getPos());
-    TestBead(top, cell, iter);
-  }
+  DispatchBoundaryCondition(top.getBoundary(), [&](const auto &bc) {
+    for (auto &iter : list2) {
+      cell_t &cell = getCell(iter->getPos());
+      TestBead(top, bc, cell, iter);
+    }
+  });
 }
 
 void NBListGrid::Generate(BeadList &list, bool do_exclusions) {
@@ -62,11 +65,13 @@ void NBListGrid::Generate(BeadList &list, bool do_exclusions) {
 
   InitializeGrid(top.getBox());
 
-  for (auto &iter : list) {
-    cell_t &cell = getCell(iter->getPos());
-    TestBead(top, cell, iter);
-    getCell(iter->getPos()).beads_.push_back(iter);
-  }
+  DispatchBoundaryCondition(top.getBoundary(), [&](const auto &bc) {
+    for (auto &iter : list) {
+      cell_t &cell = getCell(iter->getPos());
+      TestBead(top, bc, cell, iter);
+      cell.beads_.push_back(iter);
+    }
+  });
 }
 void NBListGrid::InitializeGrid(const Eigen::Matrix3d &box) {
   box_a_ = box.col(0);
@@ -168,22 +173,24 @@ NBListGrid::cell_t &NBListGrid::getCell(const Eigen::Vector3d &r) {
   return grid_(a, b, c);
 }
 
-void NBListGrid::TestBead(const Topology &top, NBListGrid::cell_t &cell,
-                          Bead *bead) {
-  TestCell(top, cell, bead);
+template <typename BC>
+void NBListGrid::TestBead(const Topology &top, const BC &bc,
+                          NBListGrid::cell_t &cell, Bead *bead) {
+  TestCell(top, bc, cell, bead);
   for (auto &neighbour : cell.neighbours_) {
-    TestCell(top, *neighbour, bead);
+    TestCell(top, bc, *neighbour, bead);
   }
 }
 
-void NBListGrid::TestCell(const Topology &top, NBListGrid::cell_t &cell,
-                          Bead *bead) {
+template <typename BC>
+void NBListGrid::TestCell(const Topology &top, const BC &bc,
+                          NBListGrid::cell_t &cell, Bead *bead) {
   const Eigen::Vector3d &u = bead->getPos();
 
   for (auto &bead_ : cell.beads_) {
 
     const Eigen::Vector3d &v = bead_->getPos();
-    const Eigen::Vector3d &r = top.BCShortestConnection(v, u);
+    const Eigen::Vector3d r = bc.BCShortestConnection(v, u);
     double d = r.norm();
     if (d < cutoff_) {
       if (do_exclusions_) {
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
  */
 
 // Local VOTCA includes
+#include "votca/csg/boundaryconditiondispatch.h"
 #include "votca/csg/nblistgrid_3body.h"
 #include "votca/csg/topology.h"
 
@@ -62,10 +63,12 @@ void NBListGrid_3Body::Generate(BeadList &list1, BeadList &list2,
   }
 
   // loop over beads of list 1 again to get the correlations
-  for (auto &iter : list1) {
-    cell_t &cell = getCell(iter->getPos());
-    TestBead(top, cell, iter);
-  }
+  DispatchBoundaryCondition(top.getBoundary(), [&](const auto &bc) {
+    for (auto &iter : list1) {
+      cell_t &cell = getCell(iter->getPos());
+      TestBead(top, bc, cell, iter);
+    }
+  });
 }
 
 void NBListGrid_3Body::Generate(BeadList &list1, BeadList &list2,
@@ -100,10 +103,12 @@ void NBListGrid_3Body::Generate(BeadList &list1, BeadList &list2,
   }
 
   // loop over beads of list 1 again to get the correlations
-  for (auto &bead : list1) {
-    cell_t &cell = getCell(bead->getPos());
-    TestBead(top, cell, bead);
-  }
+  DispatchBoundaryCondition(top.getBoundary(), [&](const auto &bc) {
+    for (auto &bead : list1) {
+      cell_t &cell = getCell(bead->getPos());
+      TestBead(top, bc, cell, bead);
+    }
+  });
 }
 
 void NBListGrid_3Body::Generate(BeadList &list, bool do_exclusions) {
@@ -128,10 +133,12 @@ void NBListGrid_3Body::Generate(BeadList &list, bool do_exclusions) {
 
   // loop over beads again to get the correlations (as all of the same type
   // here)
-  for (auto &bead : list) {
-    cell_t &cell = getCell(bead->getPos());
-    TestBead(top, cell, bead);
-  }
+  DispatchBoundaryCondition(top.getBoundary(), [&](const auto &bc) {
+    for (auto &bead : list) {
+      cell_t &cell = getCell(bead->getPos());
+      TestBead(top, bc, cell, bead);
+    }
+  });
 }
 
 void NBListGrid_3Body::InitializeGrid(const Eigen::Matrix3d &box) {
@@ -232,7 +239,8 @@ NBListGrid_3Body::cell_t &NBListGrid_3Body::getCell(const Eigen::Vector3d &r) {
   return getCell(a, b, c);
 }
 
-void NBListGrid_3Body::TestBead(const Topology &top,
+template <typename BC>
+void NBListGrid_3Body::TestBead(const Topology &top, const BC &bc,
                                 NBListGrid_3Body::cell_t &cell, Bead *bead) {
   BeadList::iterator iter2;
   BeadList::iterator iter3;
@@ -266,9 +274,9 @@ void NBListGrid_3Body::TestBead(const Topology &top,
           Eigen::Vector3d v = (*iter2)->getPos();
           Eigen::Vector3d z = (*iter3)->getPos();
 
-          Eigen::Vector3d r12 = top.BCShortestConnection(u, v);
-          Eigen::Vector3d r13 = top.BCShortestConnection(u, z);
-          Eigen::Vector3d r23 = top.BCShortestConnection(v, z);
+          Eigen::Vector3d r12 = bc.BCShortestConnection(u, v);
+          Eigen::Vector3d r13 = bc.BCShortestConnection(u, z);
+          Eigen::Vector3d r23 = bc.BCShortestConnection(v, z);
           double d12 = r12.norm();
           double d13 = r13.norm();
           double d23 = r23.norm();
@@ -16,6 +16,7 @@
  */
 
 // Standard includes
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <regex>
@@ -46,7 +47,14 @@ bool is_digits(const std::string &str) {
 
 Topology::~Topology() { Cleanup(); }
 
+void Topology::BumpRevision() {
+  static std::atomic<Index> next_revision{1};
+  revision_ = next_revision++;
+}
+
 void Topology::Cleanup() {
+  BumpRevision();
+
   // cleanup beads
   beads_.clear();
 
@@ -145,6 +153,7 @@ void Topology::RenameMolecules(string range, string name) {
     }
     getMolecule(i - 1)->setName(name);
   }
+  BumpRevision();
 }
 
 void Topology::RenameBeadType(string name, string newname) {
@@ -155,6 +164,7 @@ void Topology::RenameBeadType(string name, string newname) {
       bead.setType(newname);
     }
   }
+  BumpRevision();
 }
 
 void Topology::SetBeadTypeMass(string name, double value) {
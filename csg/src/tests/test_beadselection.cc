@@ -0,0 +1,116 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE beadselection_test
+
+// Standard includes
+#include <string>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/csg/beadlist.h"
+#include "votca/csg/beadselection.h"
+#include "votca/csg/topology.h"
+
+using namespace std;
+using namespace votca::csg;
+
+namespace {
+// two molecules, each with a bead of type A named A1 and type B named B1
+void CreateTopology(Topology &top) {
+  top.RegisterBeadType("A");
+  top.RegisterBeadType("B");
+  for (votca::Index m = 0; m < 2; m++) {
+    Molecule *mol = top.CreateMolecule(m == 0 ? "MolX" : "MolY");
+    Bead *a = top.CreateBead(Bead::spherical, "A1", "A", 0, 1.0, 0.0);
+    Bead *b = top.CreateBead(Bead::spherical, "B1", "B", 0, 1.0, 0.0);
+    mol->AddBead(a, "A1");
+    mol->AddBead(b, "B1");
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(beadselection_test)
+
+BOOST_AUTO_TEST_CASE(select_by_type) {
+  Topology top;
+  CreateTopology(top);
+
+  BeadSelection selection("A");
+  vector<votca::Index> ref = {0, 2};
+  BOOST_CHECK(selection.Select(top) == ref);
+
+  BeadSelection all("*");
+  BOOST_CHECK_EQUAL(all.Select(top).size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(select_by_name_and_molecule) {
+  Topology top;
+  CreateTopology(top);
+
+  BeadSelection selection("name:B*");
+  vector<votca::Index> ref = {1, 3};
+  BOOST_CHECK(selection.Select(top) == ref);
+
+  BeadSelection in_mol("name:B*", "MolY");
+  vector<votca::Index> ref_mol = {3};
+  BOOST_CHECK(in_mol.Select(top) == ref_mol);
+}
+
+BOOST_AUTO_TEST_CASE(recompile_on_topology_change) {
+  Topology top;
+  CreateTopology(top);
+
+  BeadSelection selection("A");
+  BOOST_CHECK_EQUAL(selection.Select(top).size(), 2);
+
+  // positions do not change the revision
+  votca::Index revision = top.getRevision();
+  top.getBead(0)->setPos(Eigen::Vector3d::Ones());
+  BOOST_CHECK_EQUAL(top.getRevision(), revision);
+
+  top.RenameBeadType("B", "A");
+  BOOST_CHECK_EQUAL(selection.Select(top).size(), 4);
+
+  top.CreateBead(Bead::spherical, "A2", "A", 0, 1.0, 0.0);
+  BOOST_CHECK_EQUAL(selection.Select(top).size(), 5);
+
+  // a different topology with the same layout has a different revision
+  Topology top2;
+  CreateTopology(top2);
+  BOOST_CHECK_EQUAL(selection.Select(top2).size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(beadlist_generate) {
+  Topology top;
+  CreateTopology(top);
+
+  BeadSelection selection("B");
+  BeadList beads;
+  BOOST_CHECK_EQUAL(beads.Generate(top, selection), 2);
+  BOOST_CHECK_EQUAL((*beads.begin())->getId(), 1);
+
+  BeadList beads_str;
+  BOOST_CHECK_EQUAL(beads_str.Generate(top, "name:A1"), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
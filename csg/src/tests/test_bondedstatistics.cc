@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 // Third party includes
 #include <boost/test/unit_test.hpp>
@@ -142,4 +143,46 @@ BOOST_AUTO_TEST_CASE(test_evalconfiguration_begin) {
 
   top.Cleanup();
 }
+
+BOOST_AUTO_TEST_CASE(test_bondedstatistics_streaming) {
+  Topology top;
+  auto bond1 = new IBond(0, 1);
+  bond1->setGroup("covalent_bond1");
+  auto bond2 = new IBond(1, 2);
+  bond2->setGroup("covalent_bond2");
+  top.AddBondedInteraction(bond1);
+  top.AddBondedInteraction(bond2);
+
+  BondedStatistics bonded_statistics;
+  bonded_statistics.setStreaming(0.001);
+  bonded_statistics.BeginCG(&top, nullptr);
+  for (double value : {1.0, 1.002, 0.998, 1.0}) {
+    bonded_statistics.AddFrame({value, 2.0});
+  }
+
+  // nothing is stored per frame
+  BOOST_CHECK_EQUAL(bonded_statistics.BondedValues().Data().size(), 0);
+
+  vector<const StreamedValues *> sel;
+  bonded_statistics.SelectStreamed("*bond1", sel);
+  BOOST_REQUIRE_EQUAL(sel.size(), 1);
+  BOOST_CHECK_EQUAL(sel[0]->getName(), ":covalent_bond1");
+  BOOST_CHECK_EQUAL(sel[0]->Samples(), 4);
+
+  vector<double> centers;
+  vector<double> counts;
+  sel[0]->AppendHistogram(centers, counts);
+  vector<double> centers_ref = {0.998, 1.0, 1.002};
+  vector<double> counts_ref = {1, 2, 1};
+  BOOST_REQUIRE_EQUAL(centers.size(), 3);
+  for (size_t i = 0; i < centers.size(); ++i) {
+    BOOST_CHECK_CLOSE(centers[i], centers_ref[i], 1e-10);
+    BOOST_CHECK_EQUAL(counts[i], counts_ref[i]);
+  }
+
+  bonded_statistics.SelectStreamed("*", sel);
+  BOOST_CHECK_EQUAL(sel.size(), 3);
+  BOOST_CHECK_THROW(bonded_statistics.AddFrame({1.0}), std::runtime_error);
+  top.Cleanup();
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -27,6 +27,7 @@
 #include <boost/test/unit_test.hpp>
 
 // Local VOTCA includes
+#include "votca/csg/boundaryconditiondispatch.h"
 #include "votca/csg/openbox.h"
 #include "votca/csg/orthorhombicbox.h"
 #include "votca/csg/triclinicbox.h"
@@ -126,4 +127,33 @@ BOOST_AUTO_TEST_CASE(test_boundarycondition_clone) {
   BOOST_CHECK_EQUAL(boundaries.at(1)->BoxVolume(), 0.0);
   BOOST_CHECK_EQUAL(boundaries.at(2)->BoxVolume(), 0.0);
 }
+
+BOOST_AUTO_TEST_CASE(test_boundarycondition_dispatch) {
+  vector<unique_ptr<BoundaryCondition>> boundaries;
+
+  boundaries.push_back(std::make_unique<OpenBox>());
+  boundaries.push_back(std::make_unique<TriclinicBox>());
+  boundaries.push_back(std::make_unique<OrthorhombicBox>());
+
+  Eigen::Matrix3d box;
+  box << 4.0, 1.0, 0.5, 0.0, 5.0, 1.0, 0.0, 0.0, 6.0;
+  boundaries.at(0)->setBox(box);
+  boundaries.at(1)->setBox(box);
+  boundaries.at(2)->setBox(Eigen::Matrix3d(box.diagonal().asDiagonal()));
+
+  Eigen::Vector3d r_i(0.2, 0.3, 0.1);
+  Eigen::Vector3d r_j(3.9, 4.8, 5.7);
+  for (const auto &bc : boundaries) {
+    Eigen::Vector3d r_virtual = bc->BCShortestConnection(r_i, r_j);
+    Eigen::Vector3d r_dispatch = DispatchBoundaryCondition(
+        *bc, [&](const auto &concrete) {
+          return concrete.BCShortestConnection(r_i, r_j);
+        });
+    BOOST_CHECK(r_virtual.isApprox(r_dispatch, 1e-12));
+  }
+  // the minimum image is shorter than the direct connection
+  BOOST_CHECK_LT(boundaries.at(2)->BCShortestConnection(r_i, r_j).norm(),
+                 (r_j - r_i).norm());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -21,6 +21,8 @@
 #include <votca/tools/tokenizer.h>
 
 // Local VOTCA includes
+#include "votca/csg/beadselection.h"
+#include "votca/csg/boundaryconditiondispatch.h"
 #include "votca/csg/csgapplication.h"
 
 using namespace std;
@@ -68,6 +70,8 @@ class CsgDensityApp : public CsgApplication {
   Eigen::Vector3d axis_;
   string axisname_;
   string molname_;
+  // beads matching filter_ in molecules matching molname_
+  BeadSelection selection_;
   double area_;
   void WriteDensity(votca::Index nframes, const string &suffix = "");
 };
@@ -126,6 +130,8 @@ void CsgDensityApp::BeginEvaluate(Topology *top, Topology *) {
         "reference center can only be used in case of spherical density");
   }
 
+  selection_ = BeadSelection("name:" + filter_, molname_);
+
   nbin_ = (votca::Index)floor(rmax_ / step_);
   dist_.Initialize(0, rmax_, nbin_);
 
@@ -137,21 +143,14 @@ void CsgDensityApp::BeginEvaluate(Topology *top, Topology *) {
 }
 
 void CsgDensityApp::EvalConfiguration(Topology *top, Topology *) {
-  // loop over all molecules
+  // loop over all selected beads
   bool did_something = false;
-  for (const auto &mol : top->Molecules()) {
-    if (!votca::tools::wildcmp(molname_, mol.getName())) {
-      continue;
-    }
-    votca::Index N = mol.BeadCount();
-    for (votca::Index i = 0; i < N; i++) {
-      const Bead *b = mol.getBead(i);
-      if (!votca::tools::wildcmp(filter_, b->getName())) {
-        continue;
-      }
+  DispatchBoundaryCondition(top->getBoundary(), [&](const auto &bc) {
+    for (votca::Index id : selection_.Select(*top)) {
+      const Bead *b = top->getBead(id);
       double r;
       if (axisname_ == "r") {
-        r = (top->BCShortestConnection(ref_, b->getPos()).norm());
+        r = (bc.BCShortestConnection(ref_, b->getPos()).norm());
       } else {
         r = b->getPos().dot(axis_);
       }
@@ -162,7 +161,7 @@ void CsgDensityApp::EvalConfiguration(Topology *top, Topology *) {
       }
       did_something = true;
     }
-  }
+  });
   frames_++;
   if (!did_something) {
     throw std::runtime_error("No molecule in selection");
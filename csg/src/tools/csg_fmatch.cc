@@ -200,6 +200,7 @@ CGForceMatching::SplineInfo::SplineInfo(votca::Index index,
       type1 = options->get("type1").value();
       type2 = options->get("type2").value();
       type3 = options->get("type3").value();
+      selection3 = BeadSelection(type3);
       // read in additional parameters for threebody interactions
       if (options->exists("fmatch.a")) {
         a = options->get("fmatch.a").as<double>();
@@ -216,6 +217,8 @@ CGForceMatching::SplineInfo::SplineInfo(votca::Index index,
       type1 = options->get("type1").value();
       type2 = options->get("type2").value();
     }
+    selection1 = BeadSelection(type1);
+    selection2 = BeadSelection(type2);
   }
   if (bonded) {
     // check if option periodic exists
@@ -634,8 +637,8 @@ void CGForceMatching::EvalNonbonded(Topology *conf, SplineInfo *sinfo) {
 
   // generate the bead lists
   BeadList beads1, beads2;
-  beads1.Generate(*conf, sinfo->type1);
-  beads2.Generate(*conf, sinfo->type2);
+  beads1.Generate(*conf, sinfo->selection1);
+  beads2.Generate(*conf, sinfo->selection2);
 
   // is it same types or different types?
   if (sinfo->type1 == sinfo->type2) {
@@ -714,9 +717,9 @@ void CGForceMatching::EvalNonbonded_Threebody(Topology *conf,
 
   // generate the bead lists
   BeadList beads1, beads2, beads3;
-  beads1.Generate(*conf, sinfo->type1);
-  beads2.Generate(*conf, sinfo->type2);
-  beads3.Generate(*conf, sinfo->type3);
+  beads1.Generate(*conf, sinfo->selection1);
+  beads2.Generate(*conf, sinfo->selection2);
+  beads3.Generate(*conf, sinfo->selection3);
 
   // check if type1 and type2 are the same
   if (sinfo->type1 == sinfo->type2) {
@@ -23,6 +23,7 @@
 #include <votca/tools/property.h>
 
 // Local VOTCA includes
+#include "votca/csg/beadselection.h"
 #include "votca/csg/csgapplication.h"
 #include "votca/csg/trajectoryreader.h"
 
@@ -128,6 +129,8 @@ class CGForceMatching : public CsgApplication {
     /// \brief for non-bonded interactions: types of beads involved (type3 only
     /// used if threebody interaction)
     string type1, type2, type3;  //
+    /// \brief compiled bead selections of type1, type2 and type3
+    BeadSelection selection1, selection2, selection3;
 
     /// \brief pointer to Property object to handle input options
     votca::tools::Property *options_;
@@ -17,9 +17,12 @@
 
 // Standard includes
 #include <fstream>
+#include <functional>
+#include <iomanip>
 
 // VOTCA includes
 #include <votca/tools/table.h>
+#include <votca/tools/tokenizer.h>
 
 // Local VOTCA includes
 #include "votca/csg/imcio.h"
@@ -39,6 +42,16 @@ void CG_IMC_solve::Initialize(void) {
                       propt::value<double>()->default_value(0.0),
                       "regularization factor");
 
+  AddProgramOptions()(
+      "algorithm,a", propt::value<std::string>()->default_value("eigen"),
+      "eigen: eigendecomposition of A^T A, svd: thin svd of A, cgls: "
+      "conjugate gradients on A without forming A^T A");
+
+  AddProgramOptions()("scan", propt::value<std::string>(),
+                      "list of regularization factors, writes residual and "
+                      "solution norm for each of them to "
+                      "regularization_scan.dat (L-curve)");
+
   AddProgramOptions()("imcfile,i", boost::program_options::value<std::string>(),
                       "imc statefile");
 
@@ -53,6 +66,11 @@ bool CG_IMC_solve::EvaluateOptions() {
   CheckRequired("imcfile", "Missing imcfile");
   CheckRequired("gmcfile", "Missing gmcfile");
   CheckRequired("idxfile", "Missing idxfile");
+  std::string algorithm = OptionsMap()["algorithm"].as<std::string>();
+  if (algorithm != "eigen" && algorithm != "svd" && algorithm != "cgls") {
+    throw std::runtime_error("Unknown algorithm '" + algorithm +
+                             "', use eigen, svd or cgls");
+  }
   return true;
 }
 
@@ -71,43 +89,33 @@ void CG_IMC_solve::Run() {
   x.x() = B.x();
 
   // Calculating https://en.wikipedia.org/wiki/Tikhonov_regularization
-
-  Eigen::MatrixXd ATA = A.transpose() * A;
-
-  // We could add and invert but for stability reasons we will diagonalize the
-  // matrix which is symmetric by construction
-
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(ATA);
-
-  Eigen::VectorXd inv_diag = Eigen::VectorXd::Zero(es.eigenvalues().size());
-  double etol = 1e-12;
-
-  votca::Index numerics_unstable = 0;
-  // Constructing pseudoinverse if not stable
-  // https://en.wikipedia.org/wiki/Moore%E2%80%93Penrose_inverse
-  for (votca::Index i = 0; i < es.eigenvalues().size(); i++) {
-    if (std::abs(es.eigenvalues()[i] + reg) < etol) {
-      numerics_unstable++;
-    } else {
-      inv_diag[i] = 1 / (es.eigenvalues()[i] + reg);
-    }
+  // x = -(A^T A + reg)^-1 A^T b, the factorizations do not depend on reg, so
+  // they are reused for all regularization factors of a scan
+  std::string algorithm = OptionsMap()["algorithm"].as<std::string>();
+  std::function<Eigen::VectorXd(double)> solve;
+  if (algorithm == "eigen") {
+    solve = SolveEigen(A, B.y());
+  } else if (algorithm == "svd") {
+    solve = SolveSVD(A, B.y());
+  } else {
+    solve = SolveCGLS(A, B.y());
   }
 
-  if (numerics_unstable > 0) {
-    std::cout
-        << "Regularisation parameter was to small, a pseudo inverse was "
-           "constructed instead.\n Use a larger regularisation parameter R."
-           " Smallest (eigenvalue+R)="
-        << (es.eigenvalues().array() + reg).abs().minCoeff() << " Found "
-        << numerics_unstable << " eigenvalues of " << es.eigenvalues().size()
-        << " below " << etol << std::endl;
+  x.y() = solve(reg);
+
+  if (OptionsMap().count("scan")) {
+    std::vector<double> regs =
+        votca::tools::Tokenizer(OptionsMap()["scan"].as<std::string>(), " ,")
+            .ToVector<double>();
+    std::ofstream out("regularization_scan.dat");
+    out << "# regularization |Ax+b| |x|\n";
+    for (double r : regs) {
+      Eigen::VectorXd xr = solve(r);
+      out << std::scientific << std::setprecision(8) << r << " "
+          << (A * xr + B.y()).norm() << " " << xr.norm() << "\n";
+    }
   }
 
-  Eigen::MatrixXd inverse =
-      es.eigenvectors() * inv_diag.asDiagonal() * es.eigenvectors().transpose();
-
-  x.y() = -inverse * A.transpose() * B.y();
-
   std::string idxfile = OptionsMap()["idxfile"].as<std::string>();
   std::vector<std::pair<std::string, votca::tools::RangeParser> > ranges =
       votca::csg::imcio_read_index(idxfile);
@@ -119,3 +127,115 @@ void CG_IMC_solve::Run() {
     tbl.Save(range.first + ".dpot.imc");
   }
 }
+
+std::function<Eigen::VectorXd(double)> CG_IMC_solve::SolveEigen(
+    const Eigen::MatrixXd& A, const Eigen::VectorXd& b) {
+
+  Eigen::MatrixXd ATA = A.transpose() * A;
+
+  // We could add and invert but for stability reasons we will diagonalize the
+  // matrix which is symmetric by construction
+  auto es = std::make_shared<Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> >(
+      ATA);
+  Eigen::VectorXd ATb = es->eigenvectors().transpose() * (A.transpose() * b);
+
+  return [es, ATb](double reg) {
+    const Eigen::VectorXd& eigenvalues = es->eigenvalues();
+    Eigen::VectorXd inv_diag = Eigen::VectorXd::Zero(eigenvalues.size());
+    double etol = 1e-12;
+
+    votca::Index numerics_unstable = 0;
+    // Constructing pseudoinverse if not stable
+    // https://en.wikipedia.org/wiki/Moore%E2%80%93Penrose_inverse
+    for (votca::Index i = 0; i < eigenvalues.size(); i++) {
+      if (std::abs(eigenvalues[i] + reg) < etol) {
+        numerics_unstable++;
+      } else {
+        inv_diag[i] = 1 / (eigenvalues[i] + reg);
+      }
+    }
+
+    if (numerics_unstable > 0) {
+      std::cout
+          << "Regularisation parameter was to small, a pseudo inverse was "
+             "constructed instead.\n Use a larger regularisation parameter R."
+             " Smallest (eigenvalue+R)="
+          << (eigenvalues.array() + reg).abs().minCoeff() << " Found "
+          << numerics_unstable << " eigenvalues of " << eigenvalues.size()
+          << " below " << etol << std::endl;
+    }
+
+    Eigen::VectorXd x =
+        -(es->eigenvectors() * (inv_diag.asDiagonal() * ATb)).eval();
+    return x;
+  };
+}
+
+std::function<Eigen::VectorXd(double)> CG_IMC_solve::SolveSVD(
+    const Eigen::MatrixXd& A, const Eigen::VectorXd& b) {
+
+  // A = U S V^T, so (A^T A + reg)^-1 A^T = V (S^2 + reg)^-1 S U^T
+  auto svd = std::make_shared<Eigen::BDCSVD<Eigen::MatrixXd> >(
+      A, Eigen::ComputeThinU | Eigen::ComputeThinV);
+  Eigen::VectorXd UTb = svd->matrixU().transpose() * b;
+
+  return [svd, UTb](double reg) {
+    const Eigen::VectorXd& s = svd->singularValues();
+    Eigen::VectorXd filter = Eigen::VectorXd::Zero(s.size());
+    double etol = 1e-12;
+    votca::Index numerics_unstable = 0;
+    for (votca::Index i = 0; i < s.size(); i++) {
+      double denom = s[i] * s[i] + reg;
+      if (std::abs(denom) < etol) {
+        numerics_unstable++;
+      } else {
+        filter[i] = s[i] / denom;
+      }
+    }
+    if (numerics_unstable > 0) {
+      std::cout << "Regularisation parameter was to small, " << numerics_unstable
+                << " of " << s.size()
+                << " singular values were dropped (pseudo inverse).\n Use a "
+                   "larger regularisation parameter R."
+                << std::endl;
+    }
+    Eigen::VectorXd x =
+        -(svd->matrixV() * (filter.asDiagonal() * UTb)).eval();
+    return x;
+  };
+}
+
+std::function<Eigen::VectorXd(double)> CG_IMC_solve::SolveCGLS(
+    const Eigen::MatrixXd& A, const Eigen::VectorXd& b) {
+
+  // CGLS for min |A y - b|^2 + reg |y|^2, which only needs products with A
+  // and A^T, x=-y. A and b are not copied and have to outlive the solver.
+  return [&A, &b](double reg) {
+    Eigen::VectorXd y = Eigen::VectorXd::Zero(A.cols());
+    Eigen::VectorXd r = b;
+    Eigen::VectorXd s = A.transpose() * r;
+    Eigen::VectorXd p = s;
+    double gamma = s.squaredNorm();
+    const double gamma0 = gamma;
+    const double tol = 1e-24;
+    const votca::Index max_iter = 10 * A.cols();
+    votca::Index iter = 0;
+    for (; iter < max_iter && gamma > tol * gamma0; iter++) {
+      Eigen::VectorXd q = A * p;
+      double alpha = gamma / (q.squaredNorm() + reg * p.squaredNorm());
+      y += alpha * p;
+      r -= alpha * q;
+      s = A.transpose() * r - reg * y;
+      double gamma_new = s.squaredNorm();
+      p = s + (gamma_new / gamma) * p;
+      gamma = gamma_new;
+    }
+    if (gamma > tol * gamma0) {
+      std::cout << "CGLS did not converge within " << max_iter
+                << " iterations, relative residual of the normal equations "
+                << std::sqrt(gamma / gamma0)
+                << ".\n Use a larger regularisation parameter R." << std::endl;
+    }
+    return Eigen::VectorXd(-y);
+  };
+}
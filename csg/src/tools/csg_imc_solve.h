@@ -18,6 +18,9 @@
 #ifndef VOTCA_CSG_CSG_IMC_SOLVE_H
 #define VOTCA_CSG_CSG_IMC_SOLVE_H
 
+// Standard includes
+#include <functional>
+
 // VOTCA includes
 #include <votca/tools/application.h>
 #include <votca/tools/property.h>
@@ -52,6 +55,16 @@ class CG_IMC_solve : public votca::tools::Application {
   bool EvaluateOptions() override;
   void Initialize() override;
   void Run() override;
+
+ private:
+  // each returns the solution x for a given regularization factor, sharing
+  // the factorization of A between calls
+  static std::function<Eigen::VectorXd(double)> SolveEigen(
+      const Eigen::MatrixXd &A, const Eigen::VectorXd &b);
+  static std::function<Eigen::VectorXd(double)> SolveSVD(
+      const Eigen::MatrixXd &A, const Eigen::VectorXd &b);
+  static std::function<Eigen::VectorXd(double)> SolveCGLS(
+      const Eigen::MatrixXd &A, const Eigen::VectorXd &b);
 };
 
 #endif  // VOTCA_CSG_CSG_IMC_SOLVE_H
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -80,7 +80,8 @@ int main(int argc, char **argv) {
       "comment", po::value<string>(&comment),
       "store a comment in the output table")(
       "boundaries", po::value<string>(&boundaries),
-      "(natural|periodic|derivativezero) sets boundary conditions");
+      "(natural|periodic|derivativezero) sets boundary conditions")(
+      "binary", "write the output tables in binary format");
 
   po::variables_map vm;
   try {
@@ -264,12 +265,20 @@ int main(int argc, char **argv) {
       der.flags(i) = in.flags(j);
     }
 
-    out.Save(out_file);
+    if (vm.count("binary")) {
+      out.SaveBinary(out_file);
+    } else {
+      out.Save(out_file);
+    }
 
     if (vm.count("derivative")) {
       der.y() = spline->CalculateDerivative(der.x());
 
-      der.Save(vm["derivative"].as<string>());
+      if (vm.count("binary")) {
+        der.SaveBinary(vm["derivative"].as<string>());
+      } else {
+        der.Save(vm["derivative"].as<string>());
+      }
     }
 
   } catch (std::exception &error) {
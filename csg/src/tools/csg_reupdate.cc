@@ -472,6 +472,9 @@ std::unique_ptr<CsgApplication::Worker> CsgREupdate::ForkWorker() {
 
     PotentialInfo *i = new PotentialInfo(worker->potentials_.size(), false,
                                          worker->nlamda_, param_in_ext_, prop);
+    if (i->hist_step > 0.0) {
+      i->TabulateOnGrid();
+    }
     // update parameter counter
     worker->nlamda_ += i->ucg->getOptParamSize();
 
@@ -503,6 +506,17 @@ std::unique_ptr<CsgApplication::Worker> CsgREupdate::ForkWorker() {
   worker->beta_ = (1.0 / worker->options_.get("cg.inverse.kBT").as<double>());
   worker->UavgCG_ = 0.0;
 
+  worker->gridsearch_ = false;
+  if (options_.exists("cg.nbsearch")) {
+    if (options_.get("cg.nbsearch").as<string>() == "grid") {
+      worker->gridsearch_ = true;
+    } else if (options_.get("cg.nbsearch").as<string>() == "simple") {
+      worker->gridsearch_ = false;
+    } else {
+      throw std::runtime_error("cg.nbsearch invalid, can be grid or simple");
+    }
+  }
+
   return worker;
 }
 
@@ -552,8 +566,8 @@ void CsgREupdateWorker::EvalConfiguration(Topology *conf, Topology *) {
 void CsgREupdateWorker::EvalNonbonded(Topology *conf, PotentialInfo *potinfo) {
 
   BeadList beads1, beads2;
-  beads1.Generate(*conf, potinfo->type1);
-  beads2.Generate(*conf, potinfo->type2);
+  beads1.Generate(*conf, potinfo->selection1);
+  beads2.Generate(*conf, potinfo->selection2);
 
   if (beads1.size() == 0) {
     throw std::runtime_error("Topology does not have beads of type \"" +
@@ -571,20 +585,7 @@ void CsgREupdateWorker::EvalNonbonded(Topology *conf, PotentialInfo *potinfo) {
   }
 
   std::unique_ptr<NBList> nb;
-  bool gridsearch = false;
-
-  if (options_.exists("cg.nbsearch")) {
-
-    if (options_.get("cg.nbsearch").as<string>() == "grid") {
-      gridsearch = true;
-    } else if (options_.get("cg.nbsearch").as<string>() == "simple") {
-      gridsearch = false;
-    } else {
-      throw std::runtime_error("cg.nbsearch invalid, can be grid or simple");
-    }
-  }
-
-  if (gridsearch) {
+  if (gridsearch_) {
     nb = std::make_unique<NBListGrid>();
   } else {
     nb = std::make_unique<NBList>();
@@ -601,6 +602,39 @@ void CsgREupdateWorker::EvalNonbonded(Topology *conf, PotentialInfo *potinfo) {
   votca::Index pos_start = potinfo->vec_pos;
   votca::Index pos_max = pos_start + potinfo->ucg->getOptParamSize();
 
+  if (potinfo->hist_step > 0.0) {
+    /* bin the pair distances with linear weights onto the grid, U and its
+     * derivatives are then the contraction of the histogram with the values
+     * tabulated on the grid, i.e. the exact sum over the pairs of the
+     * linearly interpolated functions
+     */
+    Eigen::VectorXd hist = Eigen::VectorXd::Zero(potinfo->gridU.size());
+    votca::Index last = hist.size() - 1;
+    for (auto &pair_iter : *nb) {
+      double x = pair_iter->dist() / potinfo->hist_step;
+      votca::Index k = std::min(votca::Index(x), last - 1);
+      double w = x - double(k);
+      hist(k) += 1.0 - w;
+      hist(k + 1) += w;
+    }
+
+    UavgCG_ += hist.dot(potinfo->gridU);
+    dUFrame_.segment(pos_start, pos_max - pos_start) =
+        potinfo->gridDU.transpose() * hist;
+    if (!potinfo->d2u_pairs.empty()) {
+      Eigen::VectorXd d2U = potinfo->gridD2U.transpose() * hist;
+      for (votca::Index p = 0; p < d2U.size(); p++) {
+        votca::Index row = pos_start + potinfo->d2u_pairs[p].first;
+        votca::Index col = pos_start + potinfo->d2u_pairs[p].second;
+        HS_(row, col) -= beta_ * d2U(p);
+        if (row != col) {
+          HS_(col, row) -= beta_ * d2U(p);
+        }
+      }
+    }
+    return;
+  }
+
   // compute total energy
   double U = 0.0;
   for (auto &pair_iter : *nb) {
@@ -655,10 +689,18 @@ PotentialInfo::PotentialInfo(votca::Index index, bool bonded_,
   potentialName = options_->get("name").value();
   type1 = options_->get("type1").value();
   type2 = options_->get("type2").value();
+  selection1 = BeadSelection(type1);
+  selection2 = BeadSelection(type2);
   potentialFunction = options_->get("re.function").value();
 
   rmin = options_->get("min").as<double>();
   rcut = options_->get("max").as<double>();
+  hist_step = options_->ifExistsReturnElseReturnDefault<double>("re.hist_step",
+                                                               0.0);
+  if (hist_step < 0.0) {
+    throw std::runtime_error("re.hist_step of interaction " + potentialName +
+                             " has to be positive.");
+  }
 
   // assign the user selected function form for this potential
   if (potentialFunction == "lj126") {
@@ -709,3 +751,48 @@ PotentialInfo::PotentialInfo(votca::Index index, bool bonded_,
   string oldparam_file_name = potentialName + "." + param_in_ext_;
   ucg->setParam(oldparam_file_name);
 }
+
+void PotentialInfo::TabulateOnGrid() {
+
+  // one additional grid point, so that the linear weights of a pair at the
+  // cut-off can be distributed
+  votca::Index ngrid = votca::Index(ucg->getCutOff() / hist_step) + 2;
+  votca::Index nlam = ucg->getOptParamSize();
+
+  gridU.resize(ngrid);
+  gridDU.resize(ngrid, nlam);
+  for (votca::Index k = 0; k < ngrid; k++) {
+    double r = double(k) * hist_step;
+    gridU(k) = ucg->CalculateF(r);
+    for (votca::Index i = 0; i < nlam; i++) {
+      gridDU(k, i) = ucg->CalculateDF(i, r);
+    }
+  }
+  // r = 0 is not a valid pair distance, but e.g. lj126 with min 0 diverges
+  // there and would turn the whole contraction into NaN
+  gridU = gridU.unaryExpr([](double v) { return std::isfinite(v) ? v : 0.0; });
+  gridDU =
+      gridDU.unaryExpr([](double v) { return std::isfinite(v) ? v : 0.0; });
+
+  // most potential forms are linear in (most of) their parameters, so only
+  // keep the second derivatives which do not vanish on the whole grid
+  d2u_pairs.clear();
+  std::vector<Eigen::VectorXd> columns;
+  for (votca::Index i = 0; i < nlam; i++) {
+    for (votca::Index j = i; j < nlam; j++) {
+      Eigen::VectorXd col(ngrid);
+      for (votca::Index k = 0; k < ngrid; k++) {
+        double v = ucg->CalculateD2F(i, j, double(k) * hist_step);
+        col(k) = std::isfinite(v) ? v : 0.0;
+      }
+      if (!col.isZero(0.0)) {
+        d2u_pairs.push_back({i, j});
+        columns.push_back(col);
+      }
+    }
+  }
+  gridD2U.resize(ngrid, votca::Index(columns.size()));
+  for (votca::Index c = 0; c < gridD2U.cols(); c++) {
+    gridD2U.col(c) = columns[c];
+  }
+}
@@ -27,6 +27,7 @@
 #include <votca/tools/table.h>
 
 // Local VOTCA includes
+#include "votca/csg/beadselection.h"
 #include "votca/csg/csgapplication.h"
 #include "votca/csg/potentialfunctions/potentialfunction.h"
 #include "votca/csg/potentialfunctions/potentialfunctioncbspl.h"
@@ -52,9 +53,22 @@ struct PotentialInfo {
   std::string potentialName;
   std::string potentialFunction;
   std::string type1, type2;
+  BeadSelection selection1, selection2;
 
   double rmin, rcut;
 
+  // spacing of the pair distance histogram, 0 means every pair is evaluated
+  double hist_step = 0.0;
+  // U, dU/dlamda_i and the non-zero d2U/dlamda_i dlamda_j tabulated on the
+  // histogram grid r_k = k * hist_step
+  Eigen::VectorXd gridU;
+  Eigen::MatrixXd gridDU;
+  Eigen::MatrixXd gridD2U;
+  std::vector<std::pair<votca::Index, votca::Index>> d2u_pairs;
+
+  // tabulate U and its parameter derivatives for the histogram evaluation
+  void TabulateOnGrid();
+
   Property *options_;
 };
 
@@ -152,6 +166,7 @@ class CsgREupdateWorker : public CsgApplication::Worker {
   double UavgCG_;
   double beta_;
   votca::Index nframes_;
+  bool gridsearch_ = false;
 
   void EvalConfiguration(Topology *conf, Topology *conf_atom) override;
   void EvalBonded(Topology *conf, PotentialInfo *potinfo);
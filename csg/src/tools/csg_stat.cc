@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -83,7 +83,14 @@ void CsgStatApp::Initialize() {
       "include-intra", "  do not exclude intramolecular neighbors")(
       "block-length", boost::program_options::value<votca::Index>(),
       "  write blocks of this length, the averages are cleared after every "
-      "write")("ext",
+      "write")("block-stats",
+               "  average the distributions over all blocks and write mean and "
+               "error in one pass (needs --block-length)")(
+      "block-output",
+      boost::program_options::value<string>()->default_value("text"),
+      "  output of the single blocks: text, binary or none")(
+      "binary",
+      "  write the averaged distributions and forces as binary tables")("ext",
                boost::program_options::value<string>(&extension_)
                    ->default_value("dist.new"),
                "Extension of the output");
@@ -102,6 +109,28 @@ bool CsgStatApp::EvaluateOptions() {
     imc_.BlockLength(0);
   }
 
+  if (OptionsMap().count("block-stats")) {
+    if (!OptionsMap().count("block-length")) {
+      throw std::runtime_error("--block-stats needs --block-length");
+    }
+    imc_.BlockStatistics(true);
+  }
+
+  string block_output = OptionsMap()["block-output"].as<string>();
+  if (block_output == "text") {
+    imc_.BlockOutputFormat(Imc::BlockOutput::text);
+  } else if (block_output == "binary") {
+    imc_.BlockOutputFormat(Imc::BlockOutput::binary);
+  } else if (block_output == "none") {
+    imc_.BlockOutputFormat(Imc::BlockOutput::none);
+  } else {
+    throw std::runtime_error("--block-output must be text, binary or none");
+  }
+
+  if (OptionsMap().count("binary")) {
+    imc_.BinaryOutput(true);
+  }
+
   if (OptionsMap().count("do-imc")) {
     imc_.DoImc(true);
   }
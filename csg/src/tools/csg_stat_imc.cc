@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -212,9 +212,17 @@ Imc::interaction_t *Imc::AddInteraction(tools::Property *p, bool is_bonded) {
 
   i->norm_ = 1.0;
   i->p_ = p;
+  i->name_ = name;
+  if (!is_bonded) {
+    i->type1_ = p->get("type1").value();
+    i->type2_ = p->get("type2").value();
+  }
 
   // if option threebody does not exist, replace it by default of 0
   i->threebody_ = p->ifExistsReturnElseReturnDefault<bool>("threebody", 0);
+  if (i->threebody_) {
+    i->type3_ = p->get("type3").value();
+  }
 
   // if option force does not exist, replace it by default of 0
   i->force_ = p->ifExistsReturnElseReturnDefault<bool>("force", 0);
@@ -239,12 +247,15 @@ void Imc::EndEvaluate() {
   if (nframes_ > 0) {
     if (block_length_ == 0) {
       string suffix = string(".") + extension_;
-      WriteDist(suffix);
+      WriteDist(suffix, binary_output_);
       if (do_imc_) {
         WriteIMCData();
       }
     }
   }
+  if (block_length_ != 0 && block_stats_ && processed_some_frames_) {
+    WriteBlockStatistics();
+  }
   // clear interactions and groups
   interactions_.clear();
   groups_.clear();
@@ -259,6 +270,17 @@ void Imc::LoadOptions(const string &file) {
   options_.LoadFromXML(file);
   bonded_ = options_.Select("cg.bonded");
   nonbonded_ = options_.Select("cg.non-bonded");
+
+  gridsearch_ = true;
+  if (options_.exists("cg.nbsearch")) {
+    if (options_.get("cg.nbsearch").as<string>() == "grid") {
+      gridsearch_ = true;
+    } else if (options_.get("cg.nbsearch").as<string>() == "simple") {
+      gridsearch_ = false;
+    } else {
+      throw std::runtime_error("cg.nbsearch invalid, can be grid or simple");
+    }
+  }
 }
 
 // evaluate current conformation
@@ -300,26 +322,18 @@ class IMCNBSearchHandler {
 
 // process non-bonded interactions for current frame
 void Imc::Worker::DoNonbonded(Topology *top) {
-  for (tools::Property *prop : imc_->nonbonded_) {
-    string name = prop->get("name").value();
-
-    interaction_t &i = *imc_->interactions_[name];
+  for (auto &interaction : imc_->interactions_) {
+    interaction_t &i = *interaction.second;
+    if (i.is_bonded_) {
+      continue;
+    }
+    std::vector<BeadSelection> &selection = selections_[i.index_];
 
     // clear the current histogram
     current_hists_[i.index_].Clear();
     current_hists_force_[i.index_].Clear();
 
-    bool gridsearch = true;
-
-    if (imc_->options_.exists("cg.nbsearch")) {
-      if (imc_->options_.get("cg.nbsearch").as<string>() == "grid") {
-        gridsearch = true;
-      } else if (imc_->options_.get("cg.nbsearch").as<string>() == "simple") {
-        gridsearch = false;
-      } else {
-        throw std::runtime_error("cg.nbsearch invalid, can be grid or simple");
-      }
-    }
+    bool gridsearch = imc_->gridsearch_;
 
     // Preleminary: Quickest way to incorporate 3 body correlations
     if (i.threebody_) {
@@ -327,9 +341,9 @@ void Imc::Worker::DoNonbonded(Topology *top) {
       // generate the bead lists
       BeadList beads1, beads2, beads3;
 
-      beads1.Generate(*top, prop->get("type1").value());
-      beads2.Generate(*top, prop->get("type2").value());
-      beads3.Generate(*top, prop->get("type3").value());
+      beads1.Generate(*top, selection[0]);
+      beads2.Generate(*top, selection[1]);
+      beads3.Generate(*top, selection[2]);
 
       // generate the neighbour list
       std::unique_ptr<NBList_3Body> nb;
@@ -346,32 +360,32 @@ void Imc::Worker::DoNonbonded(Topology *top) {
       // interaction is zero
 
       // check if type1 and type2 are the same
-      if (prop->get("type1").value() == prop->get("type2").value()) {
+      if (i.type1_ == i.type2_) {
         // if all three types are the same
-        if (prop->get("type2").value() == prop->get("type3").value()) {
+        if (i.type2_ == i.type3_) {
           nb->Generate(beads1, true);
         }
         // if type2 and type3 are different, use the Generate function for 2
         // bead types
-        if (prop->get("type2").value() != prop->get("type3").value()) {
+        if (i.type2_ != i.type3_) {
           nb->Generate(beads1, beads3, true);
         }
       }
       // if type1 != type2
-      if (prop->get("type1").value() != prop->get("type2").value()) {
+      if (i.type1_ != i.type2_) {
         // if the last two types are the same, use Generate function with them
         // as the first two bead types Neighborlist_3body is constructed in a
         // way that the two equal bead types have two be the first 2 types
-        if (prop->get("type2").value() == prop->get("type3").value()) {
+        if (i.type2_ == i.type3_) {
           nb->Generate(beads1, beads2, true);
         }
-        if (prop->get("type2").value() != prop->get("type3").value()) {
+        if (i.type2_ != i.type3_) {
           // type1 = type3 !=type2
-          if (prop->get("type1").value() == prop->get("type3").value()) {
+          if (i.type1_ == i.type3_) {
             nb->Generate(beads2, beads1, true);
           }
           // type1 != type2 != type3
-          if (prop->get("type1").value() != prop->get("type3").value()) {
+          if (i.type1_ != i.type3_) {
             nb->Generate(beads1, beads2, beads3, true);
           }
         }
@@ -391,8 +405,8 @@ void Imc::Worker::DoNonbonded(Topology *top) {
       // generate the bead lists
       BeadList beads1, beads2;
 
-      beads1.Generate(*top, prop->get("type1").value());
-      beads2.Generate(*top, prop->get("type2").value());
+      beads1.Generate(*top, selection[0]);
+      beads2.Generate(*top, selection[1]);
 
       {
         // generate the neighbour list
@@ -410,7 +424,7 @@ void Imc::Worker::DoNonbonded(Topology *top) {
         nb->SetMatchFunction(&h, &IMCNBSearchHandler::FoundPair);
 
         // is it same types or different types?
-        if (prop->get("type1").value() == prop->get("type2").value()) {
+        if (i.type1_ == i.type2_) {
           nb->Generate(beads1, !(imc_->include_intra_));
         } else {
           nb->Generate(beads1, beads2, !(imc_->include_intra_));
@@ -429,7 +443,7 @@ void Imc::Worker::DoNonbonded(Topology *top) {
         nb_force->setCutoff(i.max_ + i.step_);
 
         // is it same types or different types?
-        if (prop->get("type1").value() == prop->get("type2").value()) {
+        if (i.type1_ == i.type2_) {
           nb_force->Generate(beads1);
         } else {
           nb_force->Generate(beads1, beads2);
@@ -453,16 +467,17 @@ void Imc::Worker::DoNonbonded(Topology *top) {
 
 // process non-bonded interactions for current frame
 void Imc::Worker::DoBonded(Topology *top) {
-  for (tools::Property *prop : imc_->bonded_) {
-    string name = prop->get("name").value();
-
-    interaction_t &i = *imc_->interactions_[name];
+  for (auto &interaction : imc_->interactions_) {
+    interaction_t &i = *interaction.second;
+    if (!i.is_bonded_) {
+      continue;
+    }
 
     // clear the current histogram
     current_hists_[i.index_].Clear();
 
     // now fill with new data
-    for (Interaction *ic : top->InteractionsInGroup(name)) {
+    for (Interaction *ic : top->InteractionsInGroup(i.name_)) {
       double v = ic->EvaluateVar(*top);
       current_hists_[i.index_].Process(v);
     }
@@ -549,84 +564,148 @@ void Imc::DoCorrelations(Imc::Worker *worker) {
   }
 }
 
-// write the distribution function
-void Imc::WriteDist(const string &suffix) {
-  map<string, interaction_t *>::iterator iter;
+// normalize the averaged histogram of an interaction
+votca::tools::Table Imc::NormalizeDist(const interaction_t &interaction) const {
+  votca::tools::Table dist(interaction.average_.data());
+  if (!interaction.is_bonded_) {
+    // Quickest way to incorporate 3 body correlations
+    if (interaction.threebody_) {
+      // \TODO normalize bond and angle differently....
+      double norm = dist.y().cwiseAbs().sum();
+      if (norm > 0) {
+        dist.y() = interaction.norm_ * dist.y() / (norm * interaction.step_);
+      }
+    }
 
+    // 2body
+    if (!interaction.threebody_) {
+      // normalization is calculated using exact shell volume (difference of
+      // spheres)
+      for (votca::Index i = 0; i < dist.y().size(); ++i) {
+        double x1 = dist.x()[i] - 0.5 * interaction.step_;
+        double x2 = x1 + interaction.step_;
+        if (x1 < 0) {
+          dist.y()[i] = 0;
+        } else {
+          dist.y()[i] = avg_vol_.getAvg() * interaction.norm_ * dist.y()[i] /
+                        (4. / 3. * M_PI * (x2 * x2 * x2 - x1 * x1 * x1));
+        }
+      }
+    }
+
+  } else {
+    // \TODO normalize bond and angle differently....
+    double norm = dist.y().cwiseAbs().sum();
+    if (norm > 0) {
+      dist.y() = interaction.norm_ * dist.y() / (norm * interaction.step_);
+    }
+  }
+  return dist;
+}
+
+namespace {
+void SaveTable(const votca::tools::Table &table, const string &filename,
+               bool binary) {
+  if (binary) {
+    table.SaveBinary(filename);
+  } else {
+    table.Save(filename);
+  }
+}
+}  // namespace
+
+// write the distribution function
+void Imc::WriteDist(const string &suffix, bool binary) {
   cout << std::endl;  // Cosmetic, put \n before printing names of distribution
                       // files.
   // for all interactions
   for (auto &pair : interactions_) {
     // calculate the rdf
     auto &interaction = pair.second;
-    votca::tools::Table &t = interaction->average_.data();
+    votca::tools::Table dist = NormalizeDist(*interaction);
+    SaveTable(dist, (pair.first) + suffix, binary);
+    cout << "written " << (pair.first) + suffix << "\n";
 
-    // if no average force calculation, dummy table
-    votca::tools::Table force;
-    // if average force calculation, table force contains force data
+    // preliminary
     if (interaction->force_) {
-      force = interaction->average_force_.data();
-    }
-
-    votca::tools::Table dist(t);
-    if (!interaction->is_bonded_) {
-      // Quickest way to incorporate 3 body correlations
-      if (interaction->threebody_) {
-        // \TODO normalize bond and angle differently....
-        double norm = dist.y().cwiseAbs().sum();
-        if (norm > 0) {
-          dist.y() =
-              interaction->norm_ * dist.y() / (norm * interaction->step_);
-        }
-      }
-
-      // 2body
-      if (!interaction->threebody_) {
+      // table force contains force data
+      votca::tools::Table force = interaction->average_force_.data();
+      if (!interaction->is_bonded_ && !interaction->threebody_) {
         // force normalization
         // normalize by number of pairs found at a specific distance
+        const Eigen::VectorXd &pairs = interaction->average_.data().y();
         for (votca::Index i = 0; i < force.y().size(); ++i) {
           // check if any number of pairs has been found at this distance, then
           // normalize
-          if (dist.y()[i] != 0) {
-            force.y()[i] /= dist.y()[i];
+          if (pairs[i] != 0) {
+            force.y()[i] /= pairs[i];
           }
           // else set to zero
           else {
             force.y()[i] = 0;
           }
         }
+      }
+      SaveTable(force, (pair.first) + ".force.new", binary);
+      cout << "written " << (pair.first) + ".force.new"
+           << "\n";
+    }
+  }
+}
 
-        // normalization is calculated using exact shell volume (difference of
-        // spheres)
-        for (votca::Index i = 0; i < dist.y().size(); ++i) {
-          double x1 = dist.x()[i] - 0.5 * interaction->step_;
-          double x2 = x1 + interaction->step_;
-          if (x1 < 0) {
-            dist.y()[i] = 0;
-          } else {
-            dist.y()[i] = avg_vol_.getAvg() * interaction->norm_ * dist.y()[i] /
-                          (4. / 3. * M_PI * (x2 * x2 * x2 - x1 * x1 * x1));
-          }
+void Imc::ProcessBlock() {
+  nblock_++;
+  string suffix = string("_") + boost::lexical_cast<string>(nblock_) +
+                  string(".") + extension_;
+  if (block_output_ == BlockOutput::text) {
+    WriteDist(suffix);
+  }
+  if (block_stats_ || block_output_ == BlockOutput::binary) {
+    for (auto &pair : interactions_) {
+      interaction_t &i = *pair.second;
+      votca::tools::Table dist = NormalizeDist(i);
+      if (block_stats_) {
+        // Welford update, the blocks never have to be stored
+        if (nblock_ == 1) {
+          i.block_mean_ = Eigen::VectorXd::Zero(dist.size());
+          i.block_m2_ = Eigen::VectorXd::Zero(dist.size());
         }
+        Eigen::VectorXd delta = dist.y() - i.block_mean_;
+        i.block_mean_ += delta / (double)nblock_;
+        i.block_m2_ += delta.cwiseProduct(dist.y() - i.block_mean_);
       }
-
-    } else {
-      // \TODO normalize bond and angle differently....
-      double norm = dist.y().cwiseAbs().sum();
-      if (norm > 0) {
-        dist.y() = interaction->norm_ * dist.y() / (norm * interaction->step_);
+      if (block_output_ == BlockOutput::binary) {
+        // same file names as the text blocks, Table::Load reads both
+        dist.SaveBinary(pair.first + suffix);
       }
     }
+  }
+  WriteIMCData(suffix);
+  WriteIMCBlock(suffix);
+  ClearAverages();
+}
 
-    dist.Save((pair.first) + suffix);
-    cout << "written " << (pair.first) + suffix << "\n";
-
-    // preliminary
-    if (interaction->force_) {
-      force.Save((pair.first) + ".force.new");
-      cout << "written " << (pair.first) + ".force.new"
-           << "\n";
-    }
+void Imc::WriteBlockStatistics() {
+  if (nblock_ < 2) {
+    throw runtime_error(
+        "block statistics need at least two blocks, but only " +
+        boost::lexical_cast<string>(nblock_) +
+        " were processed. Decrease the block length.");
+  }
+  cout << std::endl;
+  double n = (double)nblock_;
+  for (auto &pair : interactions_) {
+    interaction_t &i = *pair.second;
+    votca::tools::Table dist(i.average_.data());
+    dist.SetHasYErr(true);
+    dist.yerr().resize(dist.size());
+    dist.y() = i.block_mean_;
+    // standard error of the mean over the blocks
+    dist.yerr() = (i.block_m2_ / (n * (n - 1.0))).cwiseSqrt();
+    string filename = pair.first + "." + extension_;
+    SaveTable(dist, filename, binary_output_);
+    cout << "written " << filename << " (average of " << nblock_
+         << " blocks)\n";
   }
 }
 
@@ -842,10 +921,19 @@ std::unique_ptr<CsgApplication::Worker> Imc::ForkWorker() {
   auto worker = std::make_unique<Imc::Worker>();
   worker->current_hists_.resize(interactions_.size());
   worker->current_hists_force_.resize(interactions_.size());
+  worker->selections_.resize(interactions_.size());
   worker->imc_ = this;
 
   for (auto &interaction : interactions_) {
     auto &i = interaction.second;
+    if (!i->is_bonded_) {
+      std::vector<BeadSelection> &selection = worker->selections_[i->index_];
+      selection.emplace_back(i->type1_);
+      selection.emplace_back(i->type2_);
+      if (i->threebody_) {
+        selection.emplace_back(i->type3_);
+      }
+    }
     worker->current_hists_[i->index_].Initialize(
         i->average_.getMin(), i->average_.getMax(), i->average_.getNBins());
     // preliminary
@@ -889,13 +977,7 @@ void Imc::MergeWorker(CsgApplication::Worker *worker_) {
 
   if (block_length_ != 0) {
     if ((nframes_ % block_length_) == 0) {
-      nblock_++;
-      string suffix = string("_") + boost::lexical_cast<string>(nblock_) +
-                      string(".") + extension_;
-      WriteDist(suffix);
-      WriteIMCData(suffix);
-      WriteIMCBlock(suffix);
-      ClearAverages();
+      ProcessBlock();
     }
   }
 }
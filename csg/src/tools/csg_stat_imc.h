@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -24,6 +24,7 @@
 #include <votca/tools/property.h>
 
 // Local VOTCA includes
+#include "votca/csg/beadselection.h"
 #include "votca/csg/csgapplication.h"
 
 namespace votca {
@@ -38,6 +39,9 @@ namespace csg {
  */
 class Imc {
  public:
+  /// how the distributions of the single blocks are written
+  enum class BlockOutput { text, binary, none };
+
   void Initialize(void);
 
   /// load cg definitions file
@@ -50,6 +54,9 @@ class Imc {
   void EndEvaluate();
 
   void BlockLength(votca::Index length) { block_length_ = length; }
+  void BlockStatistics(bool do_stats) { block_stats_ = do_stats; }
+  void BlockOutputFormat(BlockOutput format) { block_output_ = format; }
+  void BinaryOutput(bool binary) { binary_output_ = binary; }
   void DoImc(bool do_imc) { do_imc_ = do_imc; }
   void IncludeIntra(bool include_intra) { include_intra_ = include_intra; }
   void Extension(std::string ext) { extension_ = ext; }
@@ -64,6 +71,9 @@ class Imc {
   struct interaction_t {
     votca::Index index_;
     tools::Property *p_;
+    std::string name_;
+    // bead selections of the non-bonded interaction
+    std::string type1_, type2_, type3_;
     tools::HistogramNew average_;
     tools::HistogramNew average_force_;
     double min_, max_, step_;
@@ -72,6 +82,10 @@ class Imc {
     bool is_bonded_;
     bool threebody_;
     bool force_;
+    // running mean and sum of squared deviations of the normalized block
+    // distributions
+    Eigen::VectorXd block_mean_;
+    Eigen::VectorXd block_m2_;
   };
 
   // a pair of interactions which are correlated
@@ -95,10 +109,17 @@ class Imc {
   tools::Property options_;
   // length of the block to write out and averages are clear after every write
   votca::Index block_length_ = 0;
+  // accumulate mean and error of the distributions over the blocks
+  bool block_stats_ = false;
+  BlockOutput block_output_ = BlockOutput::text;
+  // write the averaged distributions and forces as binary tables
+  bool binary_output_ = false;
   // calculate the inverse monte carlos parameters (cross correlations)
   bool do_imc_ = false;
   // include the intramolecular neighbors
   bool include_intra_ = false;
+  // use the grid search for neighbors (cg.nbsearch)
+  bool gridsearch_ = true;
 
   // file extension for the distributions
   std::string extension_;
@@ -126,7 +147,15 @@ class Imc {
   /// initializes the group structs after interactions were added
   void InitializeGroups();
 
-  void WriteDist(const std::string &suffix = "");
+  /// normalized distribution of the current averages
+  tools::Table NormalizeDist(const interaction_t &interaction) const;
+
+  /// write the distributions (and forces), optionally as binary tables
+  void WriteDist(const std::string &suffix = "", bool binary = false);
+  /// finish a block: write it out and update the block statistics
+  void ProcessBlock();
+  /// write mean and standard error of the block distributions
+  void WriteBlockStatistics();
   void WriteIMCData(const std::string &suffix = "");
   void WriteIMCBlock(const std::string &suffix);
 
@@ -139,6 +168,8 @@ class Imc {
    public:
     std::vector<tools::HistogramNew> current_hists_;
     std::vector<tools::HistogramNew> current_hists_force_;
+    // compiled selections type1, type2 (and type3) for each interaction
+    std::vector<std::vector<BeadSelection> > selections_;
     Imc *imc_;
     double cur_vol_;
 
@@ -72,8 +72,12 @@ class AkimaSpline : public Spline {
 
   // Calculate the function derivative
   double CalculateDerivative(double r) override;
-  using Spline::Calculate;
-  using Spline::CalculateDerivative;
+
+  // Calculate the function values for all x at once
+  Eigen::VectorXd Calculate(const Eigen::VectorXd &x) override;
+
+  // Calculate the function derivatives for all x at once
+  Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &x) override;
 
  protected:
   // p1,p2,p3,p4 and t1,t2 (same identifiers as in Akima paper, page 591)
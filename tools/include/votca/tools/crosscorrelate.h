@@ -38,8 +38,39 @@ class CrossCorrelate {
   CrossCorrelate() = default;
   ~CrossCorrelate() = default;
 
+  /**
+   * \brief circular autocorrelation of the first series in data
+   *
+   * The series is not padded, so it is treated as periodic.
+   */
   void AutoCorrelate(DataCollection<double>::selection& data);
 
+  /**
+   * \brief linear autocorrelation of every series in data
+   * @param data series to correlate
+   * @param maxlag largest lag to return, -1 for all
+   * @return one correlation function per series, normalized to 1 at lag 0
+   *
+   * The mean is subtracted and the series are zero padded to at least twice
+   * their length, so there is no wrap around as in AutoCorrelate. The
+   * function at lag t is averaged over the N-t overlapping samples. The series
+   * are processed in parallel.
+   */
+  static std::vector<std::vector<double> > LinearAutoCorrelate(
+      const DataCollection<double>::selection& data, Index maxlag = -1);
+
+  /**
+   * \brief integrated correlation time of a normalized autocorrelation
+   * @param corr correlation function, corr[0]=1
+   * @param window summation window in units of the correlation time
+   * @return tau = 1/2 + sum_{t=1}^{W} corr[t], in units of the sampling step
+   *
+   * The window W is chosen self-consistently as the smallest W >= window*tau
+   * (Sokal). The error of the mean of N samples is sigma*sqrt(2*tau/N).
+   */
+  static double IntegratedCorrelationTime(const std::vector<double>& corr,
+                                          double window = 5.0);
+
   std::vector<double>& getData() { return corrfunc_; }
   const std::vector<double>& getData() const { return corrfunc_; }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -50,6 +50,13 @@ class Histogram {
    */
   void ProcessData(DataCollection<double>::selection *data);
 
+  /**
+      generate the histogram from weighted values, e.g. the bin centers and
+      counts of a finer histogram, values with zero weight are ignored
+   */
+  void ProcessWeighted(const std::vector<double> &values,
+                       const std::vector<double> &weights);
+
   /// returns the minimum value
   double getMin() const { return min_; }
   /// return the maximum value
@@ -73,6 +80,10 @@ class Histogram {
   };
 
  private:
+  // for_each(f) calls f(value, weight) for every sample
+  template <class ForEach>
+  void Process(ForEach for_each);
+
   std::vector<double> pdf_;
   double min_ = 0;
   double max_ = 0;
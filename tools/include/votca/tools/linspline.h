@@ -55,8 +55,12 @@ class LinSpline : public Spline {
 
   // Calculate the function derivative
   double CalculateDerivative(double r) override;
-  using Spline::Calculate;
-  using Spline::CalculateDerivative;
+
+  // Calculate the function values for all x at once
+  Eigen::VectorXd Calculate(const Eigen::VectorXd &x) override;
+
+  // Calculate the function derivatives for all x at once
+  Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &x) override;
 
  protected:
   // a,b for piecewise splines: ax+b
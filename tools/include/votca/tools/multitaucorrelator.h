@@ -0,0 +1,83 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_MULTITAUCORRELATOR_H
+#define VOTCA_TOOLS_MULTITAUCORRELATOR_H
+
+// Standard includes
+#include <vector>
+
+// Local VOTCA includes
+#include "table.h"
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief streaming autocorrelation with logarithmically spaced lags
+ *
+ * Multiple-tau correlator (Ramirez et al., J. Chem. Phys. 133, 154103
+ * (2010)). Level 0 correlates the raw samples for the first points lags,
+ * every further level correlates block averages over averaging samples of the
+ * level below, so lags up to points*averaging^(levels-1) are covered with
+ * O(points*levels) memory and work per sample, independent of the length of
+ * the series.
+ */
+class MultiTauCorrelator {
+ public:
+  MultiTauCorrelator(Index points = 16, Index averaging = 2,
+                     Index levels = 20);
+
+  /// \brief add the next sample of the series
+  void Add(double value) { Add(value, 0); }
+
+  /// \brief number of samples added so far
+  Index Samples() const { return nsamples_; }
+
+  /**
+   * \brief current estimate of the autocorrelation
+   * @return x: lag in units of the sampling step, y: <dx(0)dx(t)>/<dx^2>
+   * with dx the deviation from the mean of all samples so far
+   */
+  Table getCorrelation() const;
+
+ private:
+  void Add(double value, Index level);
+
+  Index points_;
+  Index averaging_;
+  Index levels_;
+  Index nsamples_ = 0;
+  double sum_ = 0.0;
+
+  // per level: ring buffer of the last points values, newest at head_
+  std::vector<std::vector<double> > shift_;
+  std::vector<Index> head_;
+  std::vector<Index> inserted_;
+  // per level and lag: summed products and their count
+  std::vector<std::vector<double> > corr_;
+  std::vector<std::vector<Index> > ncorr_;
+  // per level: running block average for the next level
+  std::vector<double> accumulator_;
+  std::vector<Index> naccumulated_;
+};
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_MULTITAUCORRELATOR_H
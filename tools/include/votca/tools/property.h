@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -21,9 +21,11 @@
 // Standard includes
 #include <cstdlib>
 #include <exception>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -53,6 +55,11 @@ namespace tools {
  * The property object can be output to an ostream using format modifiers:
  * cout << XML << property;
  * Supported formats are XML, TXT, HLP
+ *
+ * Copies of a property share the strings of names and paths. Const access
+ * from several threads is safe, but copies must not be accessed through the
+ * non-const name() and path() from different threads at the same time: they
+ * decide from the reference count whether a shared string has to be copied.
  */
 class Property {
 
@@ -63,7 +70,9 @@ class Property {
   Property() = default;
   Property(const std::string &name, const std::string &value,
            const std::string &path)
-      : name_(name), value_(value), path_(path) {}
+      : name_(std::make_shared<std::string>(name)),
+        value_(value),
+        path_(std::make_shared<std::string>(path)) {}
 
   /**
    * \brief add a new property to structure
@@ -157,17 +166,20 @@ class Property {
   /**
    * \brief name of property
    * @return name
+   *
+   * the non-const version copies a shared name first, see the class notes
+   * on threads
    */
-  std::string &name() { return name_; }
-  const std::string &name() const { return name_; }
+  std::string &name() { return Unshare(name_); }
+  const std::string &name() const { return *name_; }
   /**
    * \brief full path of property (including parents)
    * @return path
    *
-   * e.g. cg.inverse.value
+   * e.g. cg.inverse.value, the non-const version copies a shared path first
    */
-  std::string &path() { return path_; }
-  const std::string &path() const { return path_; }
+  std::string &path() { return Unshare(path_); }
+  const std::string &path() const { return *path_; }
   /**
    * \brief return value as type
    *
@@ -267,6 +279,21 @@ class Property {
 
   void LoadFromXML(std::string filename);
 
+  /**
+   * \brief read the records at path from an xml file one by one
+   * @param filename xml file
+   * @param path path of the records, e.g. "jobs.job"
+   * @param callback called with every record once its closing tag is parsed
+   *
+   * In contrast to LoadFromXML only the record currently parsed is kept in
+   * memory, everything outside of the records is skipped. The records have the
+   * same names, paths and content as the ones returned by Select(path) after
+   * LoadFromXML.
+   */
+  static void StreamFromXML(
+      const std::string &filename, const std::string &path,
+      const std::function<void(const Property &)> &callback);
+
   static Index getIOindex() { return IOindex; };
 
  private:
@@ -274,9 +301,24 @@ class Property {
   std::map<std::string, std::string> attributes_;
   std::vector<Property> properties_;
 
-  std::string name_ = "";
+  // names and paths repeat for every record of a file, the nodes read from
+  // one file share them, a node gets its own copy once it changes them.
+  // use_count is not synchronised with other copies, so this is only safe if
+  // copies sharing a string are not changed concurrently
+  using SharedString = std::shared_ptr<std::string>;
+  friend class PropertyStringPool;
+
+  static std::string &Unshare(SharedString &str) {
+    if (str.use_count() > 1) {
+      str = std::make_shared<std::string>(*str);
+    }
+    return *str;
+  }
+  static SharedString EmptyString();
+
+  SharedString name_ = EmptyString();
   std::string value_ = "";
-  std::string path_ = "";
+  SharedString path_ = EmptyString();
 
   static const Index IOindex;
 };
@@ -111,15 +111,18 @@ class Spline {
    * \brief Calculate spline function values for given x values on the spline
    * created by Interpolate() or Fit() \param vector of x data values \return
    * vector of y value
+   *
+   * The spline classes override this with a single loop over x, which avoids
+   * the virtual call per value.
    */
-  Eigen::VectorXd Calculate(const Eigen::VectorXd &x);
+  virtual Eigen::VectorXd Calculate(const Eigen::VectorXd &x);
 
   /**
    * \brief Calculate y values for given x values on the derivative of the
    * spline created by function Interpolate or Fit \param vector of x data
    * values \return vector of y value
    */
-  Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &x);
+  virtual Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &x);
 
   /**
    * \brief Print spline values (using Calculate()) on output "out" on the
@@ -132,8 +135,11 @@ class Spline {
    * \brief Determine the index of the interval containing value r
    * \param value r
    * \return interval index
+   *
+   * On uniform grids, e.g. from GenerateGrid(), the interval is computed
+   * directly, otherwise it is found by bisection.
    */
-  Index getInterval(double r);
+  Index getInterval(double r) const;
 
   /**
    * \brief Generate the grid for fitting from "min" to "max" in steps of "h"
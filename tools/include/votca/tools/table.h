@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -75,8 +75,13 @@ class Table {
     comment_line_ = comment;
   }
 
+  /// reads a text table or a binary table written by SaveBinary
   void Load(std::string filename);
   void Save(std::string filename) const;
+  /// writes grid, values, errors, flags and comment in native byte order
+  void SaveBinary(const std::string &filename) const;
+  /// true if the file starts with the magic of the binary table format
+  static bool IsBinary(const std::string &filename);
 
   void Smooth(Index Nsmooth);
 
@@ -129,6 +134,8 @@ class Table {
   friend std::istream &operator>>(std::istream &in, Table &t);
 
   std::string comment_line_;
+
+  void LoadBinary(const std::string &filename);
 };
 
 }  // namespace tools
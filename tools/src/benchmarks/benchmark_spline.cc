@@ -0,0 +1,135 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+// Local VOTCA includes
+#include "votca/tools/akimaspline.h"
+#include "votca/tools/cubicspline.h"
+#include "votca/tools/linspline.h"
+
+using namespace votca;
+using namespace votca::tools;
+
+namespace {
+
+// returns the best time in seconds of all repetitions, the sum of the results
+// is accumulated in checksum, so the compiler cannot drop the payload
+template <class T>
+double Time(T &&payload, Index repetitions, double &checksum) {
+  double best = std::numeric_limits<double>::max();
+  for (Index i = 0; i < repetitions; i++) {
+    std::chrono::time_point<std::chrono::steady_clock> start =
+        std::chrono::steady_clock::now();
+    checksum += payload();
+    std::chrono::time_point<std::chrono::steady_clock> end =
+        std::chrono::steady_clock::now();
+    best = std::min(
+        best,
+        std::chrono::duration_cast<std::chrono::duration<double> >(end - start)
+            .count());
+  }
+  return best;
+}
+
+// compares scalar and batch evaluation of one spline, returns false if both
+// disagree
+bool Run(Spline &spline, const std::string &name, const Eigen::VectorXd &x,
+         Index repetitions) {
+  double checksum_scalar = 0.0;
+  double t_scalar = Time(
+      [&]() {
+        double sum = 0.0;
+        for (Index i = 0; i < x.size(); i++) {
+          sum += spline.Calculate(x(i));
+        }
+        return sum;
+      },
+      repetitions, checksum_scalar);
+
+  double checksum_batch = 0.0;
+  double t_batch =
+      Time([&]() { return spline.Calculate(x).sum(); }, repetitions,
+           checksum_batch);
+
+  double checksum_deriv = 0.0;
+  double t_deriv =
+      Time([&]() { return spline.CalculateDerivative(x).sum(); }, repetitions,
+           checksum_deriv);
+
+  double ns = 1e9 / double(x.size());
+  std::cout << std::setw(8) << name << std::fixed << std::setprecision(2)
+            << std::setw(12) << t_scalar * ns << std::setw(12) << t_batch * ns
+            << std::setw(12) << t_deriv * ns << std::setw(10)
+            << t_scalar / t_batch << std::endl;
+
+  double tolerance = 1e-8 * (std::abs(checksum_scalar) + 1.0);
+  if (std::abs(checksum_scalar - checksum_batch) > tolerance) {
+    std::cerr << name << ": scalar and batch evaluation differ "
+              << checksum_scalar << " vs " << checksum_batch << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+
+  bool quick = (argc > 1 && std::string(argv[1]) == "--quick");
+  Index gridpoints = 200;
+  Index points = quick ? 10000 : 1000000;
+  Index repetitions = quick ? 2 : 20;
+
+  double min = 0.0;
+  double max = 1.5;
+  Eigen::VectorXd grid = Eigen::VectorXd::LinSpaced(gridpoints, min, max);
+  Eigen::VectorXd values = grid.array().sin() * (-grid.array()).exp();
+
+  // evaluation points are scattered over the grid (and a bit outside of it),
+  // like pair distances in a trajectory
+  Eigen::VectorXd x = Eigen::VectorXd::Random(points);
+  x = (x.array() + 1.0) * 0.55 * (max - min) + min - 0.05;
+
+  CubicSpline cubic;
+  cubic.setBCInt(0);
+  cubic.Interpolate(grid, values);
+  LinSpline linear;
+  linear.Interpolate(grid, values);
+  AkimaSpline akima;
+  akima.Interpolate(grid, values);
+
+  std::cout << "spline evaluation, " << gridpoints << " grid points, "
+            << points << " evaluations, best of " << repetitions << " runs"
+            << std::endl;
+  std::cout << std::setw(8) << "spline" << std::setw(12) << "scalar[ns]"
+            << std::setw(12) << "batch[ns]" << std::setw(12) << "deriv[ns]"
+            << std::setw(10) << "speedup" << std::endl;
+
+  bool ok = true;
+  ok = Run(cubic, "cubic", x, repetitions) && ok;
+  ok = Run(linear, "linear", x, repetitions) && ok;
+  ok = Run(akima, "akima", x, repetitions) && ok;
+  return ok ? 0 : 1;
+}
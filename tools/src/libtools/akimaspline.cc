@@ -171,6 +171,26 @@ double AkimaSpline::CalculateDerivative(double r) {
   return +p1(interval) + 2.0 * p2(interval) * z + 3.0 * p3(interval) * z * z;
 }
 
+Eigen::VectorXd AkimaSpline::Calculate(const Eigen::VectorXd &x) {
+  Eigen::VectorXd y(x.size());
+  for (Index k = 0; k < x.size(); ++k) {
+    Index i = getInterval(x(k));
+    double z = x(k) - r_[i];
+    y(k) = p0(i) + z * (p1(i) + z * (p2(i) + z * p3(i)));
+  }
+  return y;
+}
+
+Eigen::VectorXd AkimaSpline::CalculateDerivative(const Eigen::VectorXd &x) {
+  Eigen::VectorXd y(x.size());
+  for (Index k = 0; k < x.size(); ++k) {
+    Index i = getInterval(x(k));
+    double z = x(k) - r_[i];
+    y(k) = p1(i) + z * (2.0 * p2(i) + 3.0 * z * p3(i));
+  }
+  return y;
+}
+
 double AkimaSpline::getSlope(double m1, double m2, double m3, double m4) {
   if (isApproximatelyEqual(m1, m2, 1E-15) &&
       isApproximatelyEqual(m3, m4, 1E-15)) {
@@ -15,6 +15,9 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+
 // Local VOTCA includes
 #include "votca/tools/crosscorrelate.h"
 
@@ -35,5 +38,61 @@ void CrossCorrelate::AutoCorrelate(DataCollection<double>::selection& data) {
   corr_map.array() /= d;
 }
 
+std::vector<std::vector<double> > CrossCorrelate::LinearAutoCorrelate(
+    const DataCollection<double>::selection& data, Index maxlag) {
+  std::vector<std::vector<double> > result(data.size());
+  Index nseries = Index(data.size());
+
+#pragma omp parallel
+  {
+    // every thread needs its own fft object, they cache their plans
+    Eigen::FFT<double> fft;
+#pragma omp for schedule(dynamic)
+    for (Index s = 0; s < nseries; s++) {
+      const std::vector<double>& series = data[s];
+      Index N = Index(series.size());
+      if (N == 0) {
+        continue;
+      }
+      Index nlags = (maxlag < 0) ? N : std::min(maxlag + 1, N);
+
+      // pad to a power of two >= 2N, which is the fast case for the fft
+      Index padded = 1;
+      while (padded < 2 * N) {
+        padded *= 2;
+      }
+      Eigen::Map<const Eigen::VectorXd> input(series.data(), N);
+      Eigen::VectorXd x = Eigen::VectorXd::Zero(padded);
+      x.head(N) = input.array() - input.mean();
+
+      Eigen::VectorXcd frequency = fft.fwd(x);
+      Eigen::VectorXcd magnitude = frequency.cwiseAbs2();
+      Eigen::VectorXd corr = fft.inv(magnitude);
+
+      std::vector<double>& out = result[s];
+      out.resize(nlags);
+      // unbiased estimate, lag t has N-t overlapping samples
+      double c0 = corr(0) / double(N);
+      for (Index t = 0; t < nlags; t++) {
+        out[t] = corr(t) / double(N - t);
+        out[t] = (c0 != 0.0) ? out[t] / c0 : 0.0;
+      }
+    }
+  }
+  return result;
+}
+
+double CrossCorrelate::IntegratedCorrelationTime(
+    const std::vector<double>& corr, double window) {
+  double tau = 0.5;
+  for (Index t = 1; t < Index(corr.size()); t++) {
+    tau += corr[t];
+    if (double(t) >= window * tau) {
+      break;
+    }
+  }
+  return tau;
+}
+
 }  // namespace tools
 }  // namespace votca
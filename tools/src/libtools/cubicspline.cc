@@ -128,61 +128,91 @@ void CubicSpline::Fit(const Eigen::VectorXd &x, const Eigen::VectorXd &y) {
 
 double CubicSpline::Calculate(double r) {
   Index interval = getInterval(r);
-  return A(r) * f_[interval] + B(r) * f_[interval + 1] + C(r) * f2_[interval] +
-         D(r) * f2_[interval + 1];
+  return A(r, interval) * f_[interval] + B(r, interval) * f_[interval + 1] +
+         C(r, interval) * f2_[interval] + D(r, interval) * f2_[interval + 1];
 }
 
 double CubicSpline::CalculateDerivative(double r) {
   Index interval = getInterval(r);
-  return Aprime(r) * f_[interval] + Bprime(r) * f_[interval + 1] +
-         Cprime(r) * f2_[interval] + Dprime(r) * f2_[interval + 1];
+  return Aprime(r, interval) * f_[interval] +
+         Bprime(r, interval) * f_[interval + 1] +
+         Cprime(r, interval) * f2_[interval] +
+         Dprime(r, interval) * f2_[interval + 1];
+}
+
+Eigen::VectorXd CubicSpline::Calculate(const Eigen::VectorXd &x) {
+  Eigen::VectorXd y(x.size());
+  for (Index k = 0; k < x.size(); ++k) {
+    Index i = getInterval(x(k));
+    double xxi = x(k) - r_[i];
+    double h = r_[i + 1] - r_[i];
+    double b = xxi / h;
+    double xxi3_h = xxi * xxi * b;
+    y(k) = (1.0 - b) * f_[i] + b * f_[i + 1] +
+           (0.5 * xxi * xxi - (1.0 / 6.0) * xxi3_h - (1.0 / 3.0) * xxi * h) *
+               f2_[i] +
+           ((1.0 / 6.0) * xxi3_h - (1.0 / 6.0) * xxi * h) * f2_[i + 1];
+  }
+  return y;
+}
+
+Eigen::VectorXd CubicSpline::CalculateDerivative(const Eigen::VectorXd &x) {
+  Eigen::VectorXd y(x.size());
+  for (Index k = 0; k < x.size(); ++k) {
+    Index i = getInterval(x(k));
+    double xxi = x(k) - r_[i];
+    double h = r_[i + 1] - r_[i];
+    double xxi2_h = xxi * xxi / h;
+    y(k) = (f_[i + 1] - f_[i]) / h +
+           (xxi - 0.5 * xxi2_h - h / 3.0) * f2_[i] +
+           (0.5 * xxi2_h - (1.0 / 6.0) * h) * f2_[i + 1];
+  }
+  return y;
 }
 
-double CubicSpline::A(double r) {
-  return (1.0 - (r - r_[getInterval(r)]) /
-                    (r_[getInterval(r) + 1] - r_[getInterval(r)]));
+double CubicSpline::A(double r, Index i) const {
+  return (1.0 - (r - r_[i]) / (r_[i + 1] - r_[i]));
 }
 
-double CubicSpline::Aprime(double r) {
-  return -1.0 / (r_[getInterval(r) + 1] - r_[getInterval(r)]);
+double CubicSpline::Aprime(double, Index i) const {
+  return -1.0 / (r_[i + 1] - r_[i]);
 }
 
-double CubicSpline::B(double r) {
-  return (r - r_[getInterval(r)]) /
-         (r_[getInterval(r) + 1] - r_[getInterval(r)]);
+double CubicSpline::B(double r, Index i) const {
+  return (r - r_[i]) / (r_[i + 1] - r_[i]);
 }
 
-double CubicSpline::Bprime(double r) {
-  return 1.0 / (r_[getInterval(r) + 1] - r_[getInterval(r)]);
+double CubicSpline::Bprime(double, Index i) const {
+  return 1.0 / (r_[i + 1] - r_[i]);
 }
 
-double CubicSpline::C(double r) {
+double CubicSpline::C(double r, Index i) const {
 
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
+  double xxi = r - r_[i];
+  double h = r_[i + 1] - r_[i];
 
   return (0.5 * xxi * xxi - (1.0 / 6.0) * xxi * xxi * xxi / h -
           (1.0 / 3.0) * xxi * h);
 }
 
-double CubicSpline::Cprime(double r) {
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
+double CubicSpline::Cprime(double r, Index i) const {
+  double xxi = r - r_[i];
+  double h = r_[i + 1] - r_[i];
 
   return (xxi - 0.5 * xxi * xxi / h - h / 3);
 }
 
-double CubicSpline::D(double r) {
+double CubicSpline::D(double r, Index i) const {
 
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
+  double xxi = r - r_[i];
+  double h = r_[i + 1] - r_[i];
 
   return ((1.0 / 6.0) * xxi * xxi * xxi / h - (1.0 / 6.0) * xxi * h);
 }
 
-double CubicSpline::Dprime(double r) {
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
+double CubicSpline::Dprime(double r, Index i) const {
+  double xxi = r - r_[i];
+  double h = r_[i + 1] - r_[i];
 
   return (0.5 * xxi * xxi / h - (1.0 / 6.0) * h);
 }
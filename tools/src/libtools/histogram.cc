@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 #include <functional>
 #include <limits>
 #include <numeric>
+#include <stdexcept>
 
 // Local VOTCA includes
 #include "votca/tools/histogram.h"
@@ -33,7 +34,8 @@ Histogram::Histogram(const options_t& op) : options_(op) {}
 
 Histogram::~Histogram() = default;
 
-void Histogram::ProcessData(DataCollection<double>::selection* data) {
+template <class ForEach>
+void Histogram::Process(ForEach for_each) {
 
   pdf_.assign(options_.n_, 0);
 
@@ -45,37 +47,32 @@ void Histogram::ProcessData(DataCollection<double>::selection* data) {
     min_ = options_.min_;
     max_ = options_.max_;
   }
-  for (auto& array : *data) {
-    if (options_.extend_interval_ || options_.auto_interval_) {
-      for (auto& value : *array) {
-        min_ = std::min(value, min_);
-        max_ = std::max(value, max_);
-      }
-    }
+  if (options_.extend_interval_ || options_.auto_interval_) {
+    for_each([this](double value, double) {
+      min_ = std::min(value, min_);
+      max_ = std::max(value, max_);
+    });
   }
 
   interval_ = (max_ - min_) / (double)(options_.n_ - 1);
 
-  double v = 1.;
-  for (auto& array : *data) {
-    for (auto& value : *array) {
-      Index ii = (Index)floor((value - min_) / interval_ +
-                              0.5);  // the interval should
-                                     // be centered around
-                                     // the sampling point
-      if (ii < 0 || ii >= options_.n_) {
-        if (options_.periodic_) {
-          while (ii < 0) {
-            ii += options_.n_;
-          }
-          ii = ii % options_.n_;
-        } else {
-          continue;
+  for_each([this](double value, double weight) {
+    Index ii = (Index)floor((value - min_) / interval_ +
+                            0.5);  // the interval should
+                                   // be centered around
+                                   // the sampling point
+    if (ii < 0 || ii >= options_.n_) {
+      if (options_.periodic_) {
+        while (ii < 0) {
+          ii += options_.n_;
         }
+        ii = ii % options_.n_;
+      } else {
+        return;
       }
-      pdf_[ii] += v;
     }
-  }
+    pdf_[ii] += weight;
+  });
 
   if (options_.scale_ == "bond") {
     for (size_t i = 0; i < pdf_.size(); ++i) {
@@ -113,6 +110,30 @@ void Histogram::ProcessData(DataCollection<double>::selection* data) {
   }
 }
 
+void Histogram::ProcessData(DataCollection<double>::selection* data) {
+  Process([data](const auto& f) {
+    for (auto& array : *data) {
+      for (auto& value : *array) {
+        f(value, 1.0);
+      }
+    }
+  });
+}
+
+void Histogram::ProcessWeighted(const std::vector<double>& values,
+                                const std::vector<double>& weights) {
+  if (values.size() != weights.size()) {
+    throw std::runtime_error("Histogram: number of values and weights differ");
+  }
+  Process([&values, &weights](const auto& f) {
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (weights[i] != 0.0) {
+        f(values[i], weights[i]);
+      }
+    }
+  });
+}
+
 void Histogram::Normalize() {
   double norm = 1. / (interval_ * accumulate(pdf_.begin(), pdf_.end(), 0.0));
   std::transform(pdf_.begin(), pdf_.end(), pdf_.begin(),
@@ -37,6 +37,23 @@ double LinSpline::CalculateDerivative(double r) {
   return a(interval);
 }
 
+Eigen::VectorXd LinSpline::Calculate(const Eigen::VectorXd &x) {
+  Eigen::VectorXd y(x.size());
+  for (Index k = 0; k < x.size(); ++k) {
+    Index i = getInterval(x(k));
+    y(k) = a(i) * x(k) + b(i);
+  }
+  return y;
+}
+
+Eigen::VectorXd LinSpline::CalculateDerivative(const Eigen::VectorXd &x) {
+  Eigen::VectorXd y(x.size());
+  for (Index k = 0; k < x.size(); ++k) {
+    y(k) = a(getInterval(x(k)));
+  }
+  return y;
+}
+
 void LinSpline::Interpolate(const Eigen::VectorXd &x,
                             const Eigen::VectorXd &y) {
   if (x.size() != y.size()) {
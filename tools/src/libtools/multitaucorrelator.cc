@@ -0,0 +1,96 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <stdexcept>
+
+// Local VOTCA includes
+#include "votca/tools/multitaucorrelator.h"
+
+namespace votca {
+namespace tools {
+
+MultiTauCorrelator::MultiTauCorrelator(Index points, Index averaging,
+                                       Index levels)
+    : points_(points), averaging_(averaging), levels_(levels) {
+  if (points < 2 || averaging < 2 || levels < 1 || points % averaging != 0) {
+    throw std::invalid_argument(
+        "MultiTauCorrelator: points and averaging have to be >=2, points a "
+        "multiple of averaging and levels >=1");
+  }
+  shift_.assign(levels_, std::vector<double>(points_, 0.0));
+  head_.assign(levels_, 0);
+  inserted_.assign(levels_, 0);
+  corr_.assign(levels_, std::vector<double>(points_, 0.0));
+  ncorr_.assign(levels_, std::vector<Index>(points_, 0));
+  accumulator_.assign(levels_, 0.0);
+  naccumulated_.assign(levels_, 0);
+}
+
+void MultiTauCorrelator::Add(double value, Index level) {
+  if (level == 0) {
+    nsamples_++;
+    sum_ += value;
+  }
+  std::vector<double>& shift = shift_[level];
+  head_[level] = (head_[level] + points_ - 1) % points_;
+  shift[head_[level]] = value;
+  inserted_[level]++;
+
+  // lags below points/averaging are already covered by the level below
+  Index first = (level == 0) ? 0 : points_ / averaging_;
+  Index last = std::min(inserted_[level], points_);
+  for (Index j = first; j < last; j++) {
+    corr_[level][j] += value * shift[(head_[level] + j) % points_];
+    ncorr_[level][j]++;
+  }
+
+  accumulator_[level] += value;
+  naccumulated_[level]++;
+  if (naccumulated_[level] == averaging_) {
+    if (level + 1 < levels_) {
+      Add(accumulator_[level] / double(averaging_), level + 1);
+    }
+    accumulator_[level] = 0.0;
+    naccumulated_[level] = 0;
+  }
+}
+
+Table MultiTauCorrelator::getCorrelation() const {
+  Table result;
+  if (nsamples_ == 0) {
+    return result;
+  }
+  double mean = sum_ / double(nsamples_);
+  double c0 = corr_[0][0] / double(ncorr_[0][0]) - mean * mean;
+  Index stride = 1;
+  for (Index level = 0; level < levels_; level++) {
+    Index first = (level == 0) ? 0 : points_ / averaging_;
+    for (Index j = first; j < points_; j++) {
+      if (ncorr_[level][j] > 0) {
+        double c = corr_[level][j] / double(ncorr_[level][j]) - mean * mean;
+        result.push_back(double(j * stride), (c0 != 0.0) ? c / c0 : 0.0);
+      }
+    }
+    stride *= averaging_;
+  }
+  return result;
+}
+
+}  // namespace tools
+}  // namespace votca
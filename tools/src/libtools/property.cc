@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -22,9 +22,12 @@
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <stack>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 // Third party includes
 #include <boost/algorithm/string.hpp>
@@ -45,6 +48,29 @@ using namespace std;
 // ostream modifier defines the output format, level, indentation
 const Index Property::IOindex = std::ios_base::xalloc();
 
+Property::SharedString Property::EmptyString() {
+  // never changed, Unshare copies it before
+  static const SharedString empty = std::make_shared<std::string>();
+  return empty;
+}
+
+// names and paths of the nodes read from one xml file, it only lives as long
+// as the parser and the strings are freed with the last node using them
+class PropertyStringPool {
+ public:
+  void Share(Property &prop) {
+    prop.name_ = Lookup(prop.name_);
+    prop.path_ = Lookup(prop.path_);
+  }
+
+ private:
+  Property::SharedString Lookup(const Property::SharedString &str) {
+    auto result = pool_.emplace(*str, str);
+    return result.first->second;
+  }
+  std::unordered_map<std::string, Property::SharedString> pool_;
+};
+
 const Property &Property::get(const string &key) const {
   Tokenizer tok(key, ".");
   Tokenizer::iterator n = tok.begin();
@@ -106,11 +132,11 @@ Property &Property::addTree(const std::vector<std::string> &key,
 }
 
 Property &Property::add(const std::string &key, const std::string &value) {
-  std::string path = path_;
+  std::string path = *path_;
   if (path != "") {
     path = path + ".";
   }
-  properties_.push_back(Property(key, value, path + name_));
+  properties_.push_back(Property(key, value, path + *name_));
   map_[key].push_back(Index(properties_.size()) - 1);
   return properties_.back();
 }
@@ -133,7 +159,8 @@ void FixPath(tools::Property &prop, std::string path) {
   if (path != "") {
     path += ".";
   }
-  path += prop.name();
+  // the const accessor keeps the name shared
+  path += std::as_const(prop).name();
   for (tools::Property &child : prop) {
     FixPath(child, path);
   }
@@ -144,11 +171,11 @@ Property &Property::add(const Property &other) {
   properties_.push_back(other);
   map_[other.name()].push_back((properties_.size()) - 1);
 
-  std::string path = path_;
+  std::string path = *path_;
   if (path != "") {
     path += ".";
   }
-  path += name_;
+  path += *name_;
   FixPath(properties_.back(), path);
   return properties_.back();
 }
@@ -193,7 +220,7 @@ std::vector<Property *> Property::Select(const string &filter) {
     std::vector<Property *> selected;
     for (Property *p : selection) {
       for (Property &child : *p) {
-        if (wildcmp(n, child.name())) {
+        if (wildcmp(n, std::as_const(child).name())) {
           selected.push_back(&child);
         }
       }
@@ -207,35 +234,47 @@ void Property::deleteAttribute(const std::string &attribute) {
   attributes_.erase(attribute);
 }
 
-static void start_hndl(void *data, const char *el, const char **attr) {
-  stack<Property *> *property_stack =
-      (stack<Property *> *)XML_GetUserData((XML_Parser *)data);
+namespace {
+// the nodes currently open while a tree is read from xml
+struct XMLTree {
+  stack<Property *> pstack;
+  PropertyStringPool pool;
+};
+}  // namespace
 
-  Property *cur = property_stack->top();
+static void AddElement(XMLTree *tree, const char *el, const char **attr) {
+  Property *cur = tree->pstack.top();
   Property &np = cur->add(el, "");
+  tree->pool.Share(np);
 
   for (Index i = 0; attr[i]; i += 2) {
     np.setAttribute(attr[i], attr[i + 1]);
   }
 
-  property_stack->push(&np);
+  tree->pstack.push(&np);
+}
+
+static void start_hndl(void *data, const char *el, const char **attr) {
+  XMLTree *tree = (XMLTree *)XML_GetUserData((XML_Parser *)data);
+  AddElement(tree, el, attr);
 }
 
 static void end_hndl(void *data, const char *) {
-  stack<Property *> *property_stack =
-      (stack<Property *> *)XML_GetUserData((XML_Parser *)data);
-  property_stack->pop();
+  XMLTree *tree = (XMLTree *)XML_GetUserData((XML_Parser *)data);
+  tree->pstack.pop();
 }
 
 void char_hndl(void *data, const char *txt, int txtlen) {
-  stack<Property *> *property_stack =
-      (stack<Property *> *)XML_GetUserData((XML_Parser *)data);
+  XMLTree *tree = (XMLTree *)XML_GetUserData((XML_Parser *)data);
 
-  Property *cur = property_stack->top();
+  Property *cur = tree->pstack.top();
   cur->value().append(txt, txtlen);
 }
 
-void Property::LoadFromXML(string filename) {
+// runs expat over filename, the handlers get the parser as first argument
+static void ParseXML(const string &filename, XML_StartElementHandler start,
+                     XML_EndElementHandler end, XML_CharacterDataHandler chars,
+                     void *userdata) {
   ifstream fl;
   fl.open(filename);
   if (!fl.is_open()) {
@@ -248,31 +287,134 @@ void Property::LoadFromXML(string filename) {
   }
 
   XML_UseParserAsHandlerArg(parser);
-  XML_SetElementHandler(parser, start_hndl, end_hndl);
-  XML_SetCharacterDataHandler(parser, char_hndl);
-
-  stack<Property *> pstack;
-  pstack.push(this);
+  XML_SetElementHandler(parser, start, end);
+  XML_SetCharacterDataHandler(parser, chars);
+  XML_SetUserData(parser, userdata);
 
-  XML_SetUserData(parser, (void *)&pstack);
   while (!fl.eof()) {
     string line;
     tools::getline(fl, line);
     line = line + "\n";
     if (line.length() > (size_t)std::numeric_limits<int>::max()) {
+      XML_ParserFree(parser);
       throw std::runtime_error("Property::LoadFromXML: line is too long");
     }
     if (!XML_Parse(parser, line.c_str(), (int)line.length(), fl.eof())) {
-      throw std::ios_base::failure(
+      if (XML_GetErrorCode(parser) == XML_ERROR_ABORTED) {
+        // stopped by a handler, which reports the reason itself
+        break;
+      }
+      std::string error =
           filename + ": Parse error at line " +
           boost::lexical_cast<string>(XML_GetCurrentLineNumber(parser)) + "\n" +
-          XML_ErrorString(XML_GetErrorCode(parser)));
+          XML_ErrorString(XML_GetErrorCode(parser));
+      XML_ParserFree(parser);
+      throw std::ios_base::failure(error);
     }
   }
   fl.close();
   XML_ParserFree(parser);
 }
 
+void Property::LoadFromXML(string filename) {
+  XMLTree tree;
+  tree.pstack.push(this);
+  ParseXML(filename, start_hndl, end_hndl, char_hndl, (void *)&tree);
+}
+
+namespace {
+// state of StreamFromXML, elements outside of the records are only tracked
+// by name, the current record is built like in LoadFromXML
+struct XMLRecordStream {
+  std::vector<std::string> record_path;
+  std::vector<std::string> open_elements;
+  std::unique_ptr<Property> record;
+  XMLTree tree;
+  const std::function<void(const Property &)> *callback;
+  std::exception_ptr error;
+};
+
+std::string JoinPath(const std::vector<std::string> &names, std::size_t n) {
+  std::string path;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i > 0) {
+      path += ".";
+    }
+    path += names[i];
+  }
+  return path;
+}
+
+void stream_start_hndl(void *data, const char *el, const char **attr) {
+  XMLRecordStream *stream =
+      (XMLRecordStream *)XML_GetUserData((XML_Parser *)data);
+  try {
+    if (stream->record) {
+      AddElement(&stream->tree, el, attr);
+      return;
+    }
+    stream->open_elements.push_back(el);
+    if (stream->open_elements == stream->record_path) {
+      stream->record = std::make_unique<Property>(
+          el, "",
+          JoinPath(stream->open_elements, stream->open_elements.size() - 1));
+      stream->tree.pool.Share(*stream->record);
+      for (Index i = 0; attr[i]; i += 2) {
+        stream->record->setAttribute(attr[i], attr[i + 1]);
+      }
+      stream->tree.pstack.push(stream->record.get());
+    }
+  } catch (...) {
+    stream->error = std::current_exception();
+    XML_StopParser((XML_Parser)data, XML_FALSE);
+  }
+}
+
+void stream_end_hndl(void *data, const char *) {
+  XMLRecordStream *stream =
+      (XMLRecordStream *)XML_GetUserData((XML_Parser *)data);
+  try {
+    if (!stream->record) {
+      stream->open_elements.pop_back();
+      return;
+    }
+    stream->tree.pstack.pop();
+    if (stream->tree.pstack.empty()) {
+      std::unique_ptr<Property> record = std::move(stream->record);
+      stream->open_elements.pop_back();
+      (*stream->callback)(*record);
+    }
+  } catch (...) {
+    stream->error = std::current_exception();
+    XML_StopParser((XML_Parser)data, XML_FALSE);
+  }
+}
+
+void stream_char_hndl(void *data, const char *txt, int txtlen) {
+  XMLRecordStream *stream =
+      (XMLRecordStream *)XML_GetUserData((XML_Parser *)data);
+  if (stream->record) {
+    stream->tree.pstack.top()->value().append(txt, txtlen);
+  }
+}
+}  // namespace
+
+void Property::StreamFromXML(
+    const std::string &filename, const std::string &path,
+    const std::function<void(const Property &)> &callback) {
+  XMLRecordStream stream;
+  stream.record_path = Tokenizer(path, ".").ToVector();
+  if (stream.record_path.empty()) {
+    throw std::runtime_error("Property::StreamFromXML: empty record path");
+  }
+  stream.callback = &callback;
+  ParseXML(filename, stream_start_hndl, stream_end_hndl, stream_char_hndl,
+           (void *)&stream);
+  if (stream.error) {
+    std::rethrow_exception(stream.error);
+  }
+}
+
 void PrintNodeTXT(std::ostream &out, const Property &p, const Index start_level,
                   Index level = 0, string prefix = "", string offset = "") {
   if ((p.value() != "") || p.HasChildren()) {
@@ -15,6 +15,9 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+
 // Local VOTCA includes
 #include "votca/tools/spline.h"
 
@@ -59,20 +62,21 @@ void Spline::Print(std::ostream &out, double interval) {
   }
 }
 
-Index Spline::getInterval(double r) {
-  if (r < r_[0]) {
+Index Spline::getInterval(double r) const {
+  const Index n = r_.size();
+  if (!(r >= r_[0])) {
     return 0;
   }
-  if (r > r_[r_.size() - 2]) {
-    return r_.size() - 2;
+  if (r > r_[n - 2]) {
+    return n - 2;
   }
-  Index i;
-  for (i = 0; i < r_.size(); ++i) {
-    if (r_[i] > r) {
-      break;
-    }
+  // guess assuming a uniform grid, only accept it if r is really inside
+  double h = (r_[n - 1] - r_[0]) / double(n - 1);
+  Index i = std::min(Index((r - r_[0]) / h), n - 2);
+  if (r_[i] <= r && r < r_[i + 1]) {
+    return i;
   }
-  return i - 1;
+  return Index(std::upper_bound(r_.data(), r_.data() + n, r) - r_.data()) - 1;
 }
 
 double Spline::getGridPoint(int i) {
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,6 +16,8 @@
  */
 
 // Standard includes
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
 #include <vector>
@@ -45,6 +47,11 @@ void Table::resize(Index N) {
 }
 
 void Table::Load(string filename) {
+  if (IsBinary(filename)) {
+    LoadBinary(filename);
+    return;
+  }
+
   ifstream in;
   in.open(filename);
   if (!in) {
@@ -74,6 +81,131 @@ void Table::Save(string filename) const {
   out.close();
 }
 
+/*
+ * Layout of the binary file, all integers are int64 in native byte order:
+ *   magic (8 bytes), comment length (-1 if none), comment,
+ *   has_yerr, number of points N,
+ *   x[N], y[N], yerr[N] (if has_yerr), flags[N] (chars)
+ */
+namespace {
+
+const char binary_magic[8] = {'V', 'O', 'T', 'C', 'A', 'T', 'B', '1'};
+
+void AppendInt(string &buffer, std::int64_t value) {
+  buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void AppendVector(string &buffer, const Eigen::VectorXd &v) {
+  buffer.append(reinterpret_cast<const char *>(v.data()),
+                sizeof(double) * std::size_t(v.size()));
+}
+
+// bounds checked cursor over the file content, the data is copied with
+// memcpy because the doubles in the file are not aligned
+class BinaryReader {
+ public:
+  BinaryReader(const string &data, const string &filename)
+      : data_(data), filename_(filename) {}
+
+  void Read(void *dest, std::size_t bytes) {
+    if (bytes > data_.size() - pos_) {
+      throw runtime_error("error, binary table file " + filename_ +
+                          " is truncated");
+    }
+    std::memcpy(dest, data_.data() + pos_, bytes);
+    pos_ += bytes;
+  }
+
+  std::int64_t ReadInt() {
+    std::int64_t value;
+    Read(&value, sizeof(value));
+    return value;
+  }
+
+  bool AtEnd() const { return pos_ == data_.size(); }
+
+ private:
+  const string &data_;
+  const string &filename_;
+  std::size_t pos_ = 0;
+};
+
+}  // namespace
+
+bool Table::IsBinary(const string &filename) {
+  ifstream in(filename, ios::binary);
+  char head[sizeof(binary_magic)];
+  if (!in.read(head, sizeof(head))) {
+    return false;
+  }
+  return std::memcmp(head, binary_magic, sizeof(binary_magic)) == 0;
+}
+
+void Table::LoadBinary(const string &filename) {
+  ifstream in(filename, ios::binary);
+  if (!in) {
+    throw runtime_error("error, cannot open file " + filename);
+  }
+  string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+  BinaryReader reader(data, filename);
+  char head[sizeof(binary_magic)];
+  reader.Read(head, sizeof(head));
+
+  std::int64_t comment_length = reader.ReadInt();
+  has_comment_ = comment_length >= 0;
+  comment_line_.clear();
+  if (has_comment_) {
+    comment_line_.resize(std::size_t(comment_length));
+    reader.Read(&comment_line_[0], std::size_t(comment_length));
+  }
+  has_yerr_ = reader.ReadInt() != 0;
+  std::int64_t N = reader.ReadInt();
+  if (N < 0) {
+    throw runtime_error("error, binary table file " + filename +
+                        " is corrupt");
+  }
+  resize(N);
+  std::size_t bytes = sizeof(double) * std::size_t(N);
+  reader.Read(x_.data(), bytes);
+  reader.Read(y_.data(), bytes);
+  if (has_yerr_) {
+    reader.Read(yerr_.data(), bytes);
+  }
+  reader.Read(flags_.data(), std::size_t(N));
+  if (!reader.AtEnd()) {
+    throw runtime_error("error, trailing data in binary table file " +
+                        filename);
+  }
+}
+
+void Table::SaveBinary(const string &filename) const {
+  // the whole file is assembled in memory and written at once
+  string buffer(binary_magic, sizeof(binary_magic));
+  if (has_comment_) {
+    AppendInt(buffer, std::int64_t(comment_line_.size()));
+    buffer.append(comment_line_);
+  } else {
+    AppendInt(buffer, -1);
+  }
+  AppendInt(buffer, has_yerr_ ? 1 : 0);
+  AppendInt(buffer, size());
+  AppendVector(buffer, x_);
+  AppendVector(buffer, y_);
+  if (has_yerr_) {
+    AppendVector(buffer, yerr_);
+  }
+  buffer.append(flags_.data(), flags_.size());
+
+  ofstream out(filename, ios::binary | ios::trunc);
+  if (!out) {
+    throw runtime_error("error, cannot open file " + filename);
+  }
+  out.write(buffer.data(), std::streamsize(buffer.size()));
+  if (!out) {
+    throw runtime_error("error, cannot write file " + filename);
+  }
+}
+
 void Table::clear(void) {
   x_.resize(0);
   y_.resize(0);
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE binarytable_test
+
+// Standard includes
+#include <fstream>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/table.h"
+
+using namespace votca;
+using namespace votca::tools;
+
+BOOST_AUTO_TEST_SUITE(binarytable_test)
+
+BOOST_AUTO_TEST_CASE(roundtrip) {
+  Table pot;
+  for (Index i = 0; i < 50; ++i) {
+    pot.push_back(0.01 * double(i), 1.0 / (1.0 + double(i)), i < 5 ? 'o' : 'i');
+  }
+  pot.set_comment("potential of A-A");
+  pot.SaveBinary("binarytable_pot.bin");
+  BOOST_CHECK(Table::IsBinary("binarytable_pot.bin"));
+
+  Table pot2;
+  pot2.Load("binarytable_pot.bin");
+  BOOST_CHECK(pot2.x() == pot.x());
+  BOOST_CHECK(pot2.y() == pot.y());
+  BOOST_CHECK(pot2.flags() == pot.flags());
+  BOOST_CHECK(!pot2.GetHasYErr());
+
+  Table dist;
+  dist.SetHasYErr(true);
+  for (Index i = 0; i < 7; ++i) {
+    dist.push_back(double(i), double(i * i));
+  }
+  dist.yerr() = Eigen::VectorXd::Constant(7, 0.5);
+  dist.SaveBinary("binarytable_dist.bin");
+  Table dist2;
+  dist2.Load("binarytable_dist.bin");
+  BOOST_CHECK(dist2.GetHasYErr());
+  BOOST_CHECK(dist2.yerr() == dist.yerr());
+
+  Table empty;
+  empty.SaveBinary("binarytable_empty.bin");
+  Table empty2;
+  empty2.Load("binarytable_empty.bin");
+  BOOST_CHECK_EQUAL(empty2.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(text_and_binary) {
+  Table tb;
+  for (Index i = 0; i < 10; ++i) {
+    tb.push_back(double(i), 2.0 * double(i));
+  }
+  tb.SaveBinary("binarytable_single.bin");
+  tb.Save("binarytable_single.txt");
+  BOOST_CHECK(!Table::IsBinary("binarytable_single.txt"));
+
+  // Load detects the format
+  Table binary, text;
+  binary.Load("binarytable_single.bin");
+  text.Load("binarytable_single.txt");
+  BOOST_CHECK(binary.y() == tb.y());
+  BOOST_CHECK(binary.x() == text.x());
+  BOOST_CHECK(binary.y() == text.y());
+}
+
+BOOST_AUTO_TEST_CASE(truncated) {
+  Table tb;
+  tb.push_back(1.0, 2.0);
+  tb.SaveBinary("binarytable_truncated.bin");
+  std::ifstream in("binarytable_truncated.bin", std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream out("binarytable_truncated.bin",
+                    std::ios::binary | std::ios::trunc);
+  out.write(content.data(), std::streamsize(content.size() - 3));
+  out.close();
+  BOOST_CHECK_THROW(tb.Load("binarytable_truncated.bin"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
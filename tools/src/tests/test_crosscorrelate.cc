@@ -71,4 +71,58 @@ BOOST_AUTO_TEST_CASE(crosscorrelate) {
   BOOST_CHECK_EQUAL(equal_val, true);
 }
 
+BOOST_AUTO_TEST_CASE(linearautocorrelate) {
+
+  DataCollection<double> d;
+  DataCollection<double>::selection s;
+  for (Index k = 0; k < 3; k++) {
+    DataCollection<double>::array* x = d.CreateArray("series");
+    x->resize(37 + 20 * k);
+    for (Index i = 0; i < Index(x->size()); i++) {
+      (*x)[i] = std::sin(double(i) * 0.5) + std::cos(double(i * k) * 1.5);
+    }
+    s.push_back(x);
+  }
+
+  std::vector<std::vector<double> > corr =
+      CrossCorrelate::LinearAutoCorrelate(s, 20);
+  BOOST_REQUIRE_EQUAL(corr.size(), 3);
+  for (Index k = 0; k < 3; k++) {
+    const std::vector<double>& x = s[k];
+    Index N = Index(x.size());
+    double mean = 0.0;
+    for (double v : x) {
+      mean += v;
+    }
+    mean /= double(N);
+    BOOST_REQUIRE_EQUAL(corr[k].size(), 21);
+    double c0 = 0.0;
+    for (Index t = 0; t < 21; t++) {
+      double c = 0.0;
+      for (Index i = 0; i + t < N; i++) {
+        c += (x[i] - mean) * (x[i + t] - mean);
+      }
+      c /= double(N - t);
+      if (t == 0) {
+        c0 = c;
+      }
+      BOOST_CHECK_SMALL(corr[k][t] - c / c0, 1e-10);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(integratedcorrelationtime) {
+  // AR(1) process, corr(t) = phi^t and tau = (1+phi)/(2(1-phi))
+  double phi = 0.8;
+  std::vector<double> corr(1000);
+  for (Index t = 0; t < Index(corr.size()); t++) {
+    corr[t] = std::pow(phi, double(t));
+  }
+  BOOST_CHECK_CLOSE(CrossCorrelate::IntegratedCorrelationTime(corr, 20.0),
+                    (1 + phi) / (2 * (1 - phi)), 1e-3);
+  std::vector<double> uncorrelated = {1.0, 0.0, 0.0, 0.0};
+  BOOST_CHECK_CLOSE(CrossCorrelate::IntegratedCorrelationTime(uncorrelated),
+                    0.5, 1e-10);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
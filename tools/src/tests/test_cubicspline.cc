@@ -167,6 +167,33 @@ BOOST_AUTO_TEST_CASE(cubicspline_interpolate_test) {
   BOOST_CHECK_EQUAL(equal_derivative, true);
 }
 
+BOOST_AUTO_TEST_CASE(cubicspline_batch_test) {
+
+  // non-uniform grid, so the interval lookup has to fall back to bisection
+  int size = 40;
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(size);
+  Eigen::VectorXd y = Eigen::VectorXd::Zero(size);
+  for (int i = 0; i < size; ++i) {
+    x(i) = 0.01 * i * i;
+    y(i) = std::cos(x(i));
+  }
+  CubicSpline cspline;
+  cspline.setBCInt(0);
+  cspline.Interpolate(x, y);
+
+  Eigen::VectorXd rs = Eigen::VectorXd::LinSpaced(101, -1.0, 17.0);
+  Eigen::VectorXd values = cspline.Calculate(rs);
+  Eigen::VectorXd derivatives = cspline.CalculateDerivative(rs);
+  for (votca::Index i = 0; i < rs.size(); i++) {
+    BOOST_CHECK_SMALL(values(i) - cspline.Calculate(rs(i)), 1e-10);
+    BOOST_CHECK_SMALL(derivatives(i) - cspline.CalculateDerivative(rs(i)),
+                      1e-10);
+  }
+  BOOST_CHECK_EQUAL(cspline.getInterval(-1.0), 0);
+  BOOST_CHECK_EQUAL(cspline.getInterval(0.05), 2);
+  BOOST_CHECK_EQUAL(cspline.getInterval(17.0), size - 2);
+}
+
 BOOST_AUTO_TEST_CASE(cubicspline_matrix_test) {
 
   CubicSpline cspline;
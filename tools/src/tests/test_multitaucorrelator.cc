@@ -0,0 +1,94 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE multitaucorrelator_test
+
+// Standard includes
+#include <cmath>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/multitaucorrelator.h"
+
+using namespace votca;
+using namespace votca::tools;
+
+BOOST_AUTO_TEST_SUITE(multitaucorrelator_test)
+
+BOOST_AUTO_TEST_CASE(level0) {
+  // on the first level the correlator is exact
+  MultiTauCorrelator correlator(8, 2, 3);
+  std::vector<double> x(200);
+  double mean = 0.0;
+  for (Index i = 0; i < Index(x.size()); i++) {
+    x[i] = std::sin(double(i) * 0.3) + 0.5;
+    mean += x[i] / double(x.size());
+    correlator.Add(x[i]);
+  }
+  BOOST_CHECK_EQUAL(correlator.Samples(), 200);
+
+  auto direct = [&](Index t) {
+    double c = 0.0;
+    for (Index i = 0; i + t < Index(x.size()); i++) {
+      c += x[i] * x[i + t];
+    }
+    return c / double(Index(x.size()) - t) - mean * mean;
+  };
+
+  Table corr = correlator.getCorrelation();
+  for (Index t = 0; t < 8; t++) {
+    BOOST_CHECK_CLOSE(corr.x(t), double(t), 1e-12);
+    BOOST_CHECK_SMALL(corr.y(t) - direct(t) / direct(0), 1e-10);
+  }
+  // 8 lags on level 0 and 4 new ones on each further level
+  BOOST_CHECK_EQUAL(corr.size(), 8 + 4 + 4);
+  BOOST_CHECK_CLOSE(corr.x(8), 8.0, 1e-12);
+  BOOST_CHECK_CLOSE(corr.x(15), 28.0, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(decay) {
+  // AR(1) process with corr(t) = phi^t, the block averaged levels are only
+  // approximate, so the check is loose
+  MultiTauCorrelator correlator;
+  double phi = 0.9;
+  double x = 0.0;
+  unsigned long long state = 12345;
+  for (Index i = 0; i < 200000; i++) {
+    // uniform noise from a linear congruential generator
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    double noise = double(state >> 11) / double(1ULL << 53) - 0.5;
+    x = phi * x + noise;
+    correlator.Add(x);
+  }
+  Table corr = correlator.getCorrelation();
+  for (Index i = 0; i < corr.size(); i++) {
+    if (corr.x(i) <= 40) {
+      BOOST_CHECK_SMALL(corr.y(i) - std::pow(phi, corr.x(i)), 0.05);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(invalid) {
+  BOOST_CHECK_THROW(MultiTauCorrelator(15, 2, 3), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
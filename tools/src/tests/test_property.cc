@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -123,6 +123,77 @@ BOOST_AUTO_TEST_CASE(select) {
   BOOST_CHECK_EQUAL(s8.size(), 4);
 }
 
+BOOST_AUTO_TEST_CASE(stream) {
+  std::ofstream xmlfile("test_stream.xml");
+  xmlfile << "<jobs>" << std::endl;
+  xmlfile << "  <job id=\"1\">" << std::endl;
+  xmlfile << "    <tag>first</tag>" << std::endl;
+  xmlfile << "    <input><a>1.5</a></input>" << std::endl;
+  xmlfile << "  </job>" << std::endl;
+  xmlfile << "  <other><job>ignored</job></other>" << std::endl;
+  xmlfile << "  <job id=\"2\">" << std::endl;
+  xmlfile << "    <tag>second</tag>" << std::endl;
+  xmlfile << "    <job>nested</job>" << std::endl;
+  xmlfile << "  </job>" << std::endl;
+  xmlfile << "</jobs>" << std::endl;
+  xmlfile.close();
+
+  Property prop;
+  prop.LoadFromXML("test_stream.xml");
+  std::vector<Property*> ref = prop.Select("jobs.job");
+
+  std::vector<Property> records;
+  Property::StreamFromXML(
+      "test_stream.xml", "jobs.job",
+      [&records](const Property& record) { records.push_back(record); });
+
+  BOOST_REQUIRE_EQUAL(records.size(), ref.size());
+  for (std::size_t i = 0; i < records.size(); i++) {
+    std::stringstream s_ref;
+    s_ref << *ref[i];
+    std::stringstream s_record;
+    s_record << records[i];
+    BOOST_CHECK_EQUAL(s_record.str(), s_ref.str());
+    BOOST_CHECK_EQUAL(records[i].path(), ref[i]->path());
+    BOOST_CHECK_EQUAL(records[i].getAttribute<votca::Index>("id"),
+                      ref[i]->getAttribute<votca::Index>("id"));
+  }
+  BOOST_CHECK_EQUAL(records[0].get("input.a").as<double>(), 1.5);
+  BOOST_CHECK_EQUAL(records[1].get("job").path(), "jobs.job");
+
+  BOOST_CHECK_THROW(Property::StreamFromXML(
+                        "test_stream.xml", "jobs.job",
+                        [](const Property&) {
+                          throw std::runtime_error("stop");
+                        }),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(shared_names) {
+  std::ofstream xmlfile("test_shared.xml");
+  xmlfile << "<jobs><job><id>1</id></job><job><id>2</id></job></jobs>";
+  xmlfile << std::endl;
+  xmlfile.close();
+
+  Property prop;
+  prop.LoadFromXML("test_shared.xml");
+  std::vector<Property*> jobs = prop.Select("jobs.job");
+  BOOST_REQUIRE_EQUAL(jobs.size(), 2);
+  // equal names and paths read from one file are stored once
+  const Property& first = *jobs[0];
+  const Property& second = *jobs[1];
+  BOOST_CHECK_EQUAL(&first.name(), &second.name());
+  BOOST_CHECK_EQUAL(&first.get("id").path(), &second.get("id").path());
+
+  // changing them through the mutable accessors only affects one node
+  jobs[0]->name() = "task";
+  jobs[0]->get("id").path() = "jobs.task";
+  BOOST_CHECK_EQUAL(first.name(), "task");
+  BOOST_CHECK_EQUAL(second.name(), "job");
+  BOOST_CHECK_EQUAL(first.get("id").path(), "jobs.task");
+  BOOST_CHECK_EQUAL(second.get("id").path(), "jobs.job");
+}
+
 BOOST_AUTO_TEST_CASE(printtostream) {
 
   Property prop;
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE weightedhistogram_test
+
+// Standard includes
+#include <stdexcept>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/datacollection.h"
+#include "votca/tools/histogram.h"
+
+using namespace votca::tools;
+
+BOOST_AUTO_TEST_SUITE(weightedhistogram_test)
+
+BOOST_AUTO_TEST_CASE(weighted_equals_unweighted) {
+  DataCollection<double> data;
+  DataCollection<double>::array *values = data.CreateArray("bond");
+  for (double v : {0.1, 0.2, 0.2, 0.35, 0.9, 0.9, 0.9}) {
+    values->push_back(v);
+  }
+  DataCollection<double>::selection *sel = data.select("*");
+
+  Histogram::options_t options;
+  options.n_ = 11;
+  options.scale_ = "bond";
+  Histogram unweighted(options);
+  unweighted.ProcessData(sel);
+  delete sel;
+
+  // the zero weight must neither count nor widen the interval
+  Histogram weighted(options);
+  weighted.ProcessWeighted({0.1, 0.2, 0.35, 0.9, 2.0}, {1, 2, 1, 3, 0});
+
+  BOOST_CHECK_CLOSE(weighted.getMin(), unweighted.getMin(), 1e-12);
+  BOOST_CHECK_CLOSE(weighted.getMax(), unweighted.getMax(), 1e-12);
+  BOOST_REQUIRE_EQUAL(weighted.getPdf().size(), unweighted.getPdf().size());
+  for (size_t i = 0; i < weighted.getPdf().size(); ++i) {
+    BOOST_CHECK_CLOSE(weighted.getPdf()[i], unweighted.getPdf()[i], 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(size_mismatch) {
+  Histogram h;
+  BOOST_CHECK_THROW(h.ProcessWeighted({0.1, 0.2}, {1.0}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
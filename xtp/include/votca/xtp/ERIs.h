@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -65,6 +65,15 @@ class ERIs {
 
   Index Removedfunctions() const { return threecenter_.Removedfunctions(); }
 
+  /// number of shell pairs kept after the Schwarz screening of the RI
+  /// integrals, and number of all shell pairs
+  Index NumberOfShellPairs() const {
+    return threecenter_.NumberOfShellPairs();
+  }
+  Index NumberOfAllShellPairs() const {
+    return threecenter_.NumberOfAllShellPairs();
+  }
+
   static double CalculateEnergy(const Eigen::MatrixXd& DMAT,
                                 const Eigen::MatrixXd& matrix_operator) {
     return matrix_operator.cwiseProduct(DMAT).sum();
@@ -81,6 +90,9 @@ class ERIs {
 
   Eigen::MatrixXd CalculateEXX_dmat(const Eigen::MatrixXd& DMAT) const;
   Eigen::MatrixXd CalculateEXX_mos(const Eigen::MatrixXd& occMos) const;
+  // K = - sum_k w_k sum_P (B_P v_k) (B_P v_k)^T
+  Eigen::MatrixXd ContractExchange(const Eigen::MatrixXd& vectors,
+                                   const Eigen::VectorXd& weights) const;
 
   std::vector<std::vector<libint2::ShellPair>> ComputeShellPairData(
       const std::vector<libint2::Shell>& basis,
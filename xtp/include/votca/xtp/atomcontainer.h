@@ -1,7 +1,7 @@
 
 
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -64,6 +64,8 @@ class AtomContainer {
 
   Index getId() const { return id_; }
 
+  void setId(Index id) { id_ = id; }
+
   Index size() const { return atomlist_.size(); }
 
   void push_back(const T& atom) {
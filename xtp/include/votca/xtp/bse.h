@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -70,6 +70,11 @@ class BSE {
   void Solve_singlets(Orbitals& orb) const;
   void Solve_triplets(Orbitals& orb) const;
 
+  // initial vectors for the Davidson solver, e.g. projected eigenvectors of a
+  // neighbouring geometry, [X;Y] stacked if TDA is not used
+  void setSingletGuess(const Eigen::MatrixXd& guess) { singlet_guess_ = guess; }
+  void setTripletGuess(const Eigen::MatrixXd& guess) { triplet_guess_ = guess; }
+
   Eigen::MatrixXd getHqp() const { return Hqp_; };
 
   SingletOperator_TDA getSingletOperator_TDA() const;
@@ -111,6 +116,9 @@ class BSE {
   TCMatrix_gwbse& Mmn_;
   Eigen::MatrixXd Hqp_;
 
+  Eigen::MatrixXd singlet_guess_;
+  Eigen::MatrixXd triplet_guess_;
+
   tools::EigenSystem Solve_singlets_TDA() const;
   tools::EigenSystem Solve_singlets_BTDA() const;
 
@@ -123,15 +131,17 @@ class BSE {
   void configureBSEOperator(BSE_OPERATOR& H) const;
 
   template <typename BSE_OPERATOR>
-  tools::EigenSystem solve_hermitian(BSE_OPERATOR& h) const;
+  tools::EigenSystem solve_hermitian(BSE_OPERATOR& h,
+                                     const Eigen::MatrixXd& guess) const;
 
   template <typename BSE_OPERATOR_ApB, typename BSE_OPERATOR_AmB>
   tools::EigenSystem Solve_nonhermitian(BSE_OPERATOR_ApB& apb,
                                         BSE_OPERATOR_AmB&) const;
 
   template <typename BSE_OPERATOR_A, typename BSE_OPERATOR_B>
-  tools::EigenSystem Solve_nonhermitian_Davidson(BSE_OPERATOR_A& Aop,
-                                                 BSE_OPERATOR_B& Bop) const;
+  tools::EigenSystem Solve_nonhermitian_Davidson(
+      BSE_OPERATOR_A& Aop, BSE_OPERATOR_B& Bop,
+      const Eigen::MatrixXd& guess) const;
 
   void printFragInfo(const std::vector<QMFragment<BSE_Population> >& frags,
                      Index state) const;
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -132,6 +132,12 @@ class CheckpointReader {
 
   Index getNumDataSets() const { return loc_.getNumObjs(); }
 
+  /// true if a dataset, group or attribute of this name exists
+  bool exists(const std::string& name) const {
+    return H5Lexists(loc_.getId(), name.c_str(), H5P_DEFAULT) > 0 ||
+           loc_.attrExists(name);
+  }
+
   CptLoc getLoc() { return loc_; }
 
   template <typename T>
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -97,6 +97,26 @@ class ConvergenceAcc {
 
   Eigen::MatrixXd DensityMatrix(const tools::EigenSystem& MOs) const;
 
+  /// Fock matrices, densities and total energies the (A)DIIS extrapolates
+  /// from, oldest first
+  struct History {
+    std::vector<Eigen::MatrixXd> fock;
+    std::vector<Eigen::MatrixXd> dmats;
+    std::vector<double> energies;
+  };
+
+  History getHistory() const { return {mathist_, dmatHist_, totE_}; }
+
+  /// takes over the (A)DIIS history of a previous SCF on the same molecule,
+  /// whose one-electron Hamiltonian differed by deltaH0 and its energy by
+  /// deltaE0, e.g. because the external potential changed. The stored Fock
+  /// matrices, energies and error matrices are shifted accordingly, so they
+  /// are exact for the new Hamiltonian. Call after setOverlap.
+  void ContinueHistory(const History& previous, const Eigen::MatrixXd& deltaH0,
+                       double deltaE0);
+
+  Index HistorySize() const { return Index(mathist_.size()); }
+
  private:
   options opt_;
 
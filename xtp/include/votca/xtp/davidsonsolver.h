@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -30,6 +30,7 @@
 // Local VOTCA includes
 #include "eigen.h"
 #include "logger.h"
+#include "profiler.h"
 
 namespace votca {
 namespace xtp {
@@ -55,15 +56,23 @@ class DavidsonSolver {
   void set_correction(std::string method);
   void set_size_update(std::string update_size);
   void set_matrix_type(std::string mt);
+  // vectors replacing the first unit vectors of the initial guess, e.g. the
+  // eigenvectors of a similar problem, ignored if their size does not match
+  void set_initial_guess(const Eigen::MatrixXd &guess) {
+    initial_guess_ = guess;
+  }
 
   Eigen::ComputationInfo info() const { return info_; }
   Eigen::VectorXd eigenvalues() const { return this->eigenvalues_; }
   Eigen::MatrixXd eigenvectors() const { return this->eigenvectors_; }
   Index num_iterations() const { return this->i_iter_; }
+  // number of vectors the operator was applied to in the last solve
+  Index num_operator_applications() const { return op_applications_; }
 
   template <typename MatrixReplacement>
   void solve(const MatrixReplacement &A, Index neigen,
              Index size_initial_guess = 0) {
+    ProfileScope profile("DavidsonSolver::solve");
 
     if (max_search_space_ < neigen) {
       max_search_space_ = neigen * 5;
@@ -81,6 +90,7 @@ class DavidsonSolver {
     }
 
     restart_size_ = size_initial_guess;
+    op_applications_ = 0;
 
     // get the diagonal of the operator
     this->Adiag_ = A.diagonal();
@@ -93,6 +103,11 @@ class DavidsonSolver {
 
     for (i_iter_ = 0; i_iter_ < iter_max_; i_iter_++) {
 
+      // the operator is only applied to the vectors added since the last
+      // iteration (once more for A*A*V in the non-hermitian case)
+      Index new_vectors = proj.V.cols() - proj.AV.cols();
+      op_applications_ +=
+          (matrix_type_ == MATRIX_TYPE::HAM) ? 2 * new_vectors : new_vectors;
       updateProjection(A, proj);
 
       rep = getRitzEigenPairs(proj);
@@ -118,6 +133,7 @@ class DavidsonSolver {
       }
     }
 
+    printStatistics();
     printTiming(start);
   }
 
@@ -129,7 +145,9 @@ class DavidsonSolver {
   double tol_ = 1E-4;
   Index max_search_space_ = 0;
   Eigen::VectorXd Adiag_;
+  Eigen::MatrixXd initial_guess_;
   Index restart_size_ = 0;
+  Index op_applications_ = 0;
   enum CORR { DPR, OLSEN };
   CORR davidson_correction_ = CORR::DPR;
 
@@ -229,6 +247,8 @@ class DavidsonSolver {
   void printIterationData(const RitzEigenPair &rep, const ProjectedSpace &proj,
                           Index neigen) const;
 
+  void printStatistics() const;
+
   ArrayXl argsort(const Eigen::VectorXd &V) const;
 
   Eigen::MatrixXd setupInitialEigenvectors(Index size_initial_guess) const;
@@ -236,8 +256,8 @@ class DavidsonSolver {
   Eigen::MatrixXd extract_vectors(const Eigen::MatrixXd &V,
                                   const ArrayXl &idx) const;
 
-  void orthogonalize(Eigen::MatrixXd &V, Index nupdate) const;
-  void gramschmidt(Eigen::MatrixXd &A, Index nstart) const;
+  Index orthogonalize(Eigen::MatrixXd &V, Index nupdate) const;
+  Index gramschmidt(Eigen::MatrixXd &A, Index nstart) const;
 
   Eigen::VectorXd computeCorrectionVector(const Eigen::VectorXd &qj,
                                           double lambdaj,
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -30,6 +30,7 @@
 #include "ecpaobasis.h"
 #include "logger.h"
 #include "qmmolecule.h"
+#include "scfhistory.h"
 #include "staticsite.h"
 #include "vxc_grid.h"
 #include "vxc_potential.h"
@@ -56,6 +57,10 @@ class DFTEngine {
     externalsites_ = externalsites;
   }
 
+  /// the guess and the DIIS history are taken from the history if it fits,
+  /// a converged run is stored in it
+  void setSCFHistory(SCFHistory* history) { scf_history_ = history; }
+
   bool Evaluate(Orbitals& orb);
 
   bool EvaluateActiveRegion(Orbitals& orb);
@@ -93,6 +98,9 @@ class DFTEngine {
   tools::EigenSystem ModelPotentialGuess(
       const Mat_p_Energy& H0, const QMMolecule& mol,
       const Vxc_Potential<Vxc_Grid>& vxcpotential) const;
+  tools::EigenSystem GuessFromDensity(
+      const Mat_p_Energy& H0, const Eigen::MatrixXd& Dmat,
+      const Vxc_Potential<Vxc_Grid>& vxcpotential) const;
 
   Eigen::MatrixXd AtomicGuess(const QMMolecule& mol) const;
 
@@ -135,6 +143,8 @@ class DFTEngine {
   // Electron repulsion integrals
   ERIs ERIs_;
 
+  SCFHistory* scf_history_ = nullptr;
+
   // external charges
   std::vector<std::unique_ptr<StaticSite> >* externalsites_ = nullptr;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -22,6 +22,7 @@
 // Local VOTCA includes
 #include "eeinteractor.h"
 #include "eigen.h"
+#include "ewaldinteractor.h"
 
 namespace votca {
 namespace xtp {
@@ -53,9 +54,12 @@ class DipoleDipoleInteraction
     IsRowMajor = false
   };
 
+  /// if ewald is given, the sites interact with all periodic images, the
+  /// segments have to be the ones the EwaldInteractor was built from
   DipoleDipoleInteraction(const eeInteractor& interactor,
-                          const std::vector<PolarSegment>& segs)
-      : interactor_(interactor) {
+                          const std::vector<PolarSegment>& segs,
+                          const EwaldInteractor* ewald = nullptr)
+      : interactor_(interactor), ewald_(ewald) {
     size_ = 0;
     for (const PolarSegment& seg : segs) {
       size_ += 3 * seg.size();
@@ -68,17 +72,25 @@ class DipoleDipoleInteraction
     }
   }
 
+  // with ewald only the diagonal 3x3 block of a column is visited, the
+  // preconditioner only needs the diagonal and a full column would cost
+  // O(N_sites*N_k)
   class InnerIterator {
    public:
     InnerIterator(const DipoleDipoleInteraction& xpr, const Index& id)
-        : xpr_(xpr), id_(id){};
+        : xpr_(xpr), id_(id) {
+      if (xpr_.ewald_ != nullptr) {
+        row_ = 3 * (id_ / 3);
+        end_ = row_ + 3;
+      }
+    };
 
     InnerIterator& operator++() {
       row_++;
       return *this;
     }
     operator bool() const {
-      return row_ < xpr_.size_;
+      return row_ < end_;
     }  // DO not use the size method, it returns linear dimension*linear
        // dimension i.e  size_^2
     double value() const { return xpr_(row_, id_); }
@@ -90,6 +102,7 @@ class DipoleDipoleInteraction
     const DipoleDipoleInteraction& xpr_;
     const Index id_;
     Index row_ = 0;
+    Index end_ = xpr_.size_;
   };
 
   Index rows() const { return this->size_; }
@@ -110,7 +123,13 @@ class DipoleDipoleInteraction
     Index seg2id = Index(j / 3);
     Index xyz2 = Index(j % 3);
 
-    if (seg1id == seg2id) {
+    if (ewald_ != nullptr) {
+      double value = ewald_->DipoleTensor(seg1id, seg2id)(xyz1, xyz2);
+      if (seg1id == seg2id) {
+        value += sites_[seg1id]->getPInv()(xyz1, xyz2);
+      }
+      return value;
+    } else if (seg1id == seg2id) {
       return sites_[seg1id]->getPInv()(xyz1, xyz2);
     } else {
       const PolarSite& site1 = *sites_[seg1id];
@@ -123,6 +142,13 @@ class DipoleDipoleInteraction
     assert(v.size() == size_ &&
            "input vector has the wrong size for multiply with operator");
     const Index segment_size = Index(sites_.size());
+    if (ewald_ != nullptr) {
+      Eigen::VectorXd result = ewald_->InducedField(v);
+      for (Index i = 0; i < segment_size; i++) {
+        result.segment<3>(3 * i) += sites_[i]->getPInv() * v.segment<3>(3 * i);
+      }
+      return result;
+    }
     Eigen::VectorXd result = Eigen::VectorXd::Zero(size_);
 #pragma omp parallel for schedule(dynamic) reduction(+ : result)
     for (Index i = 0; i < segment_size; i++) {
@@ -141,6 +167,7 @@ class DipoleDipoleInteraction
 
  private:
   const eeInteractor& interactor_;
+  const EwaldInteractor* ewald_;
   std::vector<const PolarSite*> sites_;
   Index size_;
 };
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -41,6 +41,8 @@ class eeInteractor {
   explicit eeInteractor() = default;
   explicit eeInteractor(double expdamping) : expdamping_(expdamping){};
 
+  double getExpDamping() const { return expdamping_; }
+
   Eigen::Matrix3d FillTholeInteraction(const PolarSite& site1,
                                        const PolarSite& site2) const;
 
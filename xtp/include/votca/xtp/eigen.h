@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -133,9 +133,17 @@ inline Index getMaxThreads() {
   return nthreads;
 }
 
+// number of enclosing parallel levels which only distribute independent
+// jobs, e.g. the frames of a state file, code running inside such a job sees
+// them as serial
+inline Index& JobParallelLevels() {
+  static thread_local Index levels = 0;
+  return levels;
+}
+
 inline bool InsideActiveParallelRegion(){
 #ifdef  _OPENMP
-  return omp_in_parallel();
+  return Index(omp_get_active_level()) > JobParallelLevels();
 #endif
 return false;
 }
@@ -154,8 +162,16 @@ inline void setMaxThreads(Index threads) {
     omp_set_num_threads(int(threads));
   }
 }
+inline Index getMaxActiveLevels() {
+  return Index(omp_get_max_active_levels());
+}
+inline void setMaxActiveLevels(Index levels) {
+  omp_set_max_active_levels(int(levels));
+}
 #else
 inline void setMaxThreads(Index) {}
+inline Index getMaxActiveLevels() { return 1; }
+inline void setMaxActiveLevels(Index) {}
 #endif
 }  // namespace OPENMP
 }  // namespace xtp
@@ -0,0 +1,175 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_EWALDINTERACTOR_H
+#define VOTCA_XTP_EWALDINTERACTOR_H
+
+// Standard includes
+#include <complex>
+#include <memory>
+#include <vector>
+
+// VOTCA includes
+#include <votca/csg/boundarycondition.h>
+
+// Local VOTCA includes
+#include "classicalsegment.h"
+#include "eeinteractor.h"
+#include "eigen.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Ewald summation of the interactions between polar sites in a
+ * periodic box
+ *
+ * Counterpart of the eeInteractor for a polar region, which is repeated
+ * periodically. The same conventions are used: the "field" is the gradient
+ * of the potential, the permanent multipoles of sites on the same segment do
+ * not interact with each other and induced dipoles interact via the Thole
+ * damped dipole tensor, also inside a segment. Sites interact with all
+ * periodic images, including the images of their own segment.
+ *
+ * The real space part uses a cell list of the sites. The reciprocal part is
+ * either a plain sum over k-vectors, which costs O(N_sites*N_k), or smooth
+ * particle mesh Ewald (Essmann et al., J. Chem. Phys. 103, 8577 (1995)),
+ * which costs O(N_sites + N_mesh log N_mesh). For a fixed real space cutoff
+ * N_k and N_mesh grow with the volume, so only the mesh is feasible for a
+ * whole MD box. Tin-foil boundary conditions are used and a net charge is
+ * compensated by a uniform background. Only charges and dipoles are
+ * supported, sites with quadrupoles are rejected.
+ */
+class EwaldInteractor {
+ public:
+  /// automatic picks the cheaper of the two for the given box and sites
+  enum class Reciprocal { automatic, kvectors, mesh };
+
+  /// cutoff is the real space cutoff, which must be smaller than half the
+  /// box, tolerance the size of the neglected terms in real and reciprocal
+  /// space relative to the leading term
+  EwaldInteractor(const Eigen::Matrix3d& box, double cutoff, double tolerance,
+                  const eeInteractor& interactor,
+                  const std::vector<PolarSegment>& segments,
+                  Reciprocal method = Reciprocal::automatic);
+
+  Index NumberOfSites() const { return Index(pos_.size()); }
+
+  Index NumberOfKVectors() const { return Index(kvectors_.size()); }
+
+  bool UsesMesh() const { return use_mesh_; }
+
+  /// number of mesh points along the three box vectors
+  const Eigen::Array<Index, 3, 1>& MeshSize() const { return mesh_; }
+
+  double Alpha() const { return alpha_; }
+
+  /// potential (row 0) and field (rows 1-3) of the permanent multipoles of
+  /// all other segments and all periodic images at every site
+  const Eigen::MatrixXd& StaticField() const { return static_field_; }
+
+  /// electrostatic energy of the permanent multipoles per unit cell
+  double StaticEnergy() const;
+
+  /// field of the induced dipoles, the i-th dipole is in
+  /// dipoles.segment<3>(3*i)
+  Eigen::VectorXd InducedField(const Eigen::VectorXd& dipoles) const;
+
+  /// periodic Thole tensor between two sites, for i==j the interaction with
+  /// the own periodic images. The reciprocal part of i!=j is a sum over all
+  /// k-vectors, so this is only meant for single elements, e.g. the diagonal
+  /// of the preconditioner.
+  Eigen::Matrix3d DipoleTensor(Index i, Index j) const;
+
+ private:
+  enum class Interaction { Static, Induced };
+
+  // potential and field of charges q and dipoles d at all sites
+  Eigen::MatrixXd Field(const Eigen::VectorXd& q, const Eigen::Matrix3Xd& d,
+                        Interaction type) const;
+
+  void RealSpace(const Eigen::VectorXd& q, const Eigen::Matrix3Xd& d,
+                 Interaction type, Eigen::MatrixXd& field) const;
+
+  void ReciprocalSpace(const Eigen::VectorXd& q, const Eigen::Matrix3Xd& d,
+                       Eigen::MatrixXd& field) const;
+
+  void ReciprocalSpaceMesh(const Eigen::VectorXd& q, const Eigen::Matrix3Xd& d,
+                           Eigen::MatrixXd& field) const;
+
+  void Corrections(const Eigen::VectorXd& q, const Eigen::Matrix3Xd& d,
+                   Interaction type, Eigen::MatrixXd& field) const;
+
+  // radial functions B_0 to B_2 of the screened coulomb interaction
+  Eigen::Vector3d ScreenedB(double r) const;
+
+  // (B_1, B_2) of the Thole damped minus the bare dipole tensor
+  Eigen::Vector2d TholeCorrectionB(Index i, Index j, double r) const;
+
+  void SetupKVectors(double tolerance);
+
+  void SetupMesh(double tolerance);
+
+  // B-spline weights M_n(u-g) and their derivatives for the mesh points
+  // g=floor(u)-n+1 to floor(u)
+  void SplineWeights(double u, Eigen::VectorXd& weights,
+                     Eigen::VectorXd& derivatives) const;
+
+  // in place 3D transform of the mesh, the inverse is not normalised
+  void FFT(std::vector<std::complex<double>>& mesh, bool inverse) const;
+
+  static constexpr Index spline_order_ = 8;
+
+  double expdamping_;
+  std::unique_ptr<csg::BoundaryCondition> bc_;
+  double volume_;
+  double cutoff_;
+  double alpha_;
+
+  std::vector<Eigen::Vector3d> pos_;
+  std::vector<Index> segment_of_site_;
+  std::vector<double> sqrt_inv_damp_;
+  // sites of segment s are segment_start_[s] to segment_start_[s+1]-1
+  std::vector<Index> segment_start_;
+  // neighbours j>i of each site inside the cutoff
+  std::vector<std::vector<Index>> neighbours_;
+
+  std::vector<Eigen::Vector3d> kvectors_;
+  std::vector<double> kprefactors_;
+  // reciprocal part of the interaction of a dipole with its own images
+  Eigen::Matrix3d self_tensor_;
+
+  bool use_mesh_ = false;
+  Eigen::Array<Index, 3, 1> mesh_ = Eigen::Array<Index, 3, 1>::Zero();
+  // row a is the a-th reciprocal box vector times the mesh size along it, so
+  // it maps positions to mesh coordinates
+  Eigen::Matrix3d mesh_map_;
+  // convolution kernel of the mesh in reciprocal space
+  std::vector<double> influence_;
+
+  Eigen::VectorXd charges_;
+  Eigen::Matrix3Xd dipoles_;
+  Eigen::MatrixXd static_field_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_EWALDINTERACTOR_H
@@ -0,0 +1,84 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_EXTERNALPROCESSPOOL_H
+#define VOTCA_XTP_EXTERNALPROCESSPOOL_H
+
+// Standard includes
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+
+// Local VOTCA includes
+#include "eigen.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Runs external programs, e.g. ORCA, with a limit on how many of them
+ * run at the same time
+ *
+ * Run blocks until the program finished. Submit returns at once with a future
+ * for the exit status, so one job thread can keep several programs in flight
+ * and write inputs or parse outputs meanwhile, see
+ * ParallelXJobCalc::SubmitJob. Programs above the limit wait for a free slot.
+ * Programs are started with fork/exec and /bin/sh -c in their working
+ * directory.
+ */
+class ExternalProcessPool {
+ public:
+  /// the pool shared by all QM packages of the process
+  static ExternalProcessPool& Instance();
+
+  /// maximal number of programs running at the same time, 0 means no limit
+  void setMaxProcesses(Index max_processes);
+  Index getMaxProcesses() const;
+
+  /// runs the command in workdir as soon as a slot is free and blocks until
+  /// it finished, returns its exit status or -1 if it could not be started
+  Index Run(const std::string& command, const std::string& workdir);
+
+  /// like Run, but returns at once, the program is started on a helper thread
+  /// as soon as a slot is free
+  std::future<Index> Submit(const std::string& command,
+                            const std::string& workdir);
+
+  Index Running() const;
+  /// highest number of simultaneously running programs so far
+  Index PeakRunning() const;
+
+ private:
+  void AcquireSlot();
+  void ReleaseSlot();
+  static Index Execute(const std::string& command, const std::string& workdir);
+
+  mutable std::mutex mutex_;
+  std::condition_variable slot_released_;
+  Index max_processes_ = 0;
+  Index running_ = 0;
+  Index peak_running_ = 0;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_EXTERNALPROCESSPOOL_H
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -79,21 +79,6 @@ class GridBox {
   void AddtoBigMatrix(Eigen::MatrixXd& bigmatrix,
                       const Eigen::MatrixXd& smallmatrix) const;
 
-  static bool compareGridboxes(GridBox& box1, GridBox& box2) {
-    if (box1.Matrixsize() != box2.Matrixsize()) {
-      return false;
-    }
-    if (box1.Shellsize() != box2.Shellsize()) {
-      return false;
-    }
-    for (Index i = 0; i < Index(box1.significant_shells.size()); ++i) {
-      if (box1.significant_shells[i] != box2.significant_shells[i]) {
-        return false;
-      }
-    }
-    return true;
-  }
-
  private:
   Index matrix_size = 0;
   std::vector<GridboxRange> aoranges;
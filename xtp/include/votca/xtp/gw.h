@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -70,6 +70,10 @@ class GW {
 
   void configure(const options& opt);
 
+  // QP energies of a previous, similar calculation (e.g. a neighbouring
+  // geometry) used as starting point of the QP and evGW iterations
+  void setQPGuess(const Eigen::VectorXd& qp_guess) { qp_guess_ = qp_guess; }
+
   Eigen::VectorXd getGWAResults() const;
   // Calculates the diagonal elements up to self consistency
   void CalculateGWPerturbation();
@@ -98,6 +102,8 @@ class GW {
 
   options opt_;
 
+  Eigen::VectorXd qp_guess_;
+
   std::unique_ptr<Sigma_base> sigma_ = nullptr;
   Logger& log_;
   TCMatrix_gwbse& Mmn_;
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -64,13 +64,23 @@ class GWBSE {
 
   bool Evaluate();
 
+  // results of a previous calculation on a similar geometry, its QP energies
+  // and BSE eigenvectors are projected onto the current MOs and used as
+  // starting points, must outlive Evaluate
+  void setGuess(const Orbitals* guess) { guess_ = guess; }
+
   void addoutput(tools::Property& summary);
 
  private:
   Eigen::MatrixXd CalculateVXC(const AOBasis& dftbasis);
   Index CountCoreLevels();
+  bool GuessMatchesOrbitals() const;
+  Eigen::MatrixXd GuessMOOverlap(const AOBasis& dftbasis) const;
+  Eigen::MatrixXd ProjectBSEGuess(const tools::EigenSystem& guess_states,
+                                  const Eigen::MatrixXd& mo_overlap) const;
   Logger* pLog_;
   Orbitals& orbitals_;
+  const Orbitals* guess_ = nullptr;
   // program tasks
 
   bool do_gw_ = false;
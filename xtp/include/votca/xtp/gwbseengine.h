@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -26,11 +26,11 @@
 
 // Local VOTCA includes
 #include "logger.h"
+#include "orbitals.h"
 
 namespace votca {
 namespace xtp {
 class QMPackage;
-class Orbitals;
 
 /**
  * \brief Electronic Excitations via Density-Functional Theory
@@ -71,6 +71,11 @@ class GWBSEEngine {
   bool do_localize_ = false;
   bool do_dft_in_dft_ = false;
 
+  // start SCF, GW and BSE from the results of the previous call, e.g. the
+  // previous step of a geometry optimization
+  bool warm_start_ = false;
+  Orbitals previous_;
+
   // DFT log and MO file names
   std::string MO_file_;      // file containing the MOs from qmpackage...
   std::string dftlog_file_;  // file containing the Energies etc... from
@@ -87,6 +92,7 @@ class GWBSEEngine {
   tools::Property summary_;
 
   void WriteLoggerToFile(Logger* pLog);
+  bool WarmStartPossible(const Orbitals& orbitals) const;
 };
 
 }  // namespace xtp
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -23,6 +23,10 @@
 #ifndef VOTCA_XTP_PARALLELXJOBCALC_H
 #define VOTCA_XTP_PARALLELXJOBCALC_H
 
+// Standard includes
+#include <memory>
+#include <stdexcept>
+
 // VOTCA includes
 #include <votca/tools/mutex.h>
 
@@ -68,6 +72,25 @@ class ParallelXJobCalc : public JobCalculator {
   virtual void CustomizeLogger(QMThread &thread);
   virtual Result EvalJob(const Topology &top, Job &job, QMThread &thread) = 0;
 
+  /// a job whose external program runs in the background
+  class PendingJob {
+   public:
+    virtual ~PendingJob() = default;
+    /// true if CollectJob would not wait for the external program
+    virtual bool Ready() const = 0;
+  };
+
+  /// prepares the job and starts its external program without waiting for
+  /// it, nullptr means the job has to be evaluated by EvalJob
+  virtual std::unique_ptr<PendingJob> SubmitJob(const Topology &, Job &,
+                                                QMThread &) {
+    return nullptr;
+  }
+  /// waits for the program of a job started by SubmitJob and finishes it
+  virtual Result CollectJob(PendingJob &, QMThread &) {
+    throw std::runtime_error(Identify() + " cannot collect submitted jobs");
+  }
+
   void LockCout() { coutMutex_.Lock(); }
   void UnlockCout() { coutMutex_.Unlock(); }
   void LockLog() { logMutex_.Lock(); }
@@ -107,6 +130,9 @@ class ParallelXJobCalc : public JobCalculator {
   tools::Mutex logMutex_;
   std::string mapfile_ = "";
   std::string jobfile_ = "";
+  // jobs a thread keeps submitted, more than one lets the thread prepare and
+  // parse jobs while the external programs of others run
+  Index runs_per_thread_ = 1;
 
  private:
   void ParseCommonOptions(const tools::Property &options);
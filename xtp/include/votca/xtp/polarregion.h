@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -24,6 +24,7 @@
 // Local VOTCA includes
 #include "eeinteractor.h"
 #include "energy_terms.h"
+#include "ewaldinteractor.h"
 #include "hist.h"
 #include "mmregion.h"
 
@@ -31,8 +32,9 @@
  * \brief defines a polar region and of interacting electrostatic and induction
  * segments
  *
- *
- *
+ * A periodic polar region is repeated with the box of the topology and the
+ * interactions inside the region are evaluated with Ewald summation.
+ * Interactions with other regions are not periodic.
  */
 
 namespace votca {
@@ -61,6 +63,11 @@ class PolarRegion : public MMRegion<PolarSegment> {
 
   void ReadFromCpt(CheckpointReader& r) override;
 
+  /// box of the topology, only used if the region is periodic
+  void setBox(const Eigen::Matrix3d& box) { box_ = box; }
+
+  bool Periodic() const { return periodic_; }
+
  protected:
   void AppendResult(tools::Property& prop) const override;
   double InteractwithQMRegion(const QMRegion& region) override;
@@ -83,11 +90,20 @@ class PolarRegion : public MMRegion<PolarSegment> {
       const Eigen::VectorXd& initial_guess);
   void WriteInducedDipolesToSegments(const Eigen::VectorXd& x);
 
+  void SetupEwald();
+  eeInteractor::E_terms PolarEnergy_periodic() const;
+
   hist<Energy_terms> E_hist_;
   double deltaE_ = 1e-5;
   double deltaD_ = 1e-5;
   Index max_iter_ = 100;
   double exp_damp_ = 0.39;
+
+  bool periodic_ = false;
+  Eigen::Matrix3d box_ = Eigen::Matrix3d::Zero();
+  double ewald_cutoff_ = 0.0;
+  double ewald_tolerance_ = 1e-7;
+  std::unique_ptr<EwaldInteractor> ewald_ = nullptr;
 };
 
 }  // namespace xtp
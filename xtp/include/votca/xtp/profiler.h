@@ -0,0 +1,133 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_PROFILER_H
+#define VOTCA_XTP_PROFILER_H
+
+// Standard includes
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// Local VOTCA includes
+#include "eigen.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Collects call counts, wall and CPU time, FLOP estimates and memory
+ * high-water marks of the computational kernels of xtp
+ *
+ * Kernels are timed with ProfileScope. Times are inclusive, i.e. a kernel
+ * which calls other kernels, e.g. the DFTEngine calling ERIs, contains their
+ * time as well. CPU time is the time of the whole process, so CPU/wall gives
+ * the average number of busy threads. The memory high-water mark is the
+ * maximum resident set size of the process at the end of a call, a kernel
+ * which raised it gets the increase attributed as its memory growth.
+ */
+class Profiler {
+ public:
+  struct Kernel {
+    Index calls = 0;
+    double wall = 0.0;  // seconds
+    double cpu = 0.0;   // seconds
+    double flops = 0.0;
+    Index peak_memory = 0;    // kB
+    Index memory_growth = 0;  // kB
+  };
+
+  /// the profiler shared by all engines of the process
+  static Profiler& Instance();
+
+  void Record(const std::string& name, double wall, double cpu, double flops,
+              Index memory_before, Index memory_after);
+
+  std::map<std::string, Kernel> Kernels() const;
+
+  void Reset();
+
+  /// table of all kernels sorted by wall time for the log
+  std::string Summary() const;
+
+  void WriteJSON(const std::string& filename) const;
+  void WriteCSV(const std::string& filename) const;
+
+  /// maximum resident set size of the process so far in kB
+  static Index PeakMemory();
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, Kernel> kernels_;
+};
+
+/**
+ * \brief Times the enclosing scope as a kernel of the Profiler
+ *
+ * Inside an OpenMP parallel region it does nothing, there the CPU time of
+ * the process says nothing about the kernel and the work is accounted for by
+ * the enclosing kernel.
+ */
+class ProfileScope {
+ public:
+  explicit ProfileScope(std::string name, double flops = 0.0)
+      : active_(!OPENMP::InsideActiveParallelRegion()) {
+    if (active_) {
+      name_ = std::move(name);
+      flops_ = flops;
+      memory_ = Profiler::PeakMemory();
+      cpu_start_ = std::clock();
+      wall_start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+  ~ProfileScope() {
+    if (!active_) {
+      return;
+    }
+    std::chrono::duration<double> wall =
+        std::chrono::steady_clock::now() - wall_start_;
+    double cpu = double(std::clock() - cpu_start_) / CLOCKS_PER_SEC;
+    Profiler::Instance().Record(name_, wall.count(), cpu, flops_, memory_,
+                                Profiler::PeakMemory());
+  }
+
+  /// for kernels whose work is only known at the end, e.g. iterative ones
+  void addFlops(double flops) { flops_ += flops; }
+
+ private:
+  bool active_;
+  std::string name_;
+  double flops_ = 0.0;
+  Index memory_ = 0;
+  std::clock_t cpu_start_ = 0;
+  std::chrono::time_point<std::chrono::steady_clock> wall_start_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_PROFILER_H
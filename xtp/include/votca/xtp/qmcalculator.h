@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -40,6 +40,15 @@ class QMCalculator : public tools::Calculator {
 
   virtual bool WriteToStateFile() const = 0;
 
+  /// true if several instances of the calculator can evaluate different
+  /// frames at the same time, i.e. all output goes to the topology or to
+  /// files named with FrameFileName
+  virtual bool AllowsConcurrentFrames() const { return false; }
+
+  /// adds the step of the frame to the output files, set for calculators
+  /// which evaluate frames concurrently
+  void setFrameUniqueOutput(bool unique) { frame_unique_output_ = unique; }
+
   bool EvaluateFrame(Topology& top);
 
   void Initialize(const tools::Property& opt) final;
@@ -47,6 +56,14 @@ class QMCalculator : public tools::Calculator {
  protected:
   virtual void ParseOptions(const tools::Property& opt) = 0;
   virtual bool Evaluate(Topology& top) = 0;
+
+  /// name of an output file of the frame, file_step_<step>.ext if frames
+  /// are evaluated concurrently
+  std::string FrameFileName(const std::string& filename,
+                            const Topology& top) const;
+
+ private:
+  bool frame_unique_output_ = false;
 };
 
 }  // namespace xtp
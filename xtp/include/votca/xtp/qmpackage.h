@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -22,6 +22,8 @@
 #ifndef VOTCA_XTP_QMPACKAGE_H
 #define VOTCA_XTP_QMPACKAGE_H
 
+#include <chrono>
+#include <future>
 #include <memory>
 // VOTCA includes
 #include <votca/tools/property.h>
@@ -37,6 +39,7 @@ namespace votca {
 namespace xtp {
 
 class Orbitals;
+class SCFHistory;
 
 class QMPackage {
  public:
@@ -50,6 +53,13 @@ class QMPackage {
   virtual bool WriteInputFile(const Orbitals& orbitals) = 0;
 
   bool Run();
+  /// starts the DFT run and returns before it finished if the package runs
+  /// an external program, Run() is Submit() followed by Collect()
+  void Submit();
+  /// true if Collect() would not wait for an external program
+  bool Ready() const;
+  /// waits for the run started by Submit(), returns the same as Run()
+  bool Collect();
   bool RunActiveRegion();
   virtual bool ParseLogFile(Orbitals& orbitals) = 0;
 
@@ -93,6 +103,19 @@ class QMPackage {
     return options_.get("initial_guess").as<std::string>() == "orbfile";
   }
 
+  // packages which can start the next SCF from the MOs of the orbitals passed
+  // to WriteInputFile, independent of the initial_guess option
+  virtual bool SupportsRestartGuess() const { return false; }
+  void setRestartGuess(bool restart) { restart_guess_ = restart; }
+
+  // packages which keep SCF information between runs on the same molecule,
+  // e.g. over the QM/MM iterations, the history is owned by the caller
+  virtual bool SupportsSCFHistory() const { return false; }
+  void setSCFHistory(SCFHistory* history) { scf_history_ = history; }
+  // multiplies the SCF convergence thresholds for the next runs, to converge
+  // only loosely while the environment is still far from self-consistency
+  void setSCFToleranceFactor(double factor) { scf_tolerance_factor_ = factor; }
+
   virtual StaticSegment GetCharges() const = 0;
 
   virtual Eigen::Matrix3d GetPolarizability() const = 0;
@@ -110,6 +133,11 @@ class QMPackage {
   };
 
   virtual bool RunDFT() = 0;
+  /// starts the external program of RunDFT without waiting for it, packages
+  /// computing in process return no future and Collect() calls RunDFT
+  virtual std::future<Index> StartDFT() { return std::future<Index>(); }
+  /// evaluates the exit status of the program started by StartDFT
+  virtual bool FinishDFT(Index) { return false; }
   virtual bool RunActiveDFT() = 0;
   virtual void WriteChargeOption() = 0;
   std::vector<MinimalMMCharge> SplitMultipoles(const StaticSite& site) const;
@@ -138,10 +166,17 @@ class QMPackage {
   std::string scratch_dir_;
   std::string shell_file_name_;
   tools::Property options_;
+  bool restart_guess_ = false;
+  SCFHistory* scf_history_ = nullptr;
+  double scf_tolerance_factor_ = 1.0;
 
   Logger* pLog_;
 
   std::vector<std::unique_ptr<StaticSite> > externalsites_;
+
+ private:
+  std::future<Index> pending_run_;
+  std::chrono::time_point<std::chrono::system_clock> submitted_;
 };
 
 }  // namespace xtp
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -26,6 +26,7 @@
 #include "orbitals.h"
 #include "qmpackagefactory.h"
 #include "region.h"
+#include "scfhistory.h"
 #include "statetracker.h"
 
 /**
@@ -83,6 +84,7 @@ class QMRegion : public Region {
  private:
   void AddNucleiFields(std::vector<PolarSegment>& segments,
                        const StaticSegment& seg) const;
+  double SCFToleranceFactor() const;
 
   Index size_ = 0;
   Orbitals orb_;
@@ -103,6 +105,13 @@ class QMRegion : public Region {
 
   bool do_gwbse_ = false;
 
+  // kept over the macro-iterations, the qmpackage is recreated in each one
+  bool use_scf_history_ = false;
+  SCFHistory scf_history_;
+  double max_scf_tolerance_factor_ = 1.0;
+  double scf_tolerance_factor_ = 1.0;
+  Index evaluations_ = 0;
+
   tools::Property dftoptions_;
   tools::Property gwbseoptions_;
 
@@ -0,0 +1,91 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_SCFHISTORY_H
+#define VOTCA_XTP_SCFHISTORY_H
+
+// Standard includes
+#include <deque>
+
+// Local VOTCA includes
+#include "convergenceacc.h"
+#include "eigen.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief State of the DFT self-consistency, which is carried from one run of
+ * the DFTEngine to the next one on the same molecule
+ *
+ * In QM/MM only the external potential of the QM region changes between two
+ * macro-iterations. The converged densities of the last runs are
+ * extrapolated to a guess for the next one, and the (A)DIIS history of the
+ * last run, shifted to the new one-electron Hamiltonian, continues.
+ */
+class SCFHistory {
+ public:
+  /// order 0 reuses the last density, 1 extrapolates linearly from the last
+  /// two, 2 quadratically from the last three
+  explicit SCFHistory(Index extrapolation_order = 1)
+      : order_(extrapolation_order) {}
+
+  Index ExtrapolationOrder() const { return order_; }
+
+  /// number of stored converged densities
+  Index size() const { return Index(dmats_.size()); }
+
+  /// true if the stored runs used the same number of basis functions and
+  /// electrons, i.e. most likely the same molecule and basis set
+  bool Compatible(Index basissize, Index numofelectrons) const {
+    return !dmats_.empty() && dmats_.front().rows() == basissize &&
+           numofelectrons_ == numofelectrons;
+  }
+
+  /// extrapolation of the stored densities, with the highest order the
+  /// number of stored densities allows
+  Eigen::MatrixXd ExtrapolatedDensity() const;
+
+  const ConvergenceAcc::History& DIISHistory() const { return diis_history_; }
+  const Mat_p_Energy& H0() const { return H0_; }
+
+  /// stores the result of a converged run, of the accelerator only its
+  /// history is kept
+  void Store(const ConvergenceAcc& accelerator, const Mat_p_Energy& H0,
+             const Eigen::MatrixXd& dmat, Index numofelectrons);
+
+  void clear() {
+    dmats_.clear();
+    diis_history_ = ConvergenceAcc::History();
+  }
+
+ private:
+  Index order_;
+  Index numofelectrons_ = 0;
+  // newest first
+  std::deque<Eigen::MatrixXd> dmats_;
+  Mat_p_Energy H0_;
+  ConvergenceAcc::History diis_history_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_SCFHISTORY_H
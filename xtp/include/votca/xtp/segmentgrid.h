@@ -0,0 +1,97 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_SEGMENTGRID_H
+#define VOTCA_XTP_SEGMENTGRID_H
+
+// Standard includes
+#include <array>
+#include <memory>
+#include <vector>
+
+// VOTCA includes
+#include <votca/csg/boundarycondition.h>
+
+// Local VOTCA includes
+#include "eigen.h"
+
+namespace votca {
+namespace xtp {
+
+class Segment;
+
+/**
+ * \brief Cell list over the centers of the segments of a topology
+ *
+ * The cells are built in fractional coordinates of the box, so orthorhombic
+ * and triclinic boxes are treated the same way. For open boundary conditions
+ * the bounding box of the segments is used instead and cells are not
+ * wrapped. A radius query only visits the cells which can contain a segment
+ * closer than the radius, and then checks the distances with the boundary
+ * condition of the topology, so the result is the same as looping over all
+ * segments.
+ *
+ * The grid can also be built from arbitrary positions, e.g. of polar sites,
+ * the ids are then the indices into that vector. It is immutable after
+ * construction and can be queried from several threads at once.
+ */
+class SegmentGrid {
+ public:
+  SegmentGrid(const std::vector<Segment>& segments,
+              const csg::BoundaryCondition& bc);
+
+  SegmentGrid(std::vector<Eigen::Vector3d> positions,
+              const csg::BoundaryCondition& bc);
+
+  /// ids of all segments whose center is closer than radius to pos, sorted
+  /// ascending
+  std::vector<Index> FindSegmentsWithin(const Eigen::Vector3d& pos,
+                                        double radius) const;
+
+  Index NumberOfSegments() const { return Index(positions_.size()); }
+
+  const std::array<Index, 3>& NumberOfCells() const { return ncells_; }
+
+ private:
+  Eigen::Vector3d ToFractional(const Eigen::Vector3d& pos) const;
+
+  Index CellIndex(const std::array<Index, 3>& cell) const {
+    return (cell[0] * ncells_[1] + cell[1]) * ncells_[2] + cell[2];
+  }
+
+  std::unique_ptr<csg::BoundaryCondition> bc_;
+  bool periodic_ = false;
+  Eigen::Vector3d origin_ = Eigen::Vector3d::Zero();
+  // inverse of the matrix of the cell vectors
+  Eigen::Matrix3d inv_box_ = Eigen::Matrix3d::Identity();
+  // distance between opposite faces of the box
+  Eigen::Vector3d width_ = Eigen::Vector3d::Ones();
+  std::array<Index, 3> ncells_ = {1, 1, 1};
+
+  std::vector<Eigen::Vector3d> positions_;
+  // segment ids ordered by cell, cell_start_[c] is the first entry of cell c
+  std::vector<Index> cell_segments_;
+  std::vector<Index> cell_start_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_SEGMENTGRID_H
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -20,6 +20,9 @@
 #define VOTCA_XTP_SEGMENTMAPPER_H
 
 // Standard includes
+#include <map>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 
 // VOTCA includes
@@ -48,6 +51,13 @@ class SegmentMapper {
 
   AtomContainer map(const Segment& seg, const std::string& coordfilename) const;
 
+  /// coordinate files are parsed only once per process and shared between
+  /// all mappers of the same container type, this empties that cache
+  static void ClearTemplateCache();
+
+  /// number of coordinate files currently held in the cache
+  static Index TemplateCacheSize();
+
  private:
   using mapAtom = typename AtomContainer::Atom_Type;
 
@@ -73,6 +83,14 @@ class SegmentMapper {
   std::map<std::string, std::string> mapatom_xml_;
   std::map<std::string, Seginfo> segment_info_;
 
+  // parsed coordinate files, keyed by the absolute filename
+  static std::map<std::string, std::shared_ptr<const AtomContainer>>
+      templates_;
+  static std::mutex templates_mutex_;
+
+  std::shared_ptr<const AtomContainer> getTemplate(
+      const std::string& coordfilename) const;
+
   Index FindVectorIndexFromAtomId(
       Index atomid, const std::vector<mapAtom*>& fragment_mapatoms) const;
 
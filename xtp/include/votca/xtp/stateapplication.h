@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -41,6 +41,17 @@ class StateApplication : public XtpApplication {
   virtual void ConfigCalculator() = 0;
   virtual bool EvaluateFrame(Topology& top) = 0;
 
+  /// prepares up to requested independent calculators, so that several
+  /// frames can be evaluated at the same time and returns how many are
+  /// available. The calculator used by EvaluateFrame keeps its settings.
+  virtual Index PrepareConcurrentFrames(Index) { return 1; }
+
+  /// evaluates a frame with the calculator of the given worker, the workers
+  /// are numbered from 0 to the result of PrepareConcurrentFrames-1
+  virtual bool EvaluateFrameOnWorker(Topology& top, Index) {
+    return EvaluateFrame(top);
+  }
+
   void EvaluateSpecificOptions() final;
   virtual void CheckOptions() = 0;
   void execute() final;
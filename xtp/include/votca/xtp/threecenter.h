@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -49,21 +49,64 @@ class TCMatrix {
   Eigen::MatrixXd inv_sqrt_;
 };
 
+/**
+ * \brief Three-center integrals B_P(mu,nu) = sum_Q V^{-1/2}_PQ (Q|mu nu) for
+ * RI in DFT
+ *
+ * Only shell pairs mu,nu whose Schwarz estimate sqrt((mu nu|mu nu))
+ * sqrt((P|P)) exceeds the screening threshold for some auxiliary shell are
+ * kept, for these the integrals of the insignificant auxiliary shells are not
+ * computed. For spatially extended molecules the number of kept pairs grows
+ * linearly with the number of atoms.
+ *
+ * The integrals are stored in one contiguous matrix, auxiliary functions x
+ * packed function pairs. Only shell pairs with nu <= mu are stored, each as
+ * n_mu*n_nu consecutive columns (mu fastest). So the Coulomb contractions
+ * are single matrix-vector products, and exchange can be done with
+ * matrix-matrix products on whole shell pairs.
+ */
 class TCMatrix_dft final : public TCMatrix {
  public:
   void Fill(const AOBasis& auxbasis, const AOBasis& dftbasis);
 
-  Index size() const { return Index(matrix_.size()); }
+  void setScreening(double threshold) { screening_ = threshold; }
 
-  Symmetric_Matrix& operator[](Index i) { return matrix_[i]; }
+  /// number of auxiliary functions
+  Index size() const { return auxsize_; }
 
-  const Symmetric_Matrix& operator[](Index i) const { return matrix_[i]; }
+  /// B_P for a single auxiliary function, zero for screened pairs
+  Symmetric_Matrix operator[](Index i) const;
 
- private:
-  std::vector<Symmetric_Matrix> matrix_;
+  Index NumberOfShellPairs() const { return Index(pairs_.size()); }
+  /// number of stored function pairs
+  Index PackedSize() const { return data_.cols(); }
+  Index NumberOfAllShellPairs() const { return (nshells_ + 1) * nshells_ / 2; }
 
-  void FillBlock(std::vector<Eigen::MatrixXd>& block, Index shellindex,
-                 const AOBasis& dftbasis, const AOBasis& auxbasis);
+  /// gamma_P = sum_mu,nu B_P(mu,nu) D(mu,nu)
+  Eigen::VectorXd ContractDensity(const Eigen::MatrixXd& dmat) const;
+
+  /// J(mu,nu) = sum_P B_P(mu,nu) gamma_P
+  Eigen::MatrixXd ContractAux(const Eigen::VectorXd& gamma) const;
+
+  /// Y(P + naux * k, mu) = sum_nu B_P(mu,nu) V(nu,k)
+  Eigen::MatrixXd MultiplyVectors(const Eigen::MatrixXd& V) const;
+
+ private:
+  struct ShellPair {
+    Index start1;
+    Index size1;
+    Index start2;
+    Index size2;
+    // first column in data_
+    Index offset;
+  };
+
+  std::vector<ShellPair> pairs_;
+  Eigen::MatrixXd data_;
+  Index auxsize_ = 0;
+  Index basissize_ = 0;
+  Index nshells_ = 0;
+  double screening_ = 1e-12;
 };
 
 class TCMatrix_gwbse final : public TCMatrix {
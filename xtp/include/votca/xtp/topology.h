@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -21,6 +21,10 @@
 #ifndef VOTCA_XTP_TOPOLOGY_H
 #define VOTCA_XTP_TOPOLOGY_H
 
+// Standard includes
+#include <memory>
+#include <mutex>
+
 // VOTCA includes
 #include <votca/csg/boundarycondition.h>
 #include <votca/csg/openbox.h>
@@ -34,6 +38,7 @@ namespace votca {
 namespace xtp {
 
 class Segment;
+class SegmentGrid;
 /**
  * \brief Container for segments and box
  * and atoms.
@@ -52,12 +57,23 @@ class Topology {
 
   Segment &AddSegment(std::string segment_name);
 
-  Segment &getSegment(Index id) { return segments_[id]; }
+  Segment &getSegment(Index id) {
+    ResetSegmentGrid();
+    return segments_[id];
+  }
   const Segment &getSegment(Index id) const { return segments_[id]; }
 
-  std::vector<Segment> &Segments() { return segments_; }
+  std::vector<Segment> &Segments() {
+    ResetSegmentGrid();
+    return segments_;
+  }
   const std::vector<Segment> &Segments() const { return segments_; }
 
+  /// cell list of the segment centers, built on first use and shared by all
+  /// threads working on this topology. Non-const access to the segments or
+  /// the box discards the cached grid, a returned pointer stays valid.
+  std::shared_ptr<const SegmentGrid> getSegmentGrid() const;
+
   // Periodic boundary: Can be 'open', 'orthorhombic', 'triclinic'
   Eigen::Vector3d PbShortestConnect(const Eigen::Vector3d &r1,
                                     const Eigen::Vector3d &r2) const;
@@ -94,9 +110,17 @@ class Topology {
   std::unique_ptr<csg::BoundaryCondition> bc_ = nullptr;
   QMNBList nblist_;
 
+  mutable std::shared_ptr<const SegmentGrid> segment_grid_ = nullptr;
+  mutable std::mutex segment_grid_mutex_;
+
   double time_;
   Index step_;
 
+  void ResetSegmentGrid() {
+    std::lock_guard<std::mutex> lock(segment_grid_mutex_);
+    segment_grid_.reset();
+  }
+
   csg::BoundaryCondition::eBoxtype AutoDetectBoxType(
       const Eigen::Matrix3d &box);
 
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -36,6 +36,10 @@ class Vxc_Grid {
   void GridSetup(const std::string& type, const QMMolecule& atoms,
                  const AOBasis& basis);
 
+  // forgets the atomic grids GridSetup keeps for the last geometry, so the
+  // next setup computes them from scratch
+  static void ClearAtomGridCache();
+
   std::vector<const Eigen::Vector3d*> getGridpoints() const;
   std::vector<double> getWeightedDensities() const;
   Index getGridSize() const { return totalgridsize_; }
@@ -66,13 +70,18 @@ class Vxc_Grid {
           grid);
 
   Eigen::MatrixXd CalcInverseAtomDist(const QMMolecule& atoms) const;
-  Index UpdateOrder(LebedevGrid& sphericalgridofElement, Index maxorder,
-                    std::vector<double>& PruningIntervals, double r) const;
+  std::vector<std::vector<GridContainers::Cartesian_gridpoint> >
+      CalculateAtomGrids(const std::string& type, const QMMolecule& atoms,
+                         const AOBasis& basis) const;
+
+  Index UpdateOrder(const LebedevGrid& sphericalgridofElement, Index maxorder,
+                    const std::vector<double>& PruningIntervals,
+                    double r) const;
 
   GridContainers::Cartesian_gridpoint CreateCartesianGridpoint(
       const Eigen::Vector3d& atomA_pos,
-      GridContainers::radial_grid& radial_grid,
-      GridContainers::spherical_grid& spherical_grid, Index i_rad,
+      const GridContainers::radial_grid& radial_grid,
+      const GridContainers::spherical_grid& spherical_grid, Index i_rad,
       Index i_sph) const;
 
   Eigen::VectorXd SSWpartition(const Eigen::VectorXd& rq_i,
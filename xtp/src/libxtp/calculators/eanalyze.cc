@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -46,6 +46,7 @@ void EAnalyze::ParseOptions(const tools::Property &options) {
 bool EAnalyze::Evaluate(Topology &top) {
 
   // Short-list segments according to pattern
+  seg_shortlist_.clear();
   for (Segment &seg : top.Segments()) {
     std::string seg_name = seg.getType();
     if (votca::tools::wildcmp(seg_pattern_, seg_name)) {
@@ -81,7 +82,7 @@ bool EAnalyze::Evaluate(Topology &top) {
                 << "... ... ... No segments short-listed. Skip ... "
                 << std::flush;
     } else {
-      SiteHist(state);
+      SiteHist(top, state);
       SiteCorr(top, state);
     }
 
@@ -96,7 +97,7 @@ bool EAnalyze::Evaluate(Topology &top) {
   return true;
 }
 
-void EAnalyze::SiteHist(QMStateType state) const {
+void EAnalyze::SiteHist(const Topology &top, QMStateType state) const {
 
   std::vector<double> Es;
   Es.reserve(seg_shortlist_.size());
@@ -124,13 +125,15 @@ void EAnalyze::SiteHist(QMStateType state) const {
                      "%2$4.7f MIN %3$4.7f MAX %4$4.7f") %
        AVG % STD % MIN % MAX)
           .str();
-  std::string filename = "eanalyze.sitehist_" + state.ToString() + ".out";
+  std::string filename =
+      FrameFileName("eanalyze.sitehist_" + state.ToString() + ".out", top);
   tab.set_comment(comment);
   tab.Save(filename);
 
   // Write "seg x y z energy" with atomic {x,y,z}
   if (doenergy_landscape_) {
-    std::string filename2 = "eanalyze.landscape_" + state.ToString() + ".out";
+    std::string filename2 = FrameFileName(
+        "eanalyze.landscape_" + state.ToString() + ".out", top);
     std::ofstream out;
     out.open(filename2);
     if (!out) {
@@ -158,7 +161,8 @@ void EAnalyze::PairHist(const Topology &top, QMStateType state) const {
 
   const QMNBList &nblist = top.NBList();
 
-  std::string filenamelist = "eanalyze.pairlist_" + state.ToString() + ".out";
+  std::string filenamelist =
+      FrameFileName("eanalyze.pairlist_" + state.ToString() + ".out", top);
 
   // Collect site-energy differences from neighbourlist
   std::vector<double> dE;
@@ -185,7 +189,8 @@ void EAnalyze::PairHist(const Topology &top, QMStateType state) const {
   double STD = std::sqrt(sq_sum / double(dE.size()) - AVG * AVG);
   Index BIN = Index((MAX - MIN) / resolution_pairs_ + 0.5) + 1;
 
-  std::string filename2 = "eanalyze.pairhist_" + state.ToString() + ".out";
+  std::string filename2 =
+      FrameFileName("eanalyze.pairhist_" + state.ToString() + ".out", top);
   tools::HistogramNew hist;
   hist.Initialize(MIN, MAX, BIN);
   hist.ProcessRange<std::vector<double>::iterator>(dE.begin(), dE.end());
@@ -273,7 +278,8 @@ void EAnalyze::SiteCorr(const Topology &top, QMStateType state) const {
     histC.set(bin, R, corr, ' ', std::sqrt(dcorr2));
   }
 
-  std::string filename = "eanalyze.sitecorr_" + state.ToString() + ".out";
+  std::string filename =
+      FrameFileName("eanalyze.sitecorr_" + state.ToString() + ".out", top);
   std::string comment =
       (boost::format("EANALYZE: DISTANCE[nm] SPATIAL SITE-ENERGY "
                      "CORRELATION[eV] \n # AVG "
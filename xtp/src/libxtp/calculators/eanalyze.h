@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -45,13 +45,14 @@ class EAnalyze final : public QMCalculator {
   ~EAnalyze() = default;
   bool WriteToStateFile() const { return false; }
   std::string Identify() const { return "eanalyze"; }
+  bool AllowsConcurrentFrames() const { return true; }
 
  protected:
   void ParseOptions(const tools::Property &user_options);
   bool Evaluate(Topology &top);
 
  private:
-  void SiteHist(QMStateType state) const;
+  void SiteHist(const Topology &top, QMStateType state) const;
   void PairHist(const Topology &top, QMStateType state) const;
   void SiteCorr(const Topology &top, QMStateType state) const;
 
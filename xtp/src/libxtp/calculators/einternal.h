@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -36,6 +36,7 @@ class EInternal final : public QMCalculator {
   std::string Identify() const { return "einternal"; }
 
   bool WriteToStateFile() const { return true; }
+  bool AllowsConcurrentFrames() const { return true; }
 
  protected:
   void ParseOptions(const tools::Property &user_options);
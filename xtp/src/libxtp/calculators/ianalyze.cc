@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -140,7 +140,8 @@ void IAnalyze::IHist(Topology &top, QMStateType state) {
                      "STD %2$4.7f MIN %3$4.7f MAX %4$4.7f") %
        AVG % STD % MIN % MAX)
           .str();
-  std::string filename = "ianalyze.ihist_" + state.ToString() + ".out";
+  std::string filename =
+      FrameFileName("ianalyze.ihist_" + state.ToString() + ".out", top);
   tab.set_comment(comment);
   tab.flags() = std::vector<char>(tab.size(), ' ');
   tab.Save(filename);
@@ -203,7 +204,8 @@ void IAnalyze::IRdependence(Topology &top, QMStateType state) {
     double STD = std::sqrt(sq_sum / double(vec.size()) - AVG * AVG);
     tab.set(i, thisR, AVG, ' ', STD);
   }
-  std::string filename = "ianalyze.ispatial_" + state.ToString() + ".out";
+  std::string filename =
+      FrameFileName("ianalyze.ispatial_" + state.ToString() + ".out", top);
   std::string comment =
       "# IANALYZE: SPATIAL DEPENDENCE OF log10(J2) "
       "[r[nm],log10(J)[eV^2],error]";
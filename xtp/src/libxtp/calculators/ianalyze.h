@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -33,6 +33,7 @@ class IAnalyze final : public QMCalculator {
  public:
   std::string Identify() const { return "ianalyze"; }
   bool WriteToStateFile() const { return false; }
+  bool AllowsConcurrentFrames() const { return true; }
 
  protected:
   void ParseOptions(const tools::Property &user_options);
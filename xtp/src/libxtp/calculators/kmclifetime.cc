@@ -100,20 +100,21 @@ void KMCLifetime::WriteDecayProbability(std::string filename) {
 }
 
 void KMCLifetime::ReadLifetimeFile(std::string filename) {
-  tools::Property xml;
-  xml.LoadFromXML(filename);
-  std::vector<tools::Property*> jobProps = xml.Select("lifetimes.site");
-  if (jobProps.size() != nodes_.size()) {
+  std::vector<std::pair<Index, double> > lifetimes;
+  tools::Property::StreamFromXML(
+      filename, "lifetimes.site", [&lifetimes](const tools::Property& prop) {
+        lifetimes.push_back({prop.getAttribute<Index>("id"),
+                             boost::lexical_cast<double>(prop.value())});
+      });
+  if (lifetimes.size() != nodes_.size()) {
     throw std::runtime_error(
         (boost::format("The number of sites in the topology: %i does not match "
                        "the number in the lifetimefile: %i") %
-         nodes_.size() % jobProps.size())
+         nodes_.size() % lifetimes.size())
             .str());
   }
 
-  for (tools::Property* prop : jobProps) {
-    Index site_id = prop->getAttribute<Index>("id");
-    double lifetime = boost::lexical_cast<double>(prop->value());
+  for (const auto& [site_id, lifetime] : lifetimes) {
     bool check = false;
     for (auto& node : nodes_) {
       if (node.getId() == site_id && !(node.canDecay())) {
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -37,6 +37,7 @@ class Neighborlist final : public QMCalculator {
  public:
   std::string Identify() const { return "neighborlist"; }
   bool WriteToStateFile() const { return true; }
+  bool AllowsConcurrentFrames() const { return true; }
 
  protected:
   void ParseOptions(const tools::Property& user_options);
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -134,10 +134,11 @@ bool VAverage::Evaluate(Topology& top) {
     velocities[id2] += v_12_21;
   }
 
+  std::string outputfile = FrameFileName(outputfile_, top);
   std::ofstream ofs;
-  ofs.open(outputfile_, std::ofstream::out);
+  ofs.open(outputfile, std::ofstream::out);
   if (!ofs.is_open()) {
-    throw std::runtime_error("Bad file handle: " + outputfile_);
+    throw std::runtime_error("Bad file handle: " + outputfile);
   }
   ofs << "# 1   |   2     |  3 4 5       |   6  7  8         |" << std::endl;
   ofs << "# ----|---------|--------------|-------------------|" << std::endl;
@@ -151,7 +152,7 @@ bool VAverage::Evaluate(Topology& top) {
             v.y() % v.z())
         << std::endl;
   }
-  std::cout << "Writing velocities to " << outputfile_ << std::endl;
+  std::cout << "Writing velocities to " << outputfile << std::endl;
   return true;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -101,6 +101,12 @@ void DavidsonSolver::printIterationData(
       << std::flush;
 }
 
+void DavidsonSolver::printStatistics() const {
+  XTP_LOG(Log::error, log_)
+      << TimeStamp() << " Operator applied to " << op_applications_
+      << " vectors" << std::flush;
+}
+
 void DavidsonSolver::set_matrix_type(std::string mt) {
   if (mt == "HAM") {
     this->matrix_type_ = MATRIX_TYPE::HAM;
@@ -187,23 +193,44 @@ Eigen::MatrixXd DavidsonSolver::setupInitialEigenvectors(
       Eigen::MatrixXd::Zero(Adiag_.size(), size_initial_guess);
   ArrayXl idx = DavidsonSolver::argsort(Adiag_);
 
-  switch (this->matrix_type_) {
-    case MATRIX_TYPE::SYMM:
-      /* \brief Initialize the guess eigenvector so that they 'target' the
-       * smallest diagonal elements */
-      for (Index j = 0; j < size_initial_guess; j++) {
-        guess(idx(j), j) = 1.0;
-      }
-      break;
+  Index nguess = 0;
+  if (initial_guess_.rows() == Adiag_.size()) {
+    nguess = std::min(initial_guess_.cols(), size_initial_guess);
+    guess.leftCols(nguess) = initial_guess_.leftCols(nguess);
+  }
+
+  /* the unit vectors 'target' the smallest diagonal elements, or the lowest
+   * positive ones in the non-hermitian case */
+  Index offset = (matrix_type_ == MATRIX_TYPE::HAM) ? Adiag_.size() / 2 : 0;
+  Index nunit = size_initial_guess - nguess;
+  for (Index j = 0; j < nunit; j++) {
+    guess(idx(offset + j), nguess + j) = 1.0;
+  }
 
-    case MATRIX_TYPE::HAM:
-      /* Initialize the guess eigenvector so that they 'target' the lowest
-       * positive diagonal elements */
-      Index ind0 = Adiag_.size() / 2;
-      for (Index j = 0; j < size_initial_guess; j++) {
-        guess(idx(ind0 + j), j) = 1.0;
+  if (nguess > 0) {
+    XTP_LOG(Log::error, log_)
+        << TimeStamp() << " Using " << nguess
+        << " vectors of a previous solution as initial guess" << std::flush;
+    // the unit vectors are not orthogonal to the supplied ones
+    DavidsonSolver::gramschmidt(guess, 0);
+    // nearly dependent vectors are dropped, the space is filled up again
+    // with the next unit vectors
+    Index ncandidates = Adiag_.size() - offset;
+    while (guess.cols() < size_initial_guess && nunit < ncandidates) {
+      Index nstart = guess.cols();
+      Index nadd = std::min(size_initial_guess - nstart, ncandidates - nunit);
+      guess.conservativeResize(Eigen::NoChange, nstart + nadd);
+      guess.rightCols(nadd).setZero();
+      for (Index j = 0; j < nadd; j++) {
+        guess(idx(offset + nunit + j), nstart + j) = 1.0;
       }
-      break;
+      nunit += nadd;
+      DavidsonSolver::gramschmidt(guess, nstart);
+    }
+    if (guess.cols() < size_initial_guess) {
+      throw std::runtime_error(
+          "Davidson: could not build a linearly independent initial guess");
+    }
   }
   return guess;
 }
@@ -376,8 +403,7 @@ Index DavidsonSolver::extendProjection(
     proj.V.col(oldsize + k) = w.normalized();
     k++;
   }
-  orthogonalize(proj.V, nupdate);
-  return nupdate;
+  return orthogonalize(proj.V, nupdate);
 }
 
 Eigen::MatrixXd DavidsonSolver::extract_vectors(const Eigen::MatrixXd &V,
@@ -438,46 +464,44 @@ Eigen::VectorXd DavidsonSolver::olsen(const Eigen::VectorXd &r,
   return delta;
 }
 
-void DavidsonSolver::orthogonalize(Eigen::MatrixXd &V, Index nupdate) const {
-  DavidsonSolver::gramschmidt(V, V.cols() - nupdate);
+Index DavidsonSolver::orthogonalize(Eigen::MatrixXd &V, Index nupdate) const {
+  return DavidsonSolver::gramschmidt(V, V.cols() - nupdate);
 }
 
-void DavidsonSolver::gramschmidt(Eigen::MatrixXd &Q, Index nstart) const {
+Index DavidsonSolver::gramschmidt(Eigen::MatrixXd &Q, Index nstart) const {
+  /* Block classical Gram-Schmidt: the new block is projected against the
+   * existing basis with two GEMMs and then orthonormalized by itself with a
+   * rank revealing QR. Repeating both steps once is enough for working
+   * precision, http://stoppels.blog/posts/orthogonalization-performance
+   * New directions, which are linearly dependent on the basis, are dropped.
+   * Returns the number of new vectors kept.
+   */
   Index nupdate = Q.cols() - nstart;
-  Eigen::VectorXd norms = Q.rightCols(nupdate).colwise().norm();
-  // orthogonalize with respect to already existing vectors
-  if (nstart > 0) {
-    Q.rightCols(nupdate) -=
-        Q.leftCols(nstart) *
-        (Q.leftCols(nstart).transpose() * Q.rightCols(nupdate));
-    Q.rightCols(nupdate).colwise().normalize();
-  }
-  // orthogonalize vectors to each other
-  for (Index j = nstart + 1; j < Q.cols(); ++j) {
-    Index range = j - nstart;
-    Q.col(j) -= Q.middleCols(nstart, range) *
-                (Q.middleCols(nstart, range).transpose() * Q.col(j));
-    Q.col(j).normalize();
-  }
-  // repeat again two is enough GS
-  // http://stoppels.blog/posts/orthogonalization-performance
-  if (nstart > 0) {
-    Q.rightCols(nupdate) -=
-        Q.leftCols(nstart) *
-        (Q.leftCols(nstart).transpose() * Q.rightCols(nupdate));
-    Q.rightCols(nupdate).colwise().normalize();
-  }
-
-  for (Index j = nstart + 1; j < Q.cols(); ++j) {
-    Index range = j - nstart;
-    Q.col(j) -= Q.middleCols(nstart, range) *
-                (Q.middleCols(nstart, range).transpose() * Q.col(j));
-    if (Q.col(j).norm() <= 1E-12 * norms(range)) {
-      // info_ = Eigen::ComputationInfo::NumericalIssue;
+  Eigen::MatrixXd W = Q.rightCols(nupdate);
+  double scale = W.colwise().norm().maxCoeff();
+  for (Index pass = 0; pass < 2; pass++) {
+    if (nstart > 0) {
+      W -= Q.leftCols(nstart) * (Q.leftCols(nstart).transpose() * W);
+    }
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr(W);
+    Index rank = 0;
+    if (qr.maxPivot() > 1E-12 * scale) {
+      qr.setThreshold(1E-12 * scale / qr.maxPivot());
+      rank = qr.rank();
+    }
+    if (rank == 0) {
       throw std::runtime_error("Linear dependencies in Gram-Schmidt.");
     }
-    Q.col(j).normalize();
+    W = qr.householderQ() * Eigen::MatrixXd::Identity(W.rows(), rank);
+  }
+  if (W.cols() < nupdate) {
+    XTP_LOG(Log::info, log_)
+        << TimeStamp() << " Dropped " << nupdate - W.cols()
+        << " linearly dependent correction vectors" << std::flush;
   }
+  Q.conservativeResize(Eigen::NoChange, nstart + W.cols());
+  Q.rightCols(W.cols()) = W;
+  return W.cols();
 }
 
 Eigen::MatrixXd DavidsonSolver::qr(const Eigen::MatrixXd &A) const {
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -17,10 +17,15 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 // Local VOTCA includes
 #include "votca/xtp/ERIs.h"
 #include "votca/xtp/aobasis.h"
-#include "votca/xtp/symmetric_matrix.h"
+#include "votca/xtp/profiler.h"
 namespace votca {
 namespace xtp {
 
@@ -80,48 +85,83 @@ Eigen::MatrixXd ERIs::ComputeShellBlockNorm(const Eigen::MatrixXd& dmat) const {
 Eigen::MatrixXd ERIs::CalculateERIs_3c(const Eigen::MatrixXd& DMAT) const {
   assert(threecenter_.size() > 0 &&
          "Please call Initialize before running this");
-  Eigen::MatrixXd ERIs2 = Eigen::MatrixXd::Zero(DMAT.rows(), DMAT.cols());
-  Symmetric_Matrix dmat_sym = Symmetric_Matrix(DMAT);
-#pragma omp parallel for schedule(guided) reduction(+ : ERIs2)
-  for (Index i = 0; i < threecenter_.size(); i++) {
-    const Symmetric_Matrix& threecenter = threecenter_[i];
-    // Trace over prod::DMAT,I(l)=componentwise product over
-    const double factor = threecenter.TraceofProd(dmat_sym);
-    Eigen::SelfAdjointView<Eigen::MatrixXd, Eigen::Upper> m =
-        ERIs2.selfadjointView<Eigen::Upper>();
-    threecenter.AddtoEigenUpperMatrix(m, factor);
+  // two matrix-vector products with the packed integrals
+  ProfileScope profile(
+      "ERIs::CalculateERIs_3c",
+      4.0 * double(threecenter_.size()) * double(threecenter_.PackedSize()));
+  return threecenter_.ContractAux(threecenter_.ContractDensity(DMAT));
+}
+
+Eigen::MatrixXd ERIs::ContractExchange(const Eigen::MatrixXd& vectors,
+                                       const Eigen::VectorXd& weights) const {
+  // building Y and the rank update
+  const double naux_nvec = double(threecenter_.size()) * double(weights.size());
+  ProfileScope profile(
+      "ERIs::CalculateEXX",
+      naux_nvec * (4.0 * double(threecenter_.PackedSize()) +
+                   double(vectors.rows()) * double(vectors.rows())));
+  Eigen::MatrixXd EXX = Eigen::MatrixXd::Zero(vectors.rows(), vectors.rows());
+  if (weights.size() == 0) {
+    return EXX;
+  }
+  // B is linear, so w_k Y_k^T Y_k = sign(w_k) Y(sqrt|w_k| v_k)^T Y(...),
+  // vectors with the same sign are handled together
+  const double cutoff = 1e-12 * weights.cwiseAbs().maxCoeff();
+  std::array<std::vector<Index>, 2> selected;
+  for (Index k = 0; k < weights.size(); k++) {
+    if (std::abs(weights(k)) >= cutoff) {
+      selected[weights(k) < 0].push_back(k);
+    }
+  }
+  std::array<Eigen::MatrixXd, 2> scaled;
+  for (Index sign = 0; sign < 2; sign++) {
+    scaled[sign] = Eigen::MatrixXd(vectors.rows(), selected[sign].size());
+    for (Index i = 0; i < Index(selected[sign].size()); i++) {
+      Index k = selected[sign][i];
+      scaled[sign].col(i) = std::sqrt(std::abs(weights(k))) * vectors.col(k);
+    }
   }
 
-  return ERIs2.selfadjointView<Eigen::Upper>();
+  // Y for a batch of vectors needs naux * nbasis * batchsize doubles, the
+  // batches are distributed over the threads
+  const Index nthreads = OPENMP::getMaxThreads();
+  const Index ysize = std::max(Index(1), threecenter_.size() * vectors.rows());
+  const Index max_batch = std::max(Index(1), Index(1 << 24) / ysize);
+  const Index batchsize = std::clamp(
+      (weights.size() + nthreads - 1) / nthreads, Index(1), max_batch);
+  std::vector<std::array<Index, 3>> batches;  // sign, start, size
+  for (Index sign = 0; sign < 2; sign++) {
+    for (Index start = 0; start < scaled[sign].cols(); start += batchsize) {
+      batches.push_back(
+          {sign, start, std::min(batchsize, scaled[sign].cols() - start)});
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic) reduction(+ : EXX)
+  for (Index b = 0; b < Index(batches.size()); b++) {
+    const std::array<Index, 3>& batch = batches[b];
+    const Eigen::MatrixXd Y = threecenter_.MultiplyVectors(
+        scaled[batch[0]].middleCols(batch[1], batch[2]));
+    // positive weights reduce the exchange matrix
+    const double factor = (batch[0] == 0) ? -1.0 : 1.0;
+    EXX.selfadjointView<Eigen::Lower>().rankUpdate(Y.transpose(), factor);
+  }
+  return EXX.selfadjointView<Eigen::Lower>();
 }
 
 Eigen::MatrixXd ERIs::CalculateEXX_dmat(const Eigen::MatrixXd& DMAT) const {
   assert(threecenter_.size() > 0 &&
          "Please call Initialize before running this");
-  Eigen::MatrixXd EXX = Eigen::MatrixXd::Zero(DMAT.rows(), DMAT.cols());
-
-#pragma omp parallel for schedule(guided) reduction(+ : EXX)
-  for (Index i = 0; i < threecenter_.size(); i++) {
-    const Eigen::MatrixXd threecenter = threecenter_[i].UpperMatrix();
-    EXX -= threecenter.selfadjointView<Eigen::Upper>() * DMAT *
-           threecenter.selfadjointView<Eigen::Upper>();
-  }
-  return EXX;
+  // DMAT = sum_k w_k v_k v_k^T, w_k can be negative for difference densities
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(DMAT);
+  return ContractExchange(es.eigenvectors(), es.eigenvalues());
 }
 
 Eigen::MatrixXd ERIs::CalculateEXX_mos(const Eigen::MatrixXd& occMos) const {
   assert(threecenter_.size() > 0 &&
          "Please call Initialize before running this");
-  Eigen::MatrixXd EXX = Eigen::MatrixXd::Zero(occMos.rows(), occMos.rows());
-
-#pragma omp parallel for schedule(guided) reduction(+ : EXX)
-  for (Index i = 0; i < threecenter_.size(); i++) {
-    const Eigen::MatrixXd TCxMOs_T =
-        occMos.transpose() *
-        threecenter_[i].UpperMatrix().selfadjointView<Eigen::Upper>();
-    EXX -= TCxMOs_T.transpose() * TCxMOs_T;
-  }
-  return 2 * EXX;
+  return ContractExchange(occMos,
+                          Eigen::VectorXd::Constant(occMos.cols(), 2.0));
 }
 
 }  // namespace xtp
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -17,6 +17,9 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+
 // Local VOTCA includes
 #include "votca/xtp/convergenceacc.h"
 
@@ -131,6 +134,44 @@ Eigen::MatrixXd ConvergenceAcc::Iterate(const Eigen::MatrixXd& dmat,
   return dmatout;
 }
 
+void ConvergenceAcc::ContinueHistory(const History& previous,
+                                     const Eigen::MatrixXd& deltaH0,
+                                     double deltaE0) {
+  mathist_.clear();
+  dmatHist_.clear();
+  totE_.clear();
+  diis_ = DIIS();
+  diis_.setHistLength(opt_.histlength);
+  maxerror_ = 0.0;
+  maxerrorindex_ = 0;
+
+  const Eigen::MatrixXd& S = S_->Matrix();
+  Index start =
+      std::max(Index(0), Index(previous.fock.size()) - opt_.histlength);
+  for (Index i = start; i < Index(previous.fock.size()); i++) {
+    const Eigen::MatrixXd& dmat = previous.dmats[i];
+    // F[D] only depends on the one-electron part linearly, so the old Fock
+    // matrices are exact for the new potential after this shift
+    Eigen::MatrixXd H = previous.fock[i] + deltaH0;
+    totE_.push_back(previous.energies[i] + dmat.cwiseProduct(deltaH0).sum() +
+                    deltaE0);
+    Eigen::MatrixXd errormatrix =
+        Sminusahalf.transpose() * (H * dmat * S - S * dmat * H) * Sminusahalf;
+    double error = errormatrix.cwiseAbs().maxCoeff();
+    mathist_.push_back(H);
+    dmatHist_.push_back(dmat);
+    if (opt_.maxout && error > maxerror_) {
+      maxerror_ = error;
+      maxerrorindex_ = mathist_.size() - 1;
+    }
+    diis_.Update(maxerrorindex_, errormatrix);
+  }
+  XTP_LOG(Log::info, *log_)
+      << TimeStamp() << " Continuing with " << mathist_.size()
+      << " Fock matrices of the previous SCF in the DIIS history"
+      << std::flush;
+}
+
 void ConvergenceAcc::PrintConfigOptions() const {
   XTP_LOG(Log::error, *log_)
       << TimeStamp() << " Convergence Options:" << std::flush;
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -39,6 +39,7 @@
 #include "votca/xtp/mmregion.h"
 #include "votca/xtp/orbitals.h"
 #include "votca/xtp/pmlocalization.h"
+#include "votca/xtp/profiler.h"
 
 namespace votca {
 namespace xtp {
@@ -181,7 +182,12 @@ tools::EigenSystem DFTEngine::IndependentElectronGuess(
 tools::EigenSystem DFTEngine::ModelPotentialGuess(
     const Mat_p_Energy& H0, const QMMolecule& mol,
     const Vxc_Potential<Vxc_Grid>& vxcpotential) const {
-  Eigen::MatrixXd Dmat = AtomicGuess(mol);
+  return GuessFromDensity(H0, AtomicGuess(mol), vxcpotential);
+}
+
+tools::EigenSystem DFTEngine::GuessFromDensity(
+    const Mat_p_Energy& H0, const Eigen::MatrixXd& Dmat,
+    const Vxc_Potential<Vxc_Grid>& vxcpotential) const {
   Mat_p_Energy e_vxc = vxcpotential.IntegrateVXC(Dmat);
   XTP_LOG(Log::info, *pLog_)
       << TimeStamp() << " Filled DFT Vxc matrix " << std::flush;
@@ -200,6 +206,7 @@ tools::EigenSystem DFTEngine::ModelPotentialGuess(
 }
 
 bool DFTEngine::Evaluate(Orbitals& orb) {
+  ProfileScope profile("DFTEngine::Evaluate");
   Prepare(orb);
   Mat_p_Energy H0 = SetupH0(orb.QMAtoms());
   tools::EigenSystem MOs;
@@ -208,7 +215,22 @@ bool DFTEngine::Evaluate(Orbitals& orb) {
   Vxc_Potential<Vxc_Grid> vxcpotential = SetupVxc(orb.QMAtoms());
   ConfigOrbfile(orb);
 
-  if (initial_guess_ == "orbfile") {
+  bool use_history = scf_history_ != nullptr &&
+                     scf_history_->Compatible(H0.rows(), numofelectrons_);
+  if (use_history) {
+    Index order =
+        std::min(scf_history_->ExtrapolationOrder(), scf_history_->size() - 1);
+    XTP_LOG(Log::error, *pLog_)
+        << TimeStamp() << " Setup Initial Guess by extrapolating "
+        << scf_history_->size() << " previous densities with order " << order
+        << std::flush;
+    MOs = GuessFromDensity(H0, scf_history_->ExtrapolatedDensity(),
+                           vxcpotential);
+    conv_accelerator_.ContinueHistory(
+        scf_history_->DIISHistory(),
+        H0.matrix() - scf_history_->H0().matrix(),
+        H0.energy() - scf_history_->H0().energy());
+  } else if (initial_guess_ == "orbfile") {
     XTP_LOG(Log::error, *pLog_)
         << TimeStamp() << " Reading guess from orbitals object/file"
         << std::flush;
@@ -345,6 +367,11 @@ bool DFTEngine::Evaluate(Orbitals& orb) {
       orb.setQMEnergy(totenergy);
       orb.MOs() = MOs;
       CalcElDipole(orb);
+      if (scf_history_ != nullptr) {
+        scf_history_->Store(conv_accelerator_, H0,
+                            conv_accelerator_.DensityMatrix(MOs),
+                            numofelectrons_);
+      }
       break;
     } else if (this_iter == max_iter_ - 1) {
       XTP_LOG(Log::error, *pLog_)
@@ -742,6 +769,7 @@ Mat_p_Energy DFTEngine::SetupH0(const QMMolecule& mol) const {
 }
 
 void DFTEngine::SetupInvariantMatrices() {
+  ProfileScope profile("DFTEngine::SetupInvariantMatrices");
 
   dftAOoverlap_.Fill(dftbasis_);
 
@@ -761,6 +789,9 @@ void DFTEngine::SetupInvariantMatrices() {
         << TimeStamp() << " Inverted AUX Coulomb matrix, removed "
         << ERIs_.Removedfunctions() << " functions from aux basis"
         << std::flush;
+    XTP_LOG(Log::info, *pLog_)
+        << TimeStamp() << " Kept " << ERIs_.NumberOfShellPairs() << " of "
+        << ERIs_.NumberOfAllShellPairs() << " shell pairs for RI" << std::flush;
     XTP_LOG(Log::error, *pLog_)
         << TimeStamp()
         << " Setup invariant parts of Electron Repulsion integrals "
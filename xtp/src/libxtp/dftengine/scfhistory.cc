@@ -0,0 +1,62 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <stdexcept>
+
+// Local VOTCA includes
+#include "votca/xtp/scfhistory.h"
+
+namespace votca {
+namespace xtp {
+
+Eigen::MatrixXd SCFHistory::ExtrapolatedDensity() const {
+  if (dmats_.empty()) {
+    throw std::runtime_error("SCFHistory: no densities stored");
+  }
+  Index order = std::min(order_, size() - 1);
+  // the coefficients sum to one, so the number of electrons is conserved
+  switch (order) {
+    case 0:
+      return dmats_[0];
+    case 1:
+      return 2.0 * dmats_[0] - dmats_[1];
+    default:
+      return 3.0 * dmats_[0] - 3.0 * dmats_[1] + dmats_[2];
+  }
+}
+
+void SCFHistory::Store(const ConvergenceAcc& accelerator,
+                       const Mat_p_Energy& H0, const Eigen::MatrixXd& dmat,
+                       Index numofelectrons) {
+  if (!Compatible(dmat.rows(), numofelectrons)) {
+    dmats_.clear();
+  }
+  numofelectrons_ = numofelectrons;
+  dmats_.push_front(dmat);
+  while (size() > std::max(order_, Index(0)) + 1) {
+    dmats_.pop_back();
+  }
+  H0_ = H0;
+  diis_history_ = accelerator.getHistory();
+}
+
+}  // namespace xtp
+}  // namespace votca
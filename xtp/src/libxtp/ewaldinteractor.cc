@@ -0,0 +1,584 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+
+// Third party includes
+#include <boost/format.hpp>
+
+// VOTCA includes
+#include <votca/csg/orthorhombicbox.h>
+#include <votca/csg/triclinicbox.h>
+#include <votca/tools/constants.h>
+
+// Local VOTCA includes
+#include "votca/xtp/ewaldinteractor.h"
+#include "votca/xtp/segmentgrid.h"
+
+namespace votca {
+namespace xtp {
+
+namespace {
+// smallest even number >= n without prime factors larger than 5, for which
+// the FFT is fast
+Index FastMeshSize(Index n) {
+  for (Index size = std::max(n, Index(2));; size++) {
+    if (size % 2 != 0) {
+      continue;
+    }
+    Index rest = size;
+    for (Index factor : {2, 3, 5}) {
+      while (rest % factor == 0) {
+        rest /= factor;
+      }
+    }
+    if (rest == 1) {
+      return size;
+    }
+  }
+}
+
+Index Wrap(Index index, Index size) { return ((index % size) + size) % size; }
+}  // namespace
+
+EwaldInteractor::EwaldInteractor(const Eigen::Matrix3d& box, double cutoff,
+                                 double tolerance,
+                                 const eeInteractor& interactor,
+                                 const std::vector<PolarSegment>& segments,
+                                 Reciprocal method)
+    : expdamping_(interactor.getExpDamping()), cutoff_(cutoff) {
+
+  if ((box - Eigen::Matrix3d(box.diagonal().asDiagonal()))
+          .isApproxToConstant(0)) {
+    bc_ = std::make_unique<csg::OrthorhombicBox>();
+  } else {
+    bc_ = std::make_unique<csg::TriclinicBox>();
+  }
+  bc_->setBox(box);
+  volume_ = std::abs(box.determinant());
+  if (volume_ < 1e-9) {
+    throw std::runtime_error("Ewald summation needs a periodic box");
+  }
+  double min_width = std::numeric_limits<double>::max();
+  for (Index d = 0; d < 3; d++) {
+    double width =
+        volume_ / box.col((d + 1) % 3).cross(box.col((d + 2) % 3)).norm();
+    min_width = std::min(min_width, width);
+  }
+  if (cutoff_ >= 0.5 * min_width) {
+    throw std::runtime_error(
+        (boost::format("Ewald real space cutoff has to be smaller than half "
+                       "the box. Maximum allowed cutoff is %1$1.2f nm") %
+         (tools::conv::bohr2nm * 0.5 * min_width))
+            .str());
+  }
+  if (tolerance <= 0.0 || tolerance >= 1.0) {
+    throw std::runtime_error("Ewald tolerance has to be between 0 and 1");
+  }
+  // erfc(alpha*r_c) is about the tolerance
+  alpha_ = std::sqrt(-std::log(tolerance)) / cutoff_;
+
+  segment_start_.push_back(0);
+  for (const PolarSegment& seg : segments) {
+    for (const PolarSite& site : seg) {
+      if (site.getRank() > 1) {
+        throw std::runtime_error(
+            "Ewald summation is only implemented for charges and dipoles. "
+            "Site " +
+            std::to_string(site.getId()) + " of segment " + seg.getType() +
+            " has rank " + std::to_string(site.getRank()));
+      }
+      pos_.push_back(site.getPos());
+      segment_of_site_.push_back(Index(segment_start_.size()) - 1);
+      sqrt_inv_damp_.push_back(site.getSqrtInvEigenDamp());
+    }
+    segment_start_.push_back(Index(pos_.size()));
+  }
+
+  charges_ = Eigen::VectorXd::Zero(NumberOfSites());
+  dipoles_ = Eigen::Matrix3Xd::Zero(3, NumberOfSites());
+  Index index = 0;
+  for (const PolarSegment& seg : segments) {
+    for (const PolarSite& site : seg) {
+      charges_(index) = site.getCharge();
+      if (site.getRank() > 0) {
+        dipoles_.col(index) = site.Q().segment<3>(1);
+      }
+      index++;
+    }
+  }
+
+  SegmentGrid grid(pos_, *bc_);
+  neighbours_.resize(pos_.size());
+#pragma omp parallel for schedule(dynamic)
+  for (Index i = 0; i < NumberOfSites(); i++) {
+    for (Index j : grid.FindSegmentsWithin(pos_[i], cutoff_)) {
+      if (j > i) {
+        neighbours_[i].push_back(j);
+      }
+    }
+  }
+
+  SetupKVectors(tolerance);
+  if (method != Reciprocal::kvectors) {
+    SetupMesh(tolerance);
+    // operations of one field evaluation, the FFTs are counted with a
+    // prefactor of 10 for the two transforms and the complex arithmetic
+    double sites = double(NumberOfSites());
+    double points = double(mesh_.prod());
+    double cost_kvectors = 2.0 * sites * double(NumberOfKVectors());
+    double cost_mesh = 2.0 * sites * std::pow(double(spline_order_), 3) +
+                       10.0 * points * std::log2(points);
+    use_mesh_ = method == Reciprocal::mesh || cost_mesh < cost_kvectors;
+  }
+  static_field_ = Field(charges_, dipoles_, Interaction::Static);
+}
+
+void EwaldInteractor::SetupKVectors(double tolerance) {
+  const Eigen::Matrix3d& box = bc_->getBox();
+  // columns are the reciprocal vectors, a_i*b_j=2pi delta_ij
+  Eigen::Matrix3d reciprocal =
+      2.0 * tools::conv::Pi * box.inverse().transpose();
+  // exp(-k^2/(4 alpha^2)) is about the tolerance
+  double kmax = 2.0 * alpha_ * std::sqrt(-std::log(tolerance));
+  Eigen::Array3i nmax;
+  for (Index d = 0; d < 3; d++) {
+    nmax[d] = int(std::ceil(kmax * box.col(d).norm() / (2 * tools::conv::Pi)));
+  }
+  double fourpi_V = 4.0 * tools::conv::Pi / volume_;
+  // only one k of each pair k,-k is stored, hence the factor 2
+  for (int h = 0; h <= nmax[0]; h++) {
+    for (int k = -nmax[1]; k <= nmax[1]; k++) {
+      for (int l = -nmax[2]; l <= nmax[2]; l++) {
+        bool halfspace = h > 0 || k > 0 || (k == 0 && l > 0);
+        if (!halfspace) {
+          continue;
+        }
+        Eigen::Vector3d kvec = reciprocal * Eigen::Vector3d(h, k, l);
+        double k2 = kvec.squaredNorm();
+        if (k2 > kmax * kmax) {
+          continue;
+        }
+        kvectors_.push_back(kvec);
+        kprefactors_.push_back(2.0 * fourpi_V *
+                               std::exp(-0.25 * k2 / (alpha_ * alpha_)) / k2);
+      }
+    }
+  }
+
+  self_tensor_ = Eigen::Matrix3d::Zero();
+  for (Index k = 0; k < NumberOfKVectors(); k++) {
+    self_tensor_ += kprefactors_[k] * kvectors_[k] * kvectors_[k].transpose();
+  }
+  self_tensor_.diagonal().array() -=
+      4.0 * std::pow(alpha_, 3) / (3.0 * std::sqrt(tools::conv::Pi));
+}
+
+void EwaldInteractor::SplineWeights(double u, Eigen::VectorXd& weights,
+                                    Eigen::VectorXd& derivatives) const {
+  // recursion of the cardinal B-splines, weights(k) is M_n(x+n-1-k) with x
+  // the distance of u to the mesh point below
+  const Index n = spline_order_;
+  double x = u - std::floor(u);
+  weights = Eigen::VectorXd::Zero(n);
+  derivatives = Eigen::VectorXd::Zero(n);
+  weights(0) = 1.0 - x;
+  weights(1) = x;
+  for (Index order = 3; order <= n; order++) {
+    if (order == n) {
+      // dM_n(y)/dy=M_(n-1)(y)-M_(n-1)(y-1)
+      derivatives(0) = -weights(0);
+      for (Index k = 1; k < n; k++) {
+        derivatives(k) = weights(k - 1) - weights(k);
+      }
+    }
+    double div = 1.0 / double(order - 1);
+    weights(order - 1) = div * x * weights(order - 2);
+    for (Index l = 1; l < order - 1; l++) {
+      weights(order - l - 1) =
+          div * ((x + double(l)) * weights(order - l - 2) +
+                 (double(order - l) - x) * weights(order - l - 1));
+    }
+    weights(0) = div * (1.0 - x) * weights(0);
+  }
+}
+
+void EwaldInteractor::SetupMesh(double tolerance) {
+  const double pi = tools::conv::Pi;
+  // rows are the reciprocal box vectors without the factor 2pi
+  Eigen::Matrix3d reciprocal = bc_->getBox().inverse();
+  double kmax = 2.0 * alpha_ * std::sqrt(-std::log(tolerance));
+  const double n = double(spline_order_);
+  for (Index a = 0; a < 3; a++) {
+    double b = reciprocal.row(a).norm();
+    Index nmax = Index(std::ceil(kmax / (2.0 * pi * b)));
+    // the interpolation error of mode m is about 2(m/(K-m))^n relative to
+    // its contribution, which has to stay below the tolerance for all modes
+    auto error = [&](Index K) {
+      double maxerror = 0.0;
+      for (Index m = 1; m <= nmax; m++) {
+        double weight = std::exp(-pi * pi * double(m * m) * b * b /
+                                 (alpha_ * alpha_));
+        maxerror = std::max(
+            maxerror, weight * 2.0 * std::pow(double(m) / double(K - m), n));
+      }
+      return maxerror;
+    };
+    Index K = FastMeshSize(std::max(2 * nmax + 2, spline_order_));
+    while (error(K) > tolerance) {
+      K = FastMeshSize(K + 1);
+    }
+    mesh_[a] = K;
+  }
+  mesh_map_ = mesh_.cast<double>().matrix().asDiagonal() * reciprocal;
+
+  // |b(m)|^2 of the Euler exponential splines along each box vector
+  Eigen::VectorXd M_int;
+  Eigen::VectorXd unused;
+  SplineWeights(0.0, M_int, unused);
+  std::array<Eigen::VectorXd, 3> bsquared;
+  for (Index a = 0; a < 3; a++) {
+    bsquared[a] = Eigen::VectorXd::Zero(mesh_[a]);
+    for (Index m = 0; m < mesh_[a]; m++) {
+      std::complex<double> denominator = 0.0;
+      for (Index j = 1; j < spline_order_; j++) {
+        denominator +=
+            M_int(spline_order_ - 1 - j) *
+            std::polar(1.0, 2.0 * pi * double(m * (j - 1)) / double(mesh_[a]));
+      }
+      if (std::norm(denominator) > 1e-14) {
+        bsquared[a](m) = 1.0 / std::norm(denominator);
+      }
+    }
+  }
+
+  influence_.resize(mesh_.prod());
+  for (Index g0 = 0; g0 < mesh_[0]; g0++) {
+    for (Index g1 = 0; g1 < mesh_[1]; g1++) {
+      for (Index g2 = 0; g2 < mesh_[2]; g2++) {
+        Eigen::Array<Index, 3, 1> g(g0, g1, g2);
+        Eigen::Vector3d m;
+        for (Index a = 0; a < 3; a++) {
+          m[a] = double(2 * g[a] <= mesh_[a] ? g[a] : g[a] - mesh_[a]);
+        }
+        double m2 = (reciprocal.transpose() * m).squaredNorm();
+        double value = 0.0;
+        if (m2 > 0) {
+          value = std::exp(-pi * pi * m2 / (alpha_ * alpha_)) /
+                  (pi * volume_ * m2) * bsquared[0](g0) * bsquared[1](g1) *
+                  bsquared[2](g2);
+        }
+        influence_[(g0 * mesh_[1] + g1) * mesh_[2] + g2] = value;
+      }
+    }
+  }
+}
+
+void EwaldInteractor::FFT(std::vector<std::complex<double>>& mesh,
+                          bool inverse) const {
+  Eigen::FFT<double> fft;
+  fft.SetFlag(Eigen::FFT<double>::Unscaled);
+  Eigen::Array<Index, 3, 1> stride(mesh_[1] * mesh_[2], mesh_[2], 1);
+  for (Index a = 0; a < 3; a++) {
+    Index b = (a + 1) % 3;
+    Index c = (a + 2) % 3;
+    std::vector<std::complex<double>> line(mesh_[a]);
+    std::vector<std::complex<double>> result(mesh_[a]);
+    for (Index ib = 0; ib < mesh_[b]; ib++) {
+      for (Index ic = 0; ic < mesh_[c]; ic++) {
+        Index start = ib * stride[b] + ic * stride[c];
+        for (Index k = 0; k < mesh_[a]; k++) {
+          line[k] = mesh[start + k * stride[a]];
+        }
+        if (inverse) {
+          fft.inv(result, line);
+        } else {
+          fft.fwd(result, line);
+        }
+        for (Index k = 0; k < mesh_[a]; k++) {
+          mesh[start + k * stride[a]] = result[k];
+        }
+      }
+    }
+  }
+}
+
+Eigen::Vector3d EwaldInteractor::ScreenedB(double r) const {
+  // B_n=((2n-1)B_(n-1)+(2alpha^2)^n/(alpha sqrt(pi)) exp(-alpha^2 r^2))/r^2
+  double r2 = r * r;
+  double gauss = 2.0 * alpha_ / std::sqrt(tools::conv::Pi) *
+                 std::exp(-alpha_ * alpha_ * r2);
+  Eigen::Vector3d B;
+  B[0] = std::erfc(alpha_ * r) / r;
+  B[1] = (B[0] + gauss) / r2;
+  B[2] = (3.0 * B[1] + 2.0 * alpha_ * alpha_ * gauss) / r2;
+  return B;
+}
+
+Eigen::Vector2d EwaldInteractor::TholeCorrectionB(Index i, Index j,
+                                                  double r) const {
+  // same damping as eeInteractor::FillTholeInteraction
+  Eigen::Vector2d B = Eigen::Vector2d::Zero();
+  double r3 = r * r * r;
+  double au3 = expdamping_ * r3 * sqrt_inv_damp_[i] * sqrt_inv_damp_[j];
+  if (au3 < 40) {
+    double exp_ua = std::exp(-au3);
+    B[0] = -exp_ua / r3;
+    B[1] = -3.0 * (1 + au3) * exp_ua / (r3 * r * r);
+  }
+  return B;
+}
+
+void EwaldInteractor::RealSpace(const Eigen::VectorXd& q,
+                                const Eigen::Matrix3Xd& d, Interaction type,
+                                Eigen::MatrixXd& field) const {
+  Eigen::MatrixXd result = Eigen::MatrixXd::Zero(4, NumberOfSites());
+#pragma omp parallel for schedule(dynamic) reduction(+ : result)
+  for (Index i = 0; i < NumberOfSites(); i++) {
+    for (Index j : neighbours_[i]) {
+      bool same_segment = segment_of_site_[i] == segment_of_site_[j];
+      if (type == Interaction::Static && same_segment) {
+        continue;
+      }
+      // from j to i
+      Eigen::Vector3d R = bc_->BCShortestConnection(pos_[j], pos_[i]);
+      double r = R.norm();
+      Eigen::Vector3d B = ScreenedB(r);
+      if (type == Interaction::Induced) {
+        B.tail<2>() += TholeCorrectionB(i, j, r);
+      }
+      double dj_R = d.col(j).dot(R);
+      double di_R = d.col(i).dot(R);
+      result(0, i) += q(j) * B[0] + dj_R * B[1];
+      result.col(i).tail<3>() +=
+          -q(j) * B[1] * R + B[1] * d.col(j) - B[2] * dj_R * R;
+      result(0, j) += q(i) * B[0] - di_R * B[1];
+      result.col(j).tail<3>() +=
+          q(i) * B[1] * R + B[1] * d.col(i) - B[2] * di_R * R;
+    }
+  }
+  field += result;
+}
+
+void EwaldInteractor::ReciprocalSpace(const Eigen::VectorXd& q,
+                                      const Eigen::Matrix3Xd& d,
+                                      Eigen::MatrixXd& field) const {
+  using cplx = std::complex<double>;
+  std::vector<cplx> structurefactor(kvectors_.size());
+#pragma omp parallel for schedule(static)
+  for (Index k = 0; k < NumberOfKVectors(); k++) {
+    const Eigen::Vector3d& kvec = kvectors_[k];
+    cplx S = 0.0;
+    for (Index j = 0; j < NumberOfSites(); j++) {
+      cplx amplitude(q(j), kvec.dot(d.col(j)));
+      S += amplitude * std::polar(1.0, kvec.dot(pos_[j]));
+    }
+    structurefactor[k] = S;
+  }
+
+#pragma omp parallel for schedule(static)
+  for (Index i = 0; i < NumberOfSites(); i++) {
+    for (Index k = 0; k < NumberOfKVectors(); k++) {
+      const Eigen::Vector3d& kvec = kvectors_[k];
+      cplx Z = structurefactor[k] * std::polar(1.0, -kvec.dot(pos_[i]));
+      field(0, i) += kprefactors_[k] * Z.real();
+      field.col(i).tail<3>() += kprefactors_[k] * Z.imag() * kvec;
+    }
+  }
+}
+
+void EwaldInteractor::ReciprocalSpaceMesh(const Eigen::VectorXd& q,
+                                          const Eigen::Matrix3Xd& d,
+                                          Eigen::MatrixXd& field) const {
+  const Index n = spline_order_;
+  // weights(k,3i+a) belongs to the mesh point start(a,i)+k along axis a
+  Eigen::MatrixXd weights(n, 3 * NumberOfSites());
+  Eigen::MatrixXd derivatives(n, 3 * NumberOfSites());
+  Eigen::Matrix<Index, 3, Eigen::Dynamic> start(3, NumberOfSites());
+#pragma omp parallel for schedule(static)
+  for (Index i = 0; i < NumberOfSites(); i++) {
+    Eigen::Vector3d u = mesh_map_ * pos_[i];
+    for (Index a = 0; a < 3; a++) {
+      Eigen::VectorXd w;
+      Eigen::VectorXd dw;
+      SplineWeights(u[a], w, dw);
+      weights.col(3 * i + a) = w;
+      derivatives.col(3 * i + a) = dw;
+      start(a, i) = Index(std::floor(u[a])) - n + 1;
+    }
+  }
+
+  // a dipole d at r is the charge distribution d*grad_r delta(.-r)
+  std::vector<double> charge(mesh_.prod(), 0.0);
+#pragma omp parallel for schedule(static)
+  for (Index i = 0; i < NumberOfSites(); i++) {
+    Eigen::Vector3d dipole = mesh_map_ * d.col(i);
+    const auto w = weights.middleCols<3>(3 * i);
+    const auto dw = derivatives.middleCols<3>(3 * i);
+    for (Index k0 = 0; k0 < n; k0++) {
+      Index g0 = Wrap(start(0, i) + k0, mesh_[0]);
+      for (Index k1 = 0; k1 < n; k1++) {
+        Index g1 = Wrap(start(1, i) + k1, mesh_[1]);
+        for (Index k2 = 0; k2 < n; k2++) {
+          Index g2 = Wrap(start(2, i) + k2, mesh_[2]);
+          double value = q(i) * w(k0, 0) * w(k1, 1) * w(k2, 2) +
+                         dipole[0] * dw(k0, 0) * w(k1, 1) * w(k2, 2) +
+                         dipole[1] * w(k0, 0) * dw(k1, 1) * w(k2, 2) +
+                         dipole[2] * w(k0, 0) * w(k1, 1) * dw(k2, 2);
+#pragma omp atomic
+          charge[(g0 * mesh_[1] + g1) * mesh_[2] + g2] += value;
+        }
+      }
+    }
+  }
+
+  std::vector<std::complex<double>> mesh(charge.begin(), charge.end());
+  FFT(mesh, false);
+  for (Index g = 0; g < Index(mesh.size()); g++) {
+    mesh[g] *= influence_[g];
+  }
+  FFT(mesh, true);
+
+#pragma omp parallel for schedule(static)
+  for (Index i = 0; i < NumberOfSites(); i++) {
+    const auto w = weights.middleCols<3>(3 * i);
+    const auto dw = derivatives.middleCols<3>(3 * i);
+    double potential = 0.0;
+    Eigen::Vector3d gradient = Eigen::Vector3d::Zero();
+    for (Index k0 = 0; k0 < n; k0++) {
+      Index g0 = Wrap(start(0, i) + k0, mesh_[0]);
+      for (Index k1 = 0; k1 < n; k1++) {
+        Index g1 = Wrap(start(1, i) + k1, mesh_[1]);
+        for (Index k2 = 0; k2 < n; k2++) {
+          Index g2 = Wrap(start(2, i) + k2, mesh_[2]);
+          double value = mesh[(g0 * mesh_[1] + g1) * mesh_[2] + g2].real();
+          potential += w(k0, 0) * w(k1, 1) * w(k2, 2) * value;
+          gradient[0] += dw(k0, 0) * w(k1, 1) * w(k2, 2) * value;
+          gradient[1] += w(k0, 0) * dw(k1, 1) * w(k2, 2) * value;
+          gradient[2] += w(k0, 0) * w(k1, 1) * dw(k2, 2) * value;
+        }
+      }
+    }
+    field(0, i) += potential;
+    field.col(i).tail<3>() += mesh_map_.transpose() * gradient;
+  }
+}
+
+void EwaldInteractor::Corrections(const Eigen::VectorXd& q,
+                                  const Eigen::Matrix3Xd& d, Interaction type,
+                                  Eigen::MatrixXd& field) const {
+  const double sqrtpi = std::sqrt(tools::conv::Pi);
+  // interaction of each site with its own screening charge
+  field.row(0) -= 2.0 * alpha_ / sqrtpi * q.transpose();
+  field.bottomRows<3>() -=
+      4.0 * alpha_ * alpha_ * alpha_ / (3.0 * sqrtpi) * d;
+  // uniform background compensating a net charge
+  field.row(0).array() -=
+      tools::conv::Pi * q.sum() / (volume_ * alpha_ * alpha_);
+
+  if (type == Interaction::Induced) {
+    return;
+  }
+  // permanent multipoles on the same segment do not interact, but the
+  // reciprocal space sum contains their smooth part erf(alpha r)/r
+  Index nsegments = Index(segment_start_.size()) - 1;
+  Eigen::MatrixXd excluded = Eigen::MatrixXd::Zero(4, NumberOfSites());
+#pragma omp parallel for schedule(dynamic) reduction(+ : excluded)
+  for (Index s = 0; s < nsegments; s++) {
+    for (Index i = segment_start_[s]; i < segment_start_[s + 1]; i++) {
+      for (Index j = segment_start_[s]; j < i; j++) {
+        Eigen::Vector3d R = bc_->BCShortestConnection(pos_[j], pos_[i]);
+        double r = R.norm();
+        double r2 = r * r;
+        Eigen::Vector3d B = ScreenedB(r);
+        B[0] = 1.0 / r - B[0];
+        B[1] = 1.0 / (r2 * r) - B[1];
+        B[2] = 3.0 / (r2 * r2 * r) - B[2];
+        double dj_R = d.col(j).dot(R);
+        double di_R = d.col(i).dot(R);
+        excluded(0, i) += q(j) * B[0] + dj_R * B[1];
+        excluded.col(i).tail<3>() +=
+            -q(j) * B[1] * R + B[1] * d.col(j) - B[2] * dj_R * R;
+        excluded(0, j) += q(i) * B[0] - di_R * B[1];
+        excluded.col(j).tail<3>() +=
+            q(i) * B[1] * R + B[1] * d.col(i) - B[2] * di_R * R;
+      }
+    }
+  }
+  field -= excluded;
+}
+
+Eigen::MatrixXd EwaldInteractor::Field(const Eigen::VectorXd& q,
+                                       const Eigen::Matrix3Xd& d,
+                                       Interaction type) const {
+  Eigen::MatrixXd field = Eigen::MatrixXd::Zero(4, NumberOfSites());
+  RealSpace(q, d, type, field);
+  if (use_mesh_) {
+    ReciprocalSpaceMesh(q, d, field);
+  } else {
+    ReciprocalSpace(q, d, field);
+  }
+  Corrections(q, d, type, field);
+  return field;
+}
+
+double EwaldInteractor::StaticEnergy() const {
+  double e = charges_.dot(static_field_.row(0).transpose());
+  e += (dipoles_.array() * static_field_.bottomRows<3>().array()).sum();
+  return 0.5 * e;
+}
+
+Eigen::VectorXd EwaldInteractor::InducedField(
+    const Eigen::VectorXd& dipoles) const {
+  Eigen::Map<const Eigen::Matrix3Xd> d(dipoles.data(), 3, NumberOfSites());
+  Eigen::MatrixXd field =
+      Field(Eigen::VectorXd::Zero(NumberOfSites()), d, Interaction::Induced);
+  Eigen::Matrix3Xd V = field.bottomRows<3>();
+  return Eigen::Map<Eigen::VectorXd>(V.data(), V.size());
+}
+
+Eigen::Matrix3d EwaldInteractor::DipoleTensor(Index i, Index j) const {
+  if (i == j) {
+    return self_tensor_;
+  }
+  Eigen::Matrix3d T = Eigen::Matrix3d::Zero();
+  Eigen::Vector3d R = bc_->BCShortestConnection(pos_[j], pos_[i]);
+  double r = R.norm();
+  if (r < cutoff_) {
+    Eigen::Vector3d B = ScreenedB(r);
+    B.tail<2>() += TholeCorrectionB(i, j, r);
+    T = -B[2] * R * R.transpose();
+    T.diagonal().array() += B[1];
+  }
+  Eigen::Vector3d rji = pos_[j] - pos_[i];
+  for (Index k = 0; k < NumberOfKVectors(); k++) {
+    const Eigen::Vector3d& kvec = kvectors_[k];
+    T += kprefactors_[k] * std::cos(kvec.dot(rji)) * kvec * kvec.transpose();
+  }
+  return T;
+}
+
+}  // namespace xtp
+}  // namespace votca
@@ -0,0 +1,126 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <cerrno>
+
+// Third party includes
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Local VOTCA includes
+#include "votca/xtp/externalprocesspool.h"
+
+namespace votca {
+namespace xtp {
+
+ExternalProcessPool& ExternalProcessPool::Instance() {
+  static ExternalProcessPool pool;
+  return pool;
+}
+
+void ExternalProcessPool::setMaxProcesses(Index max_processes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_processes_ = std::max(max_processes, Index(0));
+  slot_released_.notify_all();
+}
+
+Index ExternalProcessPool::getMaxProcesses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_processes_;
+}
+
+Index ExternalProcessPool::Running() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return running_;
+}
+
+Index ExternalProcessPool::PeakRunning() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return peak_running_;
+}
+
+void ExternalProcessPool::AcquireSlot() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  slot_released_.wait(lock, [this]() {
+    return max_processes_ == 0 || running_ < max_processes_;
+  });
+  running_++;
+  peak_running_ = std::max(peak_running_, running_);
+}
+
+void ExternalProcessPool::ReleaseSlot() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_--;
+  }
+  slot_released_.notify_one();
+}
+
+Index ExternalProcessPool::Execute(const std::string& command,
+                                   const std::string& workdir) {
+  pid_t pid = fork();
+  if (pid < 0) {
+    return -1;
+  }
+  if (pid == 0) {
+    // only async signal safe calls between fork and exec
+    if (!workdir.empty() && chdir(workdir.c_str()) != 0) {
+      _exit(127);
+    }
+    execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+    _exit(127);
+  }
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      return -1;
+    }
+  }
+  if (WIFEXITED(status)) {
+    return WEXITSTATUS(status);
+  }
+  return -1;
+}
+
+Index ExternalProcessPool::Run(const std::string& command,
+                               const std::string& workdir) {
+  AcquireSlot();
+  Index result = -1;
+  try {
+    result = Execute(command, workdir);
+  } catch (...) {
+    ReleaseSlot();
+    throw;
+  }
+  ReleaseSlot();
+  return result;
+}
+
+std::future<Index> ExternalProcessPool::Submit(const std::string& command,
+                                               const std::string& workdir) {
+  return std::async(std::launch::async, [this, command, workdir]() {
+    return Run(command, workdir);
+  });
+}
+
+}  // namespace xtp
+}  // namespace votca
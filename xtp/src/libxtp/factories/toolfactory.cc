@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -23,6 +23,7 @@
 // Local private VOTCA includes
 #include "tools/apdft.h"
 #include "tools/coupling.h"
+#include "tools/cpu_benchmark.h"
 #include "tools/densityanalysis.h"
 #include "tools/dftgwbse.h"
 #include "tools/excitoncoupling.h"
@@ -54,6 +55,7 @@ void QMToolFactory::RegisterAll(void) {
   QMTools().Register<Orb2Mol>("orb2mol");
   QMTools().Register<Orb2Fchk>("orb2fchk");
   QMTools().Register<GPUBenchmark>("gpu_benchmark");
+  QMTools().Register<CPUBenchmark>("cpu_benchmark");
 }
 
 }  // namespace xtp
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -17,6 +17,10 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
 // Local VOTCA includes
 #include "votca/xtp/gridbox.h"
 #include "votca/xtp/aobasis.h"
@@ -25,10 +29,32 @@ namespace votca {
 namespace xtp {
 
 void GridBox::FindSignificantShells(const AOBasis& basis) {
+  if (grid_pos.empty()) {
+    return;
+  }
+  // bounding sphere of the points, most shells are far away from the box and
+  // can be skipped without looking at the individual points
+  Eigen::Vector3d min = grid_pos.front();
+  Eigen::Vector3d max = grid_pos.front();
+  for (const auto& point : grid_pos) {
+    min = min.cwiseMin(point);
+    max = max.cwiseMax(point);
+  }
+  const Eigen::Vector3d center = 0.5 * (min + max);
+  double radius = 0.0;
+  for (const auto& point : grid_pos) {
+    radius = std::max(radius, (point - center).norm());
+  }
 
   for (const AOShell& store : basis) {
     const double decay = store.getMinDecay();
     const Eigen::Vector3d& shellpos = store.getPos();
+    // small safety margin, so that the exact test below decides borderline
+    // cases
+    double cutoff = std::sqrt(20.7 / decay) * (1.0 + 1e-10);
+    if ((shellpos - center).norm() - radius > cutoff) {
+      continue;
+    }
     for (const auto& point : grid_pos) {
       Eigen::Vector3d dist = shellpos - point;
       double distsq = dist.squaredNorm();
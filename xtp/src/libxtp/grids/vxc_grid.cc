@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -17,17 +17,94 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 // Local VOTCA includes
-#include "votca/xtp/vxc_grid.h"
-#include "votca/tools/NDimVector.h"
+#include "votca/xtp/aobasis.h"
 #include "votca/xtp/qmmolecule.h"
 #include "votca/xtp/radial_euler_maclaurin_rule.h"
 #include "votca/xtp/sphere_lebedev_rule.h"
-#include <votca/tools/NDimVector.h>
+#include "votca/xtp/vxc_grid.h"
 
 namespace votca {
 namespace xtp {
 
+namespace {
+
+using BoxIndex = std::array<Index, 3>;
+
+struct BoxIndexHash {
+  std::size_t operator()(const BoxIndex& index) const {
+    return std::hash<Index>()((index[0] * 73856093) ^ (index[1] * 19349663) ^
+                              (index[2] * 83492791));
+  }
+};
+
+struct ShellListHash {
+  std::size_t operator()(const std::vector<const AOShell*>& shells) const {
+    std::size_t seed = shells.size();
+    for (const AOShell* shell : shells) {
+      seed ^= std::hash<const AOShell*>()(shell) + 0x9e3779b9 + (seed << 6) +
+              (seed >> 2);
+    }
+    return seed;
+  }
+};
+
+// partitioned atomic grids of the last geometry, GridSetup calls with the
+// same grid type, basis and atom positions (e.g. DFT and the Vxc of GW in one
+// job, or the QM/MM iterations of a fixed QM region) reuse them
+struct AtomGridCache {
+  std::mutex mutex;
+  std::string type;
+  std::string basis_name;
+  Index basis_size = 0;
+  std::vector<std::string> elements;
+  std::vector<Eigen::Vector3d> positions;
+  std::vector<std::vector<GridContainers::Cartesian_gridpoint> > grid;
+
+  bool matches(const std::string& grid_type, const QMMolecule& atoms,
+               const AOBasis& basis) const {
+    if (grid_type != type || basis.Name() != basis_name ||
+        basis.AOBasisSize() != basis_size ||
+        atoms.size() != Index(elements.size())) {
+      return false;
+    }
+    for (Index i = 0; i < atoms.size(); ++i) {
+      if (atoms[i].getElement() != elements[i] ||
+          atoms[i].getPos() != positions[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+AtomGridCache& getAtomGridCache() {
+  static AtomGridCache cache;
+  return cache;
+}
+
+}  // namespace
+
+void Vxc_Grid::ClearAtomGridCache() {
+  AtomGridCache& cache = getAtomGridCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.type.clear();
+  cache.basis_name.clear();
+  cache.basis_size = 0;
+  cache.elements.clear();
+  cache.positions.clear();
+  cache.grid.clear();
+}
+
 void Vxc_Grid::SortGridpointsintoBlocks(
     const std::vector<std::vector<GridContainers::Cartesian_gridpoint> >&
         grid) {
@@ -35,37 +112,38 @@ void Vxc_Grid::SortGridpointsintoBlocks(
 
   Eigen::Array3d min =
       Eigen::Array3d::Ones() * std::numeric_limits<double>::max();
-  Eigen::Array3d max =
-      Eigen::Array3d::Ones() * std::numeric_limits<double>::min();
-
   for (const auto& atom_grid : grid) {
     for (const auto& gridpoint : atom_grid) {
-      const Eigen::Vector3d& pos = gridpoint.grid_pos;
-      max = max.max(pos.array()).eval();
-      min = min.min(pos.array()).eval();
+      min = min.min(gridpoint.grid_pos.array()).eval();
     }
   }
 
-  Eigen::Array3d molextension = max - min;
-  Eigen::Array<Index, 3, 1> numberofboxes =
-      (molextension / boxsize).ceil().cast<Index>();
-
-  tools::NDimVector<std::vector<const GridContainers::Cartesian_gridpoint*>, 3>
-      boxes(numberofboxes.x(), numberofboxes.y(), numberofboxes.z());
-
+  // only occupied boxes are stored, so memory and time do not depend on the
+  // volume of the bounding box of the molecule
+  using PointList = std::vector<const GridContainers::Cartesian_gridpoint*>;
+  std::unordered_map<BoxIndex, PointList, BoxIndexHash> boxes;
   for (const auto& atomgrid : grid) {
     for (const auto& gridpoint : atomgrid) {
-      Eigen::Array3d pos = gridpoint.grid_pos - min.matrix();
-      Eigen::Array<Index, 3, 1> index = (pos / boxsize).floor().cast<Index>();
-      boxes(index.x(), index.y(), index.z()).push_back(&gridpoint);
+      Eigen::Array3d pos = (gridpoint.grid_pos.array() - min) / boxsize;
+      // z first, so that the sorted boxes have x running fastest
+      BoxIndex index = {Index(std::floor(pos.z())), Index(std::floor(pos.y())),
+                        Index(std::floor(pos.x()))};
+      boxes[index].push_back(&gridpoint);
     }
   }
-  for (auto& box : boxes) {
-    if (box.empty()) {
-      continue;
-    }
+
+  // sorted, so that the order of the boxes does not depend on the hashing
+  std::vector<BoxIndex> occupied;
+  occupied.reserve(boxes.size());
+  for (const auto& box : boxes) {
+    occupied.push_back(box.first);
+  }
+  std::sort(occupied.begin(), occupied.end());
+
+  grid_boxes_.reserve(grid_boxes_.size() + occupied.size());
+  for (const BoxIndex& index : occupied) {
     GridBox gridbox;
-    for (const auto& point : box) {
+    for (const auto& point : boxes[index]) {
       gridbox.addGridPoint(*point);
     }
     grid_boxes_.push_back(gridbox);
@@ -75,31 +153,27 @@ void Vxc_Grid::SortGridpointsintoBlocks(
 
 void Vxc_Grid::FindSignificantShells(const AOBasis& basis) {
 
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic)
   for (Index i = 0; i < getBoxesSize(); i++) {
     grid_boxes_[i].FindSignificantShells(basis);
   }
 
+  // boxes with the same significant shells are merged, looking up the shell
+  // list in a hash map instead of comparing all pairs of boxes
   std::vector<GridBox> grid_boxes_copy;
-  // use vector of bool to indicate if a gridbox has already been merged into
-  // another
-  std::vector<bool> Merged = std::vector<bool>(grid_boxes_.size(), false);
-  for (Index i = 0; i < Index(grid_boxes_.size()); i++) {
-    if (Merged[i]) {
-      continue;
-    }
-    GridBox box = grid_boxes_[i];
+  std::unordered_map<std::vector<const AOShell*>, Index, ShellListHash>
+      box_with_shells;
+  for (const GridBox& box : grid_boxes_) {
     if (box.Shellsize() < 1) {
       continue;
     }
-    Merged[i] = true;
-    for (Index j = i + 1; j < Index(grid_boxes_.size()); j++) {
-      if (GridBox::compareGridboxes(grid_boxes_[i], grid_boxes_[j])) {
-        Merged[j] = true;
-        box.addGridBox(grid_boxes_[j]);
-      }
+    auto inserted =
+        box_with_shells.emplace(box.getShells(), Index(grid_boxes_copy.size()));
+    if (inserted.second) {
+      grid_boxes_copy.push_back(box);
+    } else {
+      grid_boxes_copy[inserted.first->second].addGridBox(box);
     }
-    grid_boxes_copy.push_back(box);
   }
 
   totalgridsize_ = 0;
@@ -107,7 +181,7 @@ void Vxc_Grid::FindSignificantShells(const AOBasis& basis) {
     totalgridsize_ += box.size();
     box.PrepareForIntegration();
   }
-  grid_boxes_ = grid_boxes_copy;
+  grid_boxes_ = std::move(grid_boxes_copy);
 }
 
 std::vector<const Eigen::Vector3d*> Vxc_Grid::getGridpoints() const {
@@ -135,8 +209,9 @@ Eigen::MatrixXd Vxc_Grid::CalcInverseAtomDist(const QMMolecule& atoms) const {
   return result + result.transpose();
 }
 
-Index Vxc_Grid::UpdateOrder(LebedevGrid& sphericalgridofElement, Index maxorder,
-                            std::vector<double>& PruningIntervals,
+Index Vxc_Grid::UpdateOrder(const LebedevGrid& sphericalgridofElement,
+                            Index maxorder,
+                            const std::vector<double>& PruningIntervals,
                             double r) const {
   Index order;
   Index maxindex = sphericalgridofElement.getIndexFromOrder(maxorder);
@@ -174,8 +249,9 @@ Index Vxc_Grid::UpdateOrder(LebedevGrid& sphericalgridofElement, Index maxorder,
 }
 
 GridContainers::Cartesian_gridpoint Vxc_Grid::CreateCartesianGridpoint(
-    const Eigen::Vector3d& atomA_pos, GridContainers::radial_grid& radial_grid,
-    GridContainers::spherical_grid& spherical_grid, Index i_rad,
+    const Eigen::Vector3d& atomA_pos,
+    const GridContainers::radial_grid& radial_grid,
+    const GridContainers::spherical_grid& spherical_grid, Index i_rad,
     Index i_sph) const {
   GridContainers::Cartesian_gridpoint gridpoint;
   double p = spherical_grid.phi[i_sph];
@@ -228,6 +304,37 @@ void Vxc_Grid::SSWpartitionAtom(
 
 void Vxc_Grid::GridSetup(const std::string& type, const QMMolecule& atoms,
                          const AOBasis& basis) {
+  std::vector<std::vector<GridContainers::Cartesian_gridpoint> > grid;
+  AtomGridCache& cache = getAtomGridCache();
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.matches(type, atoms, basis)) {
+      grid = cache.grid;
+    }
+  }
+  if (grid.empty()) {
+    grid = CalculateAtomGrids(type, atoms, basis);
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.type = type;
+    cache.basis_name = basis.Name();
+    cache.basis_size = basis.AOBasisSize();
+    cache.elements.clear();
+    cache.positions.clear();
+    for (const QMAtom& atom : atoms) {
+      cache.elements.push_back(atom.getElement());
+      cache.positions.push_back(atom.getPos());
+    }
+    cache.grid = grid;
+  }
+  SortGridpointsintoBlocks(grid);
+  FindSignificantShells(basis);
+  return;
+}
+
+std::vector<std::vector<GridContainers::Cartesian_gridpoint> >
+    Vxc_Grid::CalculateAtomGrids(const std::string& type,
+                                 const QMMolecule& atoms,
+                                 const AOBasis& basis) const {
   GridContainers initialgrids;
   // get radial grid per element
   EulerMaclaurinGrid radialgridofElement;
@@ -237,26 +344,42 @@ void Vxc_Grid::GridSetup(const std::string& type, const QMMolecule& atoms,
   initialgrids.spherical_grids =
       sphericalgridofElement.CalculateSphericalGrids(atoms, type);
 
+  // element data is looked up before the parallel loop over the atoms
+  // maximum order (= number of points) in spherical integration grid
+  std::map<std::string, Index> maxorders;
+  // for pruning of integration grid, get interval boundaries for this element
+  std::map<std::string, std::vector<double> > pruningintervals;
+  for (const QMAtom& atom : atoms) {
+    const std::string& name = atom.getElement();
+    if (maxorders.count(name) == 0) {
+      maxorders[name] = sphericalgridofElement.Type2MaxOrder(name, type);
+      pruningintervals[name] =
+          radialgridofElement.CalculatePruningIntervals(name);
+    }
+  }
+
   // for the partitioning, we need all inter-center distances later, stored in
   // matrix
   Eigen::MatrixXd Rij = CalcInverseAtomDist(atoms);
-  std::vector<std::vector<GridContainers::Cartesian_gridpoint> > grid;
+  std::vector<std::vector<GridContainers::Cartesian_gridpoint> > grid(
+      atoms.size());
 
+  // with fewer atoms than threads the loops over the gridpoints inside
+  // SSWpartitionAtom are parallelized instead
+#pragma omp parallel for schedule(dynamic) \
+    if (atoms.size() >= OPENMP::getMaxThreads())
   for (Index i_atom = 0; i_atom < atoms.size(); ++i_atom) {
     const QMAtom& atom = atoms[i_atom];
 
     const Eigen::Vector3d& atomA_pos = atom.getPos();
     const std::string& name = atom.getElement();
-    GridContainers::radial_grid radial_grid =
+    const GridContainers::radial_grid& radial_grid =
         initialgrids.radial_grids.at(name);
     GridContainers::spherical_grid spherical_grid =
         initialgrids.spherical_grids.at(name);
 
-    // maximum order (= number of points) in spherical integration grid
-    Index maxorder = sphericalgridofElement.Type2MaxOrder(name, type);
-    // for pruning of integration grid, get interval boundaries for this element
-    std::vector<double> PruningIntervals =
-        radialgridofElement.CalculatePruningIntervals(name);
+    Index maxorder = maxorders.at(name);
+    const std::vector<double>& PruningIntervals = pruningintervals.at(name);
     Index current_order = 0;
     // for each radial value
     std::vector<GridContainers::Cartesian_gridpoint> atomgrid;
@@ -282,17 +405,15 @@ void Vxc_Grid::GridSetup(const std::string& type, const QMMolecule& atoms,
 
     SSWpartitionAtom(atoms, atomgrid, i_atom, Rij);
     // now remove points from the grid with negligible weights
-    std::vector<GridContainers::Cartesian_gridpoint> atomgrid_cleanedup;
+    std::vector<GridContainers::Cartesian_gridpoint>& atomgrid_cleanedup =
+        grid[i_atom];
     for (const auto& point : atomgrid) {
       if (point.grid_weight > 1e-13) {
         atomgrid_cleanedup.push_back(point);
       }
     }
-    grid.push_back(atomgrid_cleanedup);
   }  // atoms
-  SortGridpointsintoBlocks(grid);
-  FindSignificantShells(basis);
-  return;
+  return grid;
 }
 
 Eigen::VectorXd Vxc_Grid::SSWpartition(const Eigen::VectorXd& rq_i,
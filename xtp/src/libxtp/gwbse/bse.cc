@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -132,7 +132,7 @@ tools::EigenSystem BSE::Solve_triplets_TDA() const {
 
   TripletOperator_TDA Ht(epsilon_0_inv_, Mmn_, Hqp_);
   configureBSEOperator(Ht);
-  return solve_hermitian(Ht);
+  return solve_hermitian(Ht, triplet_guess_);
 }
 
 void BSE::Solve_singlets(Orbitals& orb) const {
@@ -160,7 +160,7 @@ tools::EigenSystem BSE::Solve_singlets_TDA() const {
   configureBSEOperator(Hs);
   XTP_LOG(Log::error, log_)
       << TimeStamp() << " Setup TDA singlet hamiltonian " << flush;
-  return solve_hermitian(Hs);
+  return solve_hermitian(Hs, singlet_guess_);
 }
 
 SingletOperator_TDA BSE::getSingletOperator_TDA() const {
@@ -178,7 +178,8 @@ TripletOperator_TDA BSE::getTripletOperator_TDA() const {
 }
 
 template <typename BSE_OPERATOR>
-tools::EigenSystem BSE::solve_hermitian(BSE_OPERATOR& h) const {
+tools::EigenSystem BSE::solve_hermitian(BSE_OPERATOR& h,
+                                        const Eigen::MatrixXd& guess) const {
 
   std::chrono::time_point<std::chrono::system_clock> start =
       std::chrono::system_clock::now();
@@ -192,6 +193,7 @@ tools::EigenSystem BSE::solve_hermitian(BSE_OPERATOR& h) const {
   DS.set_size_update(opt_.davidson_update);
   DS.set_iter_max(opt_.davidson_maxiter);
   DS.set_max_search_space(10 * opt_.nmax);
+  DS.set_initial_guess(guess);
   DS.solve(h, opt_.nmax);
   result.eigenvalues() = DS.eigenvalues();
   result.eigenvectors() = DS.eigenvectors();
@@ -213,7 +215,7 @@ tools::EigenSystem BSE::Solve_singlets_BTDA() const {
   configureBSEOperator(B);
   XTP_LOG(Log::error, log_)
       << TimeStamp() << " Setup Full singlet hamiltonian " << flush;
-  return Solve_nonhermitian_Davidson(A, B);
+  return Solve_nonhermitian_Davidson(A, B, singlet_guess_);
 }
 
 tools::EigenSystem BSE::Solve_triplets_BTDA() const {
@@ -223,12 +225,13 @@ tools::EigenSystem BSE::Solve_triplets_BTDA() const {
   configureBSEOperator(B);
   XTP_LOG(Log::error, log_)
       << TimeStamp() << " Setup Full triplet hamiltonian " << flush;
-  return Solve_nonhermitian_Davidson(A, B);
+  return Solve_nonhermitian_Davidson(A, B, triplet_guess_);
 }
 
 template <typename BSE_OPERATOR_A, typename BSE_OPERATOR_B>
-tools::EigenSystem BSE::Solve_nonhermitian_Davidson(BSE_OPERATOR_A& Aop,
-                                                    BSE_OPERATOR_B& Bop) const {
+tools::EigenSystem BSE::Solve_nonhermitian_Davidson(
+    BSE_OPERATOR_A& Aop, BSE_OPERATOR_B& Bop,
+    const Eigen::MatrixXd& guess) const {
   std::chrono::time_point<std::chrono::system_clock> start =
       std::chrono::system_clock::now();
 
@@ -243,6 +246,7 @@ tools::EigenSystem BSE::Solve_nonhermitian_Davidson(BSE_OPERATOR_A& Aop,
   DS.set_iter_max(opt_.davidson_maxiter);
   DS.set_max_search_space(10 * opt_.nmax);
   DS.set_matrix_type("HAM");
+  DS.set_initial_guess(guess);
   DS.solve(Hop, opt_.nmax);
 
   // results
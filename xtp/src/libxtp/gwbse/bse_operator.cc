@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -20,6 +20,7 @@
 // Local VOTCA includes
 #include "votca/xtp/bse_operator.h"
 #include "votca/xtp/openmp_cuda.h"
+#include "votca/xtp/profiler.h"
 #include "votca/xtp/vc2index.h"
 
 namespace votca {
@@ -42,6 +43,7 @@ Eigen::MatrixXd BSE_OPERATOR<cqp, cx, cd, cd2>::matmul(
 
   static_assert(!(cd2 != 0 && cd != 0),
                 "Hamiltonian cannot contain Hd and Hd2 at the same time");
+  ProfileScope profile("BSE_OPERATOR::matmul");
 
   Index auxsize = Mmn_.auxsize();
   vc2index vc = vc2index(0, 0, bse_ctotal_);
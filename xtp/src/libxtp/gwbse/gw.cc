@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2021 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -26,6 +26,7 @@
 #include "votca/xtp/anderson_mixing.h"
 #include "votca/xtp/gw.h"
 #include "votca/xtp/newton_rapson.h"
+#include "votca/xtp/profiler.h"
 #include "votca/xtp/rpa.h"
 #include "votca/xtp/sigmafactory.h"
 
@@ -159,6 +160,14 @@ void GW::CalculateGWPerturbation() {
       dft_shifted_energies.segment(opt_.rpamin, opt_.rpamax - opt_.rpamin + 1));
   Eigen::VectorXd frequencies =
       dft_shifted_energies.segment(opt_.qpmin, qptotal_);
+  if (qp_guess_.size() == qptotal_) {
+    XTP_LOG(Log::error, log_)
+        << TimeStamp() << " Starting from guess QP energies" << std::flush;
+    frequencies = qp_guess_;
+    if (opt_.gw_sc_max_iterations > 1) {
+      rpa_.UpdateRPAInputEnergies(dft_energies_, frequencies, opt_.qpmin);
+    }
+  }
 
   Anderson mixing_;
   mixing_.Configure(opt_.gw_mixing_order, opt_.gw_mixing_alpha);
@@ -170,7 +179,10 @@ void GW::CalculateGWPerturbation() {
       XTP_LOG(Log::info, log_)
           << TimeStamp() << " Rebuilding 3c integrals" << std::flush;
     }
-    sigma_->PrepareScreening();
+    {
+      ProfileScope profile("Sigma::PrepareScreening");
+      sigma_->PrepareScreening();
+    }
     XTP_LOG(Log::info, log_)
         << TimeStamp() << " Calculated screening via RPA" << std::flush;
     XTP_LOG(Log::info, log_)
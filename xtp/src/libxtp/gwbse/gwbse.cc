@@ -1,7 +1,7 @@
 
 
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -29,6 +29,7 @@
 #include <votca/tools/constants.h>
 
 // Local VOTCA includes
+#include "votca/xtp/aomatrix.h"
 #include "votca/xtp/basisset.h"
 #include "votca/xtp/bse.h"
 #include "votca/xtp/ecpbasisset.h"
@@ -543,6 +544,68 @@ Eigen::MatrixXd GWBSE::CalculateVXC(const AOBasis& dftbasis) {
   return vxc;
 }
 
+bool GWBSE::GuessMatchesOrbitals() const {
+  if (guess_ == nullptr || !guess_->hasMOs()) {
+    return false;
+  }
+  const QMMolecule& mol = orbitals_.QMAtoms();
+  const QMMolecule& guess_mol = guess_->QMAtoms();
+  if (mol.size() != guess_mol.size() ||
+      guess_->MOs().eigenvectors().rows() !=
+          orbitals_.MOs().eigenvectors().rows()) {
+    return false;
+  }
+  for (Index i = 0; i < mol.size(); i++) {
+    if (mol[i].getElement() != guess_mol[i].getElement()) {
+      return false;
+    }
+  }
+  return guess_->getHomo() == orbitals_.getHomo();
+}
+
+// overlap <phi_i^guess|phi_j> of the guess MOs with the current MOs, the
+// basis functions of both geometries are assumed to be close enough to use
+// the AO overlap of the current geometry
+Eigen::MatrixXd GWBSE::GuessMOOverlap(const AOBasis& dftbasis) const {
+  AOOverlap overlap;
+  overlap.Fill(dftbasis);
+  return guess_->MOs().eigenvectors().transpose() * overlap.Matrix() *
+         orbitals_.MOs().eigenvectors();
+}
+
+// transforms BSE eigenvectors from the transition space of the guess MOs into
+// the one of the current MOs, X'(c',v') = sum_cv O(c,c') X(c,v) O(v,v')
+Eigen::MatrixXd GWBSE::ProjectBSEGuess(
+    const tools::EigenSystem& guess_states,
+    const Eigen::MatrixXd& mo_overlap) const {
+  Index homo = orbitals_.getHomo();
+  Index vtotal = homo - bseopt_.vmin + 1;
+  Index ctotal = bseopt_.cmax - homo;
+  Index bse_size = vtotal * ctotal;
+  const Eigen::MatrixXd O_vv =
+      mo_overlap.block(bseopt_.vmin, bseopt_.vmin, vtotal, vtotal);
+  const Eigen::MatrixXd O_cc =
+      mo_overlap.block(homo + 1, homo + 1, ctotal, ctotal);
+
+  const Eigen::MatrixXd& X = guess_states.eigenvectors();
+  const Eigen::MatrixXd& Y = guess_states.eigenvectors2();
+  bool has_Y = !bseopt_.useTDA && Y.cols() == X.cols();
+  Eigen::MatrixXd result =
+      Eigen::MatrixXd::Zero(has_Y ? 2 * bse_size : bse_size, X.cols());
+  for (Index i = 0; i < X.cols(); i++) {
+    Eigen::Map<const Eigen::MatrixXd> x(X.col(i).data(), ctotal, vtotal);
+    Eigen::Map<Eigen::MatrixXd> x_new(result.col(i).data(), ctotal, vtotal);
+    x_new = O_cc.transpose() * x * O_vv;
+    if (has_Y) {
+      Eigen::Map<const Eigen::MatrixXd> y(Y.col(i).data(), ctotal, vtotal);
+      Eigen::Map<Eigen::MatrixXd> y_new(result.col(i).data() + bse_size,
+                                        ctotal, vtotal);
+      y_new = O_cc.transpose() * y * O_vv;
+    }
+  }
+  return result;
+}
+
 bool GWBSE::Evaluate() {
 
   // set the parallelization
@@ -630,6 +693,15 @@ bool GWBSE::Evaluate() {
       << TimeStamp() << " Calculated Mmn_beta (3-center-repulsion x orbitals)  "
       << flush;
 
+  bool use_guess = GuessMatchesOrbitals();
+  Eigen::MatrixXd guess_overlap;
+  if (use_guess) {
+    guess_overlap = GuessMOOverlap(dftbasis);
+    XTP_LOG(Log::error, *pLog_)
+        << TimeStamp() << " Using results of a previous geometry as guess"
+        << flush;
+  }
+
   Eigen::MatrixXd Hqp;
   if (do_gw_) {
 
@@ -638,6 +710,17 @@ bool GWBSE::Evaluate() {
     Eigen::MatrixXd vxc = CalculateVXC(dftbasis);
     GW gw = GW(*pLog_, Mmn, vxc, orbitals_.MOs().eigenvalues());
     gw.configure(gwopt_);
+    if (use_guess && guess_->hasQPpert() &&
+        guess_->getGWAmin() == gwopt_.qpmin &&
+        guess_->getGWAmax() == gwopt_.qpmax) {
+      // transfer the QP corrections, not the absolute QP energies
+      Index qptotal = gwopt_.qpmax - gwopt_.qpmin + 1;
+      Eigen::VectorXd qp_guess =
+          orbitals_.MOs().eigenvalues().segment(gwopt_.qpmin, qptotal) +
+          guess_->QPpertEnergies() -
+          guess_->MOs().eigenvalues().segment(gwopt_.qpmin, qptotal);
+      gw.setQPGuess(qp_guess);
+    }
     gw.CalculateGWPerturbation();
 
     if (!sigma_plot_states_.empty()) {
@@ -695,6 +778,18 @@ bool GWBSE::Evaluate() {
 
     BSE bse = BSE(*pLog_, Mmn);
     bse.configure(bseopt_, orbitals_.RPAInputEnergies(), Hqp);
+    if (use_guess && guess_->getBSEvmin() == bseopt_.vmin &&
+        guess_->getBSEcmax() == bseopt_.cmax &&
+        guess_->getTDAApprox() == bseopt_.useTDA) {
+      if (do_bse_triplets_ && guess_->hasBSETriplets()) {
+        bse.setTripletGuess(
+            ProjectBSEGuess(guess_->BSETriplets(), guess_overlap));
+      }
+      if (do_bse_singlets_ && guess_->hasBSESinglets()) {
+        bse.setSingletGuess(
+            ProjectBSEGuess(guess_->BSESinglets(), guess_overlap));
+      }
+    }
 
     // store the direct contribution to the static BSE results
     Eigen::VectorXd Hd_static_contrib_triplet;
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -71,6 +71,9 @@ void GWBSEEngine::Initialize(tools::Property& options,
     throw std::runtime_error(
         "Can't do DFT in DFT embedding without localization");
   }
+  if (options.exists(".warm_start")) {
+    warm_start_ = options.get(".warm_start").as<bool>();
+  }
   // DFT log and MO file names
   MO_file_ = qmpackage_->getMOFile();
   dftlog_file_ = qmpackage_->getLogFile();
@@ -109,6 +112,7 @@ void GWBSEEngine::ExcitationEnergies(Orbitals& orbitals) {
     logger = &gwbse_engine_logger;
   }
   qmpackage_->setLog(logger);
+  bool warm_start = WarmStartPossible(orbitals);
   if (do_dft_input_) {
     // required for merged guess
     if (qmpackage_->GuessRequested() && do_guess_) {  // do not want to do an
@@ -119,7 +123,17 @@ void GWBSEEngine::ExcitationEnergies(Orbitals& orbitals) {
       orbitalsA.ReadFromCpt(guess_archiveA_);
       orbitalsB.ReadFromCpt(guess_archiveB_);
       orbitals.PrepareDimerGuess(orbitalsA, orbitalsB);
+    } else if (warm_start && qmpackage_->SupportsRestartGuess()) {
+      XTP_LOG(Log::error, *logger)
+          << "Warm start, using MOs of the previous geometry as guess" << flush;
+      orbitals.MOs() = previous_.MOs();
+      orbitals.setNumberOfAlphaElectrons(
+          previous_.getNumberOfAlphaElectrons());
+      orbitals.setNumberOfOccupiedLevels(previous_.getHomo() + 1);
+      orbitals.setECPName(previous_.getECPName());
     }
+    qmpackage_->setRestartGuess(warm_start &&
+                                qmpackage_->SupportsRestartGuess());
     qmpackage_->WriteInputFile(orbitals);
   }
   if (do_dft_run_) {
@@ -197,10 +211,17 @@ void GWBSEEngine::ExcitationEnergies(Orbitals& orbitals) {
     GWBSE gwbse = GWBSE(orbitals);
     gwbse.setLogger(logger);
     gwbse.Initialize(gwbse_options_);
+    if (warm_start) {
+      gwbse.setGuess(&previous_);
+    }
     gwbse.Evaluate();
     gwbse.addoutput(output_summary);
   }
 
+  if (warm_start_) {
+    previous_ = orbitals;
+  }
+
   // if do truncatedgwbse
   if (!logger_file_.empty()) {
     WriteLoggerToFile(logger);
@@ -208,6 +229,24 @@ void GWBSEEngine::ExcitationEnergies(Orbitals& orbitals) {
   return;
 }
 
+// the previous results are only a useful guess for the same molecule
+bool GWBSEEngine::WarmStartPossible(const Orbitals& orbitals) const {
+  if (!warm_start_ || !previous_.hasMOs()) {
+    return false;
+  }
+  const QMMolecule& mol = orbitals.QMAtoms();
+  const QMMolecule& previous_mol = previous_.QMAtoms();
+  if (mol.size() != previous_mol.size()) {
+    return false;
+  }
+  for (Index i = 0; i < mol.size(); i++) {
+    if (mol[i].getElement() != previous_mol[i].getElement()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void GWBSEEngine::WriteLoggerToFile(Logger* pLog) {
   std::ofstream ofs;
   ofs.open(logger_file_, std::ofstream::out);
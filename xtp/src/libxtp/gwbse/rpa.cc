@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2021 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -21,6 +21,7 @@
 #include "votca/xtp/rpa.h"
 #include "votca/xtp/aomatrix.h"
 #include "votca/xtp/openmp_cuda.h"
+#include "votca/xtp/profiler.h"
 #include "votca/xtp/threecenter.h"
 #include "votca/xtp/vc2index.h"
 
@@ -79,6 +80,8 @@ Eigen::MatrixXd RPA::calculate_epsilon(double frequency) const {
   const Index n_unocc = rpamax_ - lumo + 1;
   const double freq2 = frequency * frequency;
   const double eta2 = eta_ * eta_;
+  ProfileScope profile("RPA::calculate_epsilon",
+                       2.0 * double(n_occ * n_unocc) * double(size * size));
 
   OpenMP_CUDA transform;
   transform.createTemporaries(n_unocc, size);
@@ -123,6 +126,8 @@ Eigen::MatrixXd RPA::calculate_epsilon_r(std::complex<double> frequency) const {
   const Index lumo = homo_ + 1;
   const Index n_occ = lumo - rpamin_;
   const Index n_unocc = rpamax_ - lumo + 1;
+  ProfileScope profile("RPA::calculate_epsilon_r",
+                       2.0 * double(n_occ * n_unocc) * double(size * size));
   OpenMP_CUDA transform;
   transform.createTemporaries(n_unocc, size);
 #pragma omp parallel
@@ -155,6 +160,7 @@ Eigen::MatrixXd RPA::calculate_epsilon_r(std::complex<double> frequency) const {
 }
 
 RPA::rpa_eigensolution RPA::Diagonalize_H2p() const {
+  ProfileScope profile("RPA::Diagonalize_H2p");
   const Index lumo = homo_ + 1;
   const Index n_occ = lumo - rpamin_;
   const Index n_unocc = rpamax_ - lumo + 1;
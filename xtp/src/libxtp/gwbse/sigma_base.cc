@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -27,6 +27,7 @@
 #include <votca/tools/constants.h>
 
 // Local VOTCA includes
+#include "votca/xtp/profiler.h"
 #include "votca/xtp/sigma_base.h"
 #include "votca/xtp/threecenter.h"
 
@@ -34,6 +35,7 @@ namespace votca {
 namespace xtp {
 
 Eigen::MatrixXd Sigma_base::CalcExchangeMatrix() const {
+  ProfileScope profile("Sigma::CalcExchangeMatrix");
   Eigen::MatrixXd result = Eigen::MatrixXd::Zero(qptotal_, qptotal_);
   Index occlevel = opt_.homo - opt_.rpamin + 1;
   Index qpmin = opt_.qpmin - opt_.rpamin;
@@ -53,6 +55,7 @@ Eigen::MatrixXd Sigma_base::CalcExchangeMatrix() const {
 
 Eigen::VectorXd Sigma_base::CalcCorrelationDiag(
     const Eigen::VectorXd& frequencies) const {
+  ProfileScope profile("Sigma::CalcCorrelationDiag");
   Eigen::VectorXd result = Eigen::VectorXd::Zero(qptotal_);
 #pragma omp parallel for schedule(dynamic)
   for (Index gw_level = 0; gw_level < qptotal_; gw_level++) {
@@ -64,6 +67,7 @@ Eigen::VectorXd Sigma_base::CalcCorrelationDiag(
 
 Eigen::MatrixXd Sigma_base::CalcCorrelationOffDiag(
     const Eigen::VectorXd& frequencies) const {
+  ProfileScope profile("Sigma::CalcCorrelationOffDiag");
   Eigen::MatrixXd result = Eigen::MatrixXd::Zero(qptotal_, qptotal_);
 #pragma omp parallel for schedule(dynamic)
   for (Index gw_level1 = 0; gw_level1 < qptotal_; gw_level1++) {
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -108,13 +108,30 @@ void EQM::WriteLoggerToFile(const std::string& logfile, Logger& logger) {
   ofs.close();
 }
 
-Job::JobResult EQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
+class EQM::SiteJob : public PendingJob {
+ public:
+  bool Ready() const override { return !qmpackage || qmpackage->Ready(); }
+
   Orbitals orbitals;
-  Job::JobResult jres = Job::JobResult();
+  const Segment* seg = nullptr;
+  std::string segType;
+  std::string eqm_work_dir;
+  std::string frame_dir;
+  std::string orb_file;
+  std::string work_dir;
+  tools::Property job_summary;
+  tools::Property* segment_summary = nullptr;
+  Logger dft_logger{votca::Log::current_level};
+  std::unique_ptr<QMPackage> qmpackage = nullptr;
+};
+
+std::unique_ptr<EQM::SiteJob> EQM::PrepareJob(const Topology& top, Job& job,
+                                              QMThread& opThread) {
+  auto site = std::make_unique<SiteJob>();
   tools::Property job_input_ = job.getInput();
   std::vector<tools::Property*> lSegments = job_input_.Select("segment");
   Index segId = lSegments.front()->getAttribute<Index>("id");
-  std::string segType = lSegments.front()->getAttribute<std::string>("type");
+  site->segType = lSegments.front()->getAttribute<std::string>("type");
   std::string qmgeo_state = "n";
   if (lSegments.front()->exists("qm_geometry")) {
     qmgeo_state = lSegments.front()->getAttribute<std::string>("qm_geometry");
@@ -122,57 +139,92 @@ Job::JobResult EQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
 
   QMState state(qmgeo_state);
   const Segment& seg = top.getSegment(segId);
+  site->seg = &seg;
 
   Logger& pLog = opThread.getLogger();
   QMMapper mapper(pLog);
   mapper.LoadMappingFile(mapfile_);
-  orbitals.QMAtoms() = mapper.map(seg, state);
+  site->orbitals.QMAtoms() = mapper.map(seg, state);
   XTP_LOG(Log::error, pLog)
       << TimeStamp() << " Evaluating site " << seg.getId() << std::flush;
 
   // directories and files
   boost::filesystem::path arg_path;
-  std::string eqm_work_dir = "OR_FILES";
-  std::string frame_dir =
-      "frame_" + boost::lexical_cast<std::string>(top.getStep());
-  std::string orb_file =
-      (format("%1%_%2%%3%") % "molecule" % segId % ".orb").str();
+  site->eqm_work_dir = "OR_FILES";
+  site->frame_dir = "frame_" + boost::lexical_cast<std::string>(top.getStep());
+  site->orb_file = (format("%1%_%2%%3%") % "molecule" % segId % ".orb").str();
   std::string mol_dir = (format("%1%%2%%3%") % "molecule" % "_" % segId).str();
   std::string package_append = "workdir_" + Identify();
-  std::string work_dir =
-      (arg_path / eqm_work_dir / package_append / frame_dir / mol_dir)
-          .generic_string();
-
-  tools::Property job_summary;
-  tools::Property& output_summary = job_summary.add("output", "");
-  tools::Property& segment_summary = output_summary.add("segment", "");
-  std::string segName = seg.getType();
-  segId = seg.getId();
-  segment_summary.setAttribute("id", segId);
-  segment_summary.setAttribute("type", segName);
+  site->work_dir = (arg_path / site->eqm_work_dir / package_append /
+                    site->frame_dir / mol_dir)
+                       .generic_string();
+
+  tools::Property& output_summary = site->job_summary.add("output", "");
+  site->segment_summary = &output_summary.add("segment", "");
+  site->segment_summary->setAttribute("id", seg.getId());
+  site->segment_summary->setAttribute("type", seg.getType());
   if (do_dft_input_ || do_dft_run_ || do_dft_parse_) {
     XTP_LOG(Log::error, pLog) << "Running DFT" << std::flush;
-    Logger dft_logger(votca::Log::current_level);
+    Logger& dft_logger = site->dft_logger;
     dft_logger.setMultithreading(false);
     dft_logger.setPreface(Log::info, (format("\nDFT INF ...")).str());
     dft_logger.setPreface(Log::error, (format("\nDFT ERR ...")).str());
     dft_logger.setPreface(Log::warning, (format("\nDFT WAR ...")).str());
     dft_logger.setPreface(Log::debug, (format("\nDFT DBG ...")).str());
     std::string package = package_options_.get(".name").as<std::string>();
-    std::unique_ptr<QMPackage> qmpackage =
-        QMPackageFactory::QMPackages().Create(package);
-    qmpackage->setLog(&dft_logger);
-    qmpackage->setRunDir(work_dir);
-    qmpackage->Initialize(package_options_);
+    site->qmpackage = QMPackageFactory::QMPackages().Create(package);
+    site->qmpackage->setLog(&dft_logger);
+    site->qmpackage->setRunDir(site->work_dir);
+    site->qmpackage->Initialize(package_options_);
 
     // create input for DFT
     if (do_dft_input_) {
-      boost::filesystem::create_directories(work_dir);
-      qmpackage->WriteInputFile(orbitals);
+      boost::filesystem::create_directories(site->work_dir);
+      site->qmpackage->WriteInputFile(site->orbitals);
     }
+  }
+  return site;
+}
+
+Job::JobResult EQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
+  std::unique_ptr<SiteJob> site = PrepareJob(top, job, opThread);
+  if (site->qmpackage && do_dft_run_) {
+    site->qmpackage->Submit();
+  }
+  return FinishJob(*site, opThread);
+}
+
+std::unique_ptr<EQM::PendingJob> EQM::SubmitJob(const Topology& top, Job& job,
+                                                QMThread& opThread) {
+  if (!do_dft_run_) {
+    return nullptr;
+  }
+  std::unique_ptr<SiteJob> site = PrepareJob(top, job, opThread);
+  site->qmpackage->Submit();
+  return site;
+}
+
+Job::JobResult EQM::CollectJob(PendingJob& pending, QMThread& opThread) {
+  return FinishJob(dynamic_cast<SiteJob&>(pending), opThread);
+}
+
+Job::JobResult EQM::FinishJob(SiteJob& site, QMThread& opThread) {
+  Orbitals& orbitals = site.orbitals;
+  const Segment& seg = *site.seg;
+  Index segId = seg.getId();
+  const std::string& eqm_work_dir = site.eqm_work_dir;
+  const std::string& frame_dir = site.frame_dir;
+  const std::string& orb_file = site.orb_file;
+  const std::string& work_dir = site.work_dir;
+  const std::string& segType = site.segType;
+  tools::Property& segment_summary = *site.segment_summary;
+  Job::JobResult jres = Job::JobResult();
+  Logger& pLog = opThread.getLogger();
 
+  if (site.qmpackage) {
+    QMPackage& qmpackage = *site.qmpackage;
     if (do_dft_run_) {
-      bool run_dft_status = qmpackage->Run();
+      bool run_dft_status = qmpackage.Collect();
       if (!run_dft_status) {
         std::string output = "DFT run failed";
         SetJobToFailed(jres, pLog, output);
@@ -182,20 +234,20 @@ Job::JobResult EQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
 
     // parse the log/orbitals files
     if (do_dft_parse_) {
-      bool parse_log_status = qmpackage->ParseLogFile(orbitals);
+      bool parse_log_status = qmpackage.ParseLogFile(orbitals);
       if (!parse_log_status) {
         std::string output = "log incomplete; ";
         SetJobToFailed(jres, pLog, output);
         return jres;
       }
-      bool parse_orbitals_status = qmpackage->ParseMOsFile(orbitals);
+      bool parse_orbitals_status = qmpackage.ParseMOsFile(orbitals);
       if (!parse_orbitals_status) {
         std::string output = "orbfile failed; ";
         SetJobToFailed(jres, pLog, output);
         return jres;
       }
       // additionally copy *.gbw files for orca (-> iqm guess)
-      if (qmpackage->getPackageName() == "orca") {
+      if (qmpackage.getPackageName() == "orca") {
         std::string DIR = eqm_work_dir + "/molecules/" + frame_dir;
         boost::filesystem::create_directories(DIR);
         std::string gbw_file =
@@ -212,8 +264,8 @@ Job::JobResult EQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
       }
 
     }  // end of the parse orbitals/log
-    qmpackage->CleanUp();
-    WriteLoggerToFile(work_dir + "/dft.log", dft_logger);
+    qmpackage.CleanUp();
+    WriteLoggerToFile(work_dir + "/dft.log", site.dft_logger);
   }
 
   if (!do_dft_parse_ && (do_gwbse_ || do_esp_)) {
@@ -282,7 +334,7 @@ Job::JobResult EQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
   }
 
   // output of the JOB
-  jres.setOutput(job_summary);
+  jres.setOutput(site.job_summary);
   jres.setStatus(Job::COMPLETE);
 
   return jres;
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -43,6 +43,9 @@ class EQM final : public ParallelXJobCalc<std::vector<Job> > {
   std::string Identify() const { return "eqm"; }
 
   Job::JobResult EvalJob(const Topology &top, Job &job, QMThread &opThread);
+  std::unique_ptr<PendingJob> SubmitJob(const Topology &top, Job &job,
+                                        QMThread &opThread) override;
+  Job::JobResult CollectJob(PendingJob &pending, QMThread &opThread) override;
 
   void CleanUp() { ; }
   void WriteJobFile(const Topology &top);
@@ -52,6 +55,12 @@ class EQM final : public ParallelXJobCalc<std::vector<Job> > {
   void ParseSpecificOptions(const tools::Property &user_options);
 
  private:
+  // a site between writing the DFT input and parsing the DFT output
+  class SiteJob;
+  std::unique_ptr<SiteJob> PrepareJob(const Topology &top, Job &job,
+                                      QMThread &opThread);
+  Job::JobResult FinishJob(SiteJob &site, QMThread &opThread);
+
   void WriteLoggerToFile(const std::string &logfile, Logger &logger);
 
   void SetJobToFailed(Job::JobResult &jres, Logger &pLog,
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -171,10 +171,33 @@ void IQM::WriteLoggerToFile(const std::string& logfile, Logger& logger) {
   ofs.close();
 }
 
-Job::JobResult IQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
+class IQM::PairJob : public PendingJob {
+ public:
+  bool Ready() const override {
+    return failed || !qmpackage || qmpackage->Ready();
+  }
+
+  // set if the job failed before the DFT run
+  bool failed = false;
+  Job::JobResult jres;
+  Orbitals orbitalsAB;
+  Index ID_A = -1;
+  Index ID_B = -1;
+  std::string orbFileA;
+  std::string orbFileB;
+  std::string orbFileAB;
+  std::string orb_dir;
+  std::string work_dir;
+  Logger dft_logger{Log::current_level};
+  std::unique_ptr<QMPackage> qmpackage = nullptr;
+};
+
+std::unique_ptr<IQM::PairJob> IQM::PrepareJob(const Topology& top, Job& job,
+                                              QMThread& opThread) {
 
   // report back to the progress observer
-  Job::JobResult jres = Job::JobResult();
+  auto site = std::make_unique<PairJob>();
+  Job::JobResult& jres = site->jres;
 
   std::string iqm_work_dir = "OR_FILES";
   std::string eqm_work_dir = "OR_FILES";
@@ -254,7 +277,7 @@ Job::JobResult IQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
   if (linkers_.size() > 0) {
     addLinkers(segments, top);
   }
-  Orbitals orbitalsAB;
+  Orbitals& orbitalsAB = site->orbitalsAB;
   // if a pair object is available and is not linked take into account PBC,
   // otherwise write as is
   if (pair == nullptr || segments.size() > 2) {
@@ -280,20 +303,28 @@ Job::JobResult IQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
     orbitalsAB.QMAtoms().AddContainer(mapper.map(seg2, stateB));
   }
 
+  site->ID_A = ID_A;
+  site->ID_B = ID_B;
+  site->orbFileA = orbFileA;
+  site->orbFileB = orbFileB;
+  site->orbFileAB = orbFileAB;
+  site->orb_dir = orb_dir;
+  site->work_dir = work_dir;
+
   if (do_dft_input_ || do_dft_run_ || do_dft_parse_) {
     std::string qmpackage_work_dir =
         (arg_path / iqm_work_dir / package_append / frame_dir / pair_dir)
             .generic_string();
 
-    Logger dft_logger(Log::current_level);
+    Logger& dft_logger = site->dft_logger;
     dft_logger.setMultithreading(false);
     dft_logger.setPreface(Log::info, (format("\nDFT INF ...")).str());
     dft_logger.setPreface(Log::error, (format("\nDFT ERR ...")).str());
     dft_logger.setPreface(Log::warning, (format("\nDFT WAR ...")).str());
     dft_logger.setPreface(Log::debug, (format("\nDFT DBG ...")).str());
     std::string package = dftpackage_options_.get("name").as<std::string>();
-    std::unique_ptr<QMPackage> qmpackage =
-        QMPackageFactory::QMPackages().Create(package);
+    site->qmpackage = QMPackageFactory::QMPackages().Create(package);
+    QMPackage* qmpackage = site->qmpackage.get();
     qmpackage->setLog(&dft_logger);
     qmpackage->setRunDir(qmpackage_work_dir);
     qmpackage->Initialize(dftpackage_options_);
@@ -351,7 +382,8 @@ Job::JobResult IQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
             SetJobToFailed(
                 jres, pLog,
                 "Do input: failed loading orbitals from " + orbFileA);
-            return jres;
+            site->failed = true;
+            return site;
           }
 
           try {
@@ -362,7 +394,8 @@ Job::JobResult IQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
             SetJobToFailed(
                 jres, pLog,
                 "Do input: failed loading orbitals from " + orbFileB);
-            return jres;
+            site->failed = true;
+            return site;
           }
           XTP_LOG(Log::info, pLog)
               << "Constructing the guess for dimer orbitals" << std::flush;
@@ -375,10 +408,55 @@ Job::JobResult IQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
       }
       qmpackage->WriteInputFile(orbitalsAB);
     }
+  }
+  return site;
+}
+
+Job::JobResult IQM::EvalJob(const Topology& top, Job& job, QMThread& opThread) {
+  std::unique_ptr<PairJob> site = PrepareJob(top, job, opThread);
+  if (!site->failed && site->qmpackage && do_dft_run_) {
+    site->qmpackage->Submit();
+  }
+  return FinishJob(*site, opThread);
+}
+
+std::unique_ptr<IQM::PendingJob> IQM::SubmitJob(const Topology& top, Job& job,
+                                                QMThread& opThread) {
+  if (!do_dft_run_) {
+    return nullptr;
+  }
+  std::unique_ptr<PairJob> site = PrepareJob(top, job, opThread);
+  if (!site->failed) {
+    site->qmpackage->Submit();
+  }
+  return site;
+}
 
+Job::JobResult IQM::CollectJob(PendingJob& pending, QMThread& opThread) {
+  return FinishJob(dynamic_cast<PairJob&>(pending), opThread);
+}
+
+Job::JobResult IQM::FinishJob(PairJob& site, QMThread& opThread) {
+  if (site.failed) {
+    return site.jres;
+  }
+  Job::JobResult jres = Job::JobResult();
+  Logger& pLog = opThread.getLogger();
+  Orbitals& orbitalsAB = site.orbitalsAB;
+  Index ID_A = site.ID_A;
+  Index ID_B = site.ID_B;
+  const std::string& orbFileA = site.orbFileA;
+  const std::string& orbFileB = site.orbFileB;
+  const std::string& orbFileAB = site.orbFileAB;
+  const std::string& orb_dir = site.orb_dir;
+  const std::string& work_dir = site.work_dir;
+
+  if (site.qmpackage) {
+    QMPackage* qmpackage = site.qmpackage.get();
+    Logger& dft_logger = site.dft_logger;
     if (do_dft_run_) {
       XTP_LOG(Log::error, pLog) << "Running DFT" << std::flush;
-      bool run_dft_status_ = qmpackage->Run();
+      bool run_dft_status_ = qmpackage->Collect();
       if (!run_dft_status_) {
         SetJobToFailed(jres, pLog, qmpackage->getPackageName() + " run failed");
         WriteLoggerToFile(work_dir + "/dft.log", dft_logger);
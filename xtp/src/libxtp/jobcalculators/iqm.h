@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -52,6 +52,9 @@ class IQM final : public ParallelXJobCalc<std::vector<Job> > {
  public:
   std::string Identify() const { return "iqm"; }
   Job::JobResult EvalJob(const Topology& top, Job& job, QMThread& opThread);
+  std::unique_ptr<PendingJob> SubmitJob(const Topology& top, Job& job,
+                                        QMThread& opThread) override;
+  Job::JobResult CollectJob(PendingJob& pending, QMThread& opThread) override;
   void WriteJobFile(const Topology& top);
   void ReadJobFile(Topology& top);
 
@@ -59,6 +62,12 @@ class IQM final : public ParallelXJobCalc<std::vector<Job> > {
   void ParseSpecificOptions(const tools::Property& user_options);
 
  private:
+  // a pair between writing the DFT input and parsing the DFT output
+  class PairJob;
+  std::unique_ptr<PairJob> PrepareJob(const Topology& top, Job& job,
+                                      QMThread& opThread);
+  Job::JobResult FinishJob(PairJob& site, QMThread& opThread);
+
   double GetBSECouplingFromProp(const tools::Property& bseprop,
                                 const QMState& stateA, const QMState& stateB);
   double GetDFTCouplingFromProp(const tools::Property& dftprop, Index stateA,
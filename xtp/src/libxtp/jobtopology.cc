@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2021 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -29,6 +29,7 @@
 #include "votca/xtp/jobtopology.h"
 #include "votca/xtp/polarregion.h"
 #include "votca/xtp/qmregion.h"
+#include "votca/xtp/segmentgrid.h"
 #include "votca/xtp/segmentmapper.h"
 #include "votca/xtp/staticregion.h"
 #include "votca/xtp/version.h"
@@ -200,6 +201,7 @@ void JobTopology::CreateRegions(
         mol.setType("mm" + std::to_string(id));
         polarregion->push_back(mol);
       }
+      polarregion->setBox(top.getBox());
       region = std::move(polarregion);
     } else if (type == Staticdummy.identify()) {
       std::unique_ptr<StaticRegion> staticregion =
@@ -246,6 +248,30 @@ std::vector<std::vector<SegId>> JobTopology::PartitionRegions(
       std::vector<bool>(top.Segments().size(), false);
   for (const tools::Property* region_def : sorted_regions) {
 
+    // a periodic region contains all segments not used by other regions
+    bool periodic = region_def->exists("periodic") &&
+                    region_def->get("periodic").as<bool>();
+    if (periodic) {
+      if (region_def != sorted_regions.back()) {
+        throw std::runtime_error(
+            "A periodic region must have the highest id of all regions");
+      }
+      std::string seg_geometry = "n";
+      if (region_def->exists("cutoff.geometry")) {
+        seg_geometry = region_def->get("cutoff.geometry").as<std::string>();
+      }
+      std::vector<SegId> seg_ids;
+      for (Index i = 0; i < Index(processed_segments.size()); i++) {
+        if (!processed_segments[i]) {
+          seg_ids.push_back(SegId(i, seg_geometry));
+          processed_segments[i] = true;
+        }
+      }
+      explicitly_named_segs_per_region.push_back(0);
+      segids_per_region.push_back(seg_ids);
+      continue;
+    }
+
     if (!region_def->exists("segments") && !region_def->exists("cutoff")) {
       throw std::runtime_error(
           "Region definition needs either segments or a cutoff to find "
@@ -306,18 +332,16 @@ std::vector<std::vector<SegId>> JobTopology::PartitionRegions(
             "apply "
             "the cutoff");
       }
+      std::shared_ptr<const SegmentGrid> grid = top.getSegmentGrid();
       for (const SegId& segid : center) {
         const Segment& center_seg = top.getSegment(segid.Id());
-        for (const Segment& otherseg : top.Segments()) {
-          if (center_seg.getId() == otherseg.getId() ||
-              processed_segments[otherseg.getId()]) {
+        for (Index otherid :
+             grid->FindSegmentsWithin(center_seg.getPos(), cutoff)) {
+          if (center_seg.getId() == otherid || processed_segments[otherid]) {
             continue;
           }
-          if (top.PbShortestConnect(center_seg.getPos(), otherseg.getPos())
-                  .norm() < cutoff) {
-            seg_ids.push_back(SegId(otherseg.getId(), seg_geometry));
-            processed_segments[otherseg.getId()] = true;
-          }
+          seg_ids.push_back(SegId(otherid, seg_geometry));
+          processed_segments[otherid] = true;
         }
       }
     }
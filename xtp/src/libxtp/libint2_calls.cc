@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2021 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -22,6 +22,7 @@
 #include "votca/xtp/aobasis.h"
 #include "votca/xtp/aomatrix.h"
 #include "votca/xtp/openmp_cuda.h"
+#include "votca/xtp/profiler.h"
 #include "votca/xtp/threecenter.h"
 
 // include libint last otherwise it overrides eigen
@@ -257,7 +258,9 @@ void AOCoulomb::computeCoulombIntegrals(const AOBasis& aobasis) {
   }
 }
 
-Eigen::MatrixXd ERIs::ComputeSchwarzShells(const AOBasis& basis) const {
+namespace {
+// sqrt(max (ab|ab)) for all pairs of shells a,b
+Eigen::MatrixXd SchwarzEstimates(const AOBasis& basis) {
 
   Index noshells = basis.getNumofShells();
 
@@ -296,10 +299,16 @@ Eigen::MatrixXd ERIs::ComputeSchwarzShells(const AOBasis& basis) const {
   }
   return result.selfadjointView<Eigen::Upper>();
 }
+}  // namespace
+
+Eigen::MatrixXd ERIs::ComputeSchwarzShells(const AOBasis& basis) const {
+  return SchwarzEstimates(basis);
+}
 
 template <bool with_exchange>
 std::array<Eigen::MatrixXd, 2> ERIs::Compute4c(const Eigen::MatrixXd& dmat,
                                                double error) const {
+  ProfileScope profile("ERIs::Compute4c");
   assert(schwarzscreen_.rows() > 0 && schwarzscreen_.cols() > 0 &&
          "Please call Initialize_4c before running this");
   Index nthreads = OPENMP::getMaxThreads();
@@ -435,22 +444,55 @@ template std::array<Eigen::MatrixXd, 2> ERIs::Compute4c<false>(
     const Eigen::MatrixXd& dmat, double error) const;
 
 void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
+  // sqrt((P|P)) per auxiliary shell
+  Eigen::VectorXd aux_schwarz =
+      Eigen::VectorXd::Zero(auxbasis.getNumofShells());
   {
     AOCoulomb auxAOcoulomb;
     auxAOcoulomb.Fill(auxbasis);
     inv_sqrt_ = auxAOcoulomb.Pseudo_InvSqrt(1e-8);
     removedfunctions_ = auxAOcoulomb.Removedfunctions();
+    const Eigen::VectorXd diag = auxAOcoulomb.Matrix().diagonal();
+    for (Index i = 0; i < auxbasis.getNumofShells(); i++) {
+      const AOShell& shell = auxbasis.getShell(i);
+      aux_schwarz(i) = std::sqrt(
+          diag.segment(shell.getStartIndex(), shell.getNumFunc()).maxCoeff());
+    }
+  }
+  auxsize_ = auxbasis.AOBasisSize();
+  basissize_ = dftbasis.AOBasisSize();
+  nshells_ = dftbasis.getNumofShells();
+
+  std::vector<libint2::Shell> dftshells = dftbasis.GenerateLibintBasis();
+  std::vector<libint2::Shell> auxshells = auxbasis.GenerateLibintBasis();
+  std::vector<Index> shell2bf = dftbasis.getMapToBasisFunctions();
+  std::vector<Index> auxshell2bf = auxbasis.getMapToBasisFunctions();
+
+  const Eigen::MatrixXd schwarz = SchwarzEstimates(dftbasis);
+  const double max_aux = aux_schwarz.maxCoeff();
+  std::vector<std::array<Index, 2>> significant;
+  for (Index s1 = 0; s1 < nshells_; s1++) {
+    for (Index s2 = 0; s2 <= s1; s2++) {
+      if (schwarz(s1, s2) * max_aux >= screening_) {
+        significant.push_back({s1, s2});
+      }
+    }
   }
-  matrix_ = std::vector<Symmetric_Matrix>(auxbasis.AOBasisSize());
 
-#pragma omp parallel for schedule(dynamic, 4)
-  for (Index i = 0; i < auxbasis.AOBasisSize(); i++) {
-    matrix_[i] = Symmetric_Matrix(dftbasis.AOBasisSize());
+  pairs_ = std::vector<ShellPair>(significant.size());
+  Index ncols = 0;
+  for (Index p = 0; p < Index(significant.size()); p++) {
+    ShellPair& pair = pairs_[p];
+    pair.start1 = shell2bf[significant[p][0]];
+    pair.size1 = Index(dftshells[significant[p][0]].size());
+    pair.start2 = shell2bf[significant[p][1]];
+    pair.size2 = Index(dftshells[significant[p][1]].size());
+    pair.offset = ncols;
+    ncols += pair.size1 * pair.size2;
   }
+  data_ = Eigen::MatrixXd(auxsize_, ncols);
 
   Index nthreads = OPENMP::getMaxThreads();
-  std::vector<libint2::Shell> dftshells = dftbasis.GenerateLibintBasis();
-  std::vector<libint2::Shell> auxshells = auxbasis.GenerateLibintBasis();
   std::vector<libint2::Engine> engines(nthreads);
   engines[0] = libint2::Engine(
       libint2::Operator::coulomb,
@@ -461,64 +503,42 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
     engines[i] = engines[0];
   }
 
-  std::vector<Index> shell2bf = dftbasis.getMapToBasisFunctions();
-  std::vector<Index> auxshell2bf = auxbasis.getMapToBasisFunctions();
-
 #pragma omp parallel for schedule(dynamic)
-  for (Index is = dftbasis.getNumofShells() - 1; is >= 0; is--) {
-
+  for (Index p = 0; p < Index(significant.size()); p++) {
     libint2::Engine& engine = engines[OPENMP::getThreadId()];
     const libint2::Engine::target_ptr_vec& buf = engine.results();
-    const libint2::Shell& dftshell = dftshells[is];
-    Index start = shell2bf[is];
-    std::vector<Eigen::MatrixXd> block(dftshell.size());
-    for (Index i = 0; i < Index(dftshell.size()); i++) {
-      Index size = start + i + 1;
-      block[i] = Eigen::MatrixXd::Zero(auxbasis.AOBasisSize(), size);
-    }
-
-    for (Index aux = 0; aux < auxbasis.getNumofShells(); aux++) {
+    const Index s1 = significant[p][0];
+    const Index s2 = significant[p][1];
+    const libint2::Shell& shell1 = dftshells[s1];
+    const libint2::Shell& shell2 = dftshells[s2];
+    const Index n1 = Index(shell1.size());
+    const Index n2 = Index(shell2.size());
+
+    Eigen::MatrixXd raw = Eigen::MatrixXd::Zero(auxsize_, n1 * n2);
+    for (Index aux = 0; aux < Index(auxshells.size()); aux++) {
+      if (schwarz(s1, s2) * aux_schwarz(aux) < screening_) {
+        continue;
+      }
       const libint2::Shell& auxshell = auxshells[aux];
+      engine.compute2<libint2::Operator::coulomb, libint2::BraKet::xs_xx, 0>(
+          auxshell, libint2::Shell::unit(), shell1, shell2);
+      if (buf[0] == nullptr) {
+        continue;
+      }
+      Eigen::TensorMap<Eigen::Tensor<const double, 3, Eigen::RowMajor> const>
+          result(buf[0], auxshell.size(), n1, n2);
       Index aux_start = auxshell2bf[aux];
-
-      for (Index dis = 0; dis <= is; dis++) {
-
-        const libint2::Shell& shell_col = dftshells[dis];
-        Index col_start = shell2bf[dis];
-        engine.compute2<libint2::Operator::coulomb, libint2::BraKet::xs_xx, 0>(
-            auxshell, libint2::Shell::unit(), dftshell, shell_col);
-
-        if (buf[0] == nullptr) {
-          continue;
-        }
-        Eigen::TensorMap<Eigen::Tensor<const double, 3, Eigen::RowMajor> const>
-            result(buf[0], auxshell.size(), dftshell.size(), shell_col.size());
-
-        for (size_t left = 0; left < dftshell.size(); left++) {
-          for (size_t auxf = 0; auxf < auxshell.size(); auxf++) {
-            for (size_t col = 0; col < shell_col.size(); col++) {
-              // symmetry
-              if ((col_start + col) > (start + left)) {
-                break;
-              }
-              block[left](aux_start + auxf, col_start + col) =
-                  result(auxf, left, col);
-            }
+      for (Index col = 0; col < n2; col++) {
+        for (Index left = 0; left < n1; left++) {
+          for (Index auxf = 0; auxf < Index(auxshell.size()); auxf++) {
+            raw(aux_start + auxf, left + n1 * col) = result(auxf, left, col);
           }
         }
       }
     }
 
-    for (Index i = 0; i < Index(block.size()); ++i) {
-      Eigen::MatrixXd temp = inv_sqrt_ * block[i];
-      for (Index mu = 0; mu < temp.rows(); ++mu) {
-        for (Index j = 0; j < temp.cols(); ++j) {
-          matrix_[mu](i + start, j) = temp(mu, j);
-        }
-      }
-    }
+    data_.middleCols(pairs_[p].offset, n1 * n2).noalias() = inv_sqrt_ * raw;
   }
-
   return;
 }
 
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -19,6 +19,11 @@
 /// For an earlier history see ctp repo commit
 /// 77795ea591b29e664153f9404c8655ba28dc14e9
 
+// Standard includes
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 // Third party includes
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
@@ -88,15 +93,40 @@ bool ParallelXJobCalc<JobContainer>::Evaluate(const Topology &top) {
 template <typename JobContainer>
 void ParallelXJobCalc<JobContainer>::JobOperator::Run() {
   OPENMP::setMaxThreads(openmp_threads_);
+  // submitted jobs, the thread fills up to runs_per_thread_ of them before it
+  // waits, so their programs run while it prepares or parses other jobs
+  std::vector<std::pair<Job *, std::unique_ptr<PendingJob>>> pending;
+  bool jobs_left = true;
   while (true) {
-    Job *job = master_.progObs_->RequestNextJob(*this);
-
-    if (job == nullptr) {
+    if (jobs_left && Index(pending.size()) < master_.runs_per_thread_) {
+      Job *job = master_.progObs_->RequestNextJob(*this);
+      if (job != nullptr) {
+        std::unique_ptr<PendingJob> submitted = nullptr;
+        if (master_.runs_per_thread_ > 1) {
+          submitted = master_.SubmitJob(top_, *job, *this);
+        }
+        if (submitted == nullptr) {
+          Result res = this->master_.EvalJob(top_, *job, *this);
+          this->master_.progObs_->ReportJobDone(*job, res, *this);
+        } else {
+          pending.emplace_back(job, std::move(submitted));
+        }
+        continue;
+      }
+      jobs_left = false;
+    }
+    if (pending.empty()) {
       break;
-    } else {
-      Result res = this->master_.EvalJob(top_, *job, *this);
-      this->master_.progObs_->ReportJobDone(*job, res, *this);
     }
+    // finish a job whose program is done, otherwise wait for the oldest
+    auto done = std::find_if(pending.begin(), pending.end(),
+                             [](const auto &p) { return p.second->Ready(); });
+    if (done == pending.end()) {
+      done = pending.begin();
+    }
+    Result res = this->master_.CollectJob(*done->second, *this);
+    this->master_.progObs_->ReportJobDone(*done->first, res, *this);
+    pending.erase(done);
   }
 }
 
@@ -112,6 +142,15 @@ void ParallelXJobCalc<JobContainer>::ParseCommonOptions(
             << nThreads_ * openmp_threads_ << " total threads." << std::flush;
   jobfile_ = options.get(".job_file").as<std::string>();
   mapfile_ = options.get(".map_file").as<std::string>();
+  runs_per_thread_ =
+      options.ifExistsReturnElseReturnDefault<Index>(".runs_per_thread", 1);
+  if (runs_per_thread_ < 1) {
+    throw std::runtime_error("runs_per_thread has to be at least 1");
+  }
+  if (runs_per_thread_ > 1) {
+    std::cout << "\n... ... Each thread keeps up to " << runs_per_thread_
+              << " external programs running." << std::flush;
+  }
 }
 
 template <typename JobContainer>
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -18,6 +18,7 @@
  */
 
 // Standard includes
+#include <algorithm>
 #include <iomanip>
 #include <numeric>
 
@@ -36,6 +37,38 @@ void PolarRegion::Initialize(const tools::Property& prop) {
   deltaD_ = prop.get("tolerance_dipole").as<double>();
   deltaE_ = prop.get("tolerance_energy").as<double>();
   exp_damp_ = prop.get("exp_damp").as<double>();
+  if (prop.exists("periodic")) {
+    periodic_ = prop.get("periodic").as<bool>();
+  }
+  if (periodic_) {
+    ewald_cutoff_ =
+        prop.get("ewald.cutoff").as<double>() * tools::conv::nm2bohr;
+    ewald_tolerance_ = prop.get("ewald.tolerance").as<double>();
+  }
+}
+
+void PolarRegion::SetupEwald() {
+  if (ewald_ != nullptr) {
+    return;
+  }
+  eeInteractor interactor(exp_damp_);
+  ewald_ = std::make_unique<EwaldInteractor>(box_, ewald_cutoff_,
+                                             ewald_tolerance_, interactor,
+                                             segments_);
+  XTP_LOG(Log::error, log_)
+      << TimeStamp() << " Region:" << this->identify() << " " << this->getId()
+      << " is periodic, Ewald alpha=" << ewald_->Alpha() << " bohr^-1"
+      << std::flush;
+  if (ewald_->UsesMesh()) {
+    const auto& mesh = ewald_->MeshSize();
+    XTP_LOG(Log::error, log_)
+        << TimeStamp() << " Reciprocal space on a " << mesh[0] << "x"
+        << mesh[1] << "x" << mesh[2] << " particle mesh" << std::flush;
+  } else {
+    XTP_LOG(Log::error, log_)
+        << TimeStamp() << " Reciprocal space with "
+        << ewald_->NumberOfKVectors() << " k-vectors" << std::flush;
+  }
 }
 
 bool PolarRegion::Converged() const {
@@ -58,6 +91,18 @@ bool PolarRegion::Converged() const {
 
 double PolarRegion::StaticInteraction() {
 
+  if (periodic_) {
+    const Eigen::MatrixXd& field = ewald_->StaticField();
+    Index index = 0;
+    for (PolarSegment& seg : segments_) {
+      for (PolarSite& site : seg) {
+        site.V_noE() += field.block<3, 1>(1, index);
+        index++;
+      }
+    }
+    return ewald_->StaticEnergy();
+  }
+
   eeInteractor eeinteractor;
   double e = 0.0;
 #pragma omp parallel for reduction(+ : e)
@@ -76,7 +121,27 @@ double PolarRegion::StaticInteraction() {
   return 0.5 * e;
 }
 
+eeInteractor::E_terms PolarRegion::PolarEnergy_periodic() const {
+  Eigen::VectorXd x = ReadInducedDipolesFromLastIteration();
+  const Eigen::MatrixXd& field = ewald_->StaticField();
+  eeInteractor::E_terms terms;
+  terms.E_indu_indu() = 0.5 * x.dot(ewald_->InducedField(x));
+  Index index = 0;
+  for (const PolarSegment& seg : segments_) {
+    for (const PolarSite& site : seg) {
+      terms.E_indu_stat() +=
+          site.Induced_Dipole().dot(field.block<3, 1>(1, index));
+      terms.E_internal() += site.InternalEnergy();
+      index++;
+    }
+  }
+  return terms;
+}
+
 eeInteractor::E_terms PolarRegion::PolarEnergy() const {
+  if (periodic_) {
+    return PolarEnergy_periodic();
+  }
 #pragma omp declare reduction(CustomPlus              \
                               : eeInteractor::E_terms \
                               : omp_out += omp_in)
@@ -191,7 +256,7 @@ Eigen::VectorXd PolarRegion::CalcInducedDipolesViaPCG(
     }
   }
   eeInteractor interactor(exp_damp_);
-  DipoleDipoleInteraction A(interactor, segments_);
+  DipoleDipoleInteraction A(interactor, segments_, ewald_.get());
   Eigen::ConjugateGradient<DipoleDipoleInteraction, Eigen::Lower | Eigen::Upper,
                            Eigen::DiagonalPreconditioner<double>>
       cg;
@@ -218,6 +283,9 @@ Eigen::VectorXd PolarRegion::CalcInducedDipolesViaPCG(
 
 void PolarRegion::Evaluate(std::vector<std::unique_ptr<Region>>& regions) {
 
+  if (periodic_) {
+    SetupEwald();
+  }
   std::vector<double> energies = ApplyInfluenceOfOtherRegions(regions);
   Energy_terms e_contrib;
   e_contrib.E_static_ext() =
@@ -236,7 +304,9 @@ void PolarRegion::Evaluate(std::vector<std::unique_ptr<Region>>& regions) {
       << dof_polarization << " degrees of freedom." << std::flush;
 
   Eigen::VectorXd initial_induced_dipoles;
-  if (!E_hist_.filled() || segments_.size() == 1) {
+  // in a periodic region a single segment still interacts with its images
+  bool single_segment = (segments_.size() == 1 && !periodic_);
+  if (!E_hist_.filled() || single_segment) {
     initial_induced_dipoles = CalcInducedDipoleInsideSegments();
   } else {
     initial_induced_dipoles = ReadInducedDipolesFromLastIteration();
@@ -244,7 +314,7 @@ void PolarRegion::Evaluate(std::vector<std::unique_ptr<Region>>& regions) {
 
   Eigen::VectorXd x;  // if only one segment
   // it is solved exactly through the initial guess
-  if (segments_.size() != 1) {
+  if (!single_segment) {
     x = CalcInducedDipolesViaPCG(initial_induced_dipoles);
     if (!info_) {
       return;
@@ -352,10 +422,25 @@ double PolarRegion::InteractwithStaticRegion(const StaticRegion& region) {
 
 void PolarRegion::WriteToCpt(CheckpointWriter& w) const {
   MMRegion<PolarSegment>::WriteToCpt(w);
+  if (periodic_) {
+    CheckpointWriter ww = w.openChild("ewald");
+    ww(box_, "box");
+    ww(ewald_cutoff_, "cutoff");
+    ww(ewald_tolerance_, "tolerance");
+  }
 }
 
 void PolarRegion::ReadFromCpt(CheckpointReader& r) {
   MMRegion<PolarSegment>::ReadFromCpt(r);
+  std::vector<std::string> groups = r.getChildGroupNames();
+  periodic_ = std::find(groups.begin(), groups.end(), "ewald") != groups.end();
+  ewald_ = nullptr;
+  if (periodic_) {
+    CheckpointReader rr = r.openChild("ewald");
+    rr(box_, "box");
+    rr(ewald_cutoff_, "cutoff");
+    rr(ewald_tolerance_, "tolerance");
+  }
 }
 
 }  // namespace xtp
@@ -0,0 +1,128 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// Third party includes
+#include <boost/format.hpp>
+#include <sys/resource.h>
+
+// Local VOTCA includes
+#include "votca/xtp/profiler.h"
+
+namespace votca {
+namespace xtp {
+
+Profiler& Profiler::Instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+Index Profiler::PeakMemory() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  // kB on linux
+  return Index(usage.ru_maxrss);
+}
+
+void Profiler::Record(const std::string& name, double wall, double cpu,
+                      double flops, Index memory_before, Index memory_after) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Kernel& kernel = kernels_[name];
+  kernel.calls++;
+  kernel.wall += wall;
+  kernel.cpu += cpu;
+  kernel.flops += flops;
+  kernel.peak_memory = std::max(kernel.peak_memory, memory_after);
+  kernel.memory_growth += std::max(Index(0), memory_after - memory_before);
+}
+
+std::map<std::string, Profiler::Kernel> Profiler::Kernels() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return kernels_;
+}
+
+void Profiler::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  kernels_.clear();
+}
+
+std::string Profiler::Summary() const {
+  std::map<std::string, Kernel> kernels = Kernels();
+  std::vector<std::pair<std::string, Kernel>> sorted(kernels.begin(),
+                                                     kernels.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return a.second.wall > b.second.wall;
+  });
+  std::stringstream out;
+  out << boost::format("%-40s %8s %12s %12s %10s %10s") % "kernel" % "calls" %
+             "wall[s]" % "cpu[s]" % "GFLOP/s" % "peak[MB]";
+  for (const auto& [name, kernel] : sorted) {
+    double gflops =
+        (kernel.wall > 0.0) ? kernel.flops / kernel.wall * 1e-9 : 0.0;
+    out << "\n"
+        << boost::format("%-40s %8d %12.3f %12.3f %10.2f %10.1f") % name %
+               kernel.calls % kernel.wall % kernel.cpu % gflops %
+               (double(kernel.peak_memory) / 1024.0);
+  }
+  return out.str();
+}
+
+void Profiler::WriteJSON(const std::string& filename) const {
+  std::ofstream out(filename);
+  if (!out.is_open()) {
+    throw std::runtime_error("Could not open " + filename + " for writing");
+  }
+  std::map<std::string, Kernel> kernels = Kernels();
+  out << "{\n  \"kernels\": [";
+  bool first = true;
+  for (const auto& [name, kernel] : kernels) {
+    out << (first ? "\n" : ",\n");
+    first = false;
+    out << "    {\"name\": \"" << name << "\", \"calls\": " << kernel.calls
+        << ", \"wall\": " << kernel.wall << ", \"cpu\": " << kernel.cpu
+        << ", \"flops\": " << kernel.flops
+        << ", \"peak_memory_kb\": " << kernel.peak_memory
+        << ", \"memory_growth_kb\": " << kernel.memory_growth << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+void Profiler::WriteCSV(const std::string& filename) const {
+  std::ofstream out(filename);
+  if (!out.is_open()) {
+    throw std::runtime_error("Could not open " + filename + " for writing");
+  }
+  out << "name,calls,wall,cpu,flops,peak_memory_kb,memory_growth_kb\n";
+  for (const auto& [name, kernel] : Kernels()) {
+    out << name << "," << kernel.calls << "," << kernel.wall << ","
+        << kernel.cpu << "," << kernel.flops << "," << kernel.peak_memory
+        << "," << kernel.memory_growth << "\n";
+  }
+}
+
+}  // namespace xtp
+}  // namespace votca
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -17,21 +17,65 @@
  *
  */
 
-#include "votca/xtp/qmcalculator.h"
-#include "votca/xtp/eigen.h"
+// Standard includes
+#include <mutex>
+
+// Third party includes
 #include <libint2/initialize.h>
+
+// VOTCA includes
+#include <votca/tools/filesystem.h>
+
+// Local VOTCA includes
+#include "votca/xtp/eigen.h"
+#include "votca/xtp/qmcalculator.h"
+#include "votca/xtp/topology.h"
+
 namespace votca {
 namespace xtp {
+
+namespace {
+// frames can be evaluated concurrently, so libint is only finalized once the
+// last of them is done
+std::mutex libint_mutex;
+Index active_frames = 0;
+}  // namespace
+
 bool QMCalculator::EvaluateFrame(Topology& top) {
-  libint2::initialize();
+  {
+    std::lock_guard<std::mutex> lock(libint_mutex);
+    if (active_frames == 0) {
+      libint2::initialize();
+    }
+    active_frames++;
+  }
   OPENMP::setMaxThreads(nThreads_);
   std::cout << " Using " << OPENMP::getMaxThreads() << " threads" << std::flush;
   bool success = Evaluate(top);
-  libint2::finalize();
+  {
+    std::lock_guard<std::mutex> lock(libint_mutex);
+    active_frames--;
+    if (active_frames == 0) {
+      libint2::finalize();
+    }
+  }
   return success;
 }
 
 void QMCalculator::Initialize(const tools::Property& opt) { ParseOptions(opt); }
 
+std::string QMCalculator::FrameFileName(const std::string& filename,
+                                        const Topology& top) const {
+  if (!frame_unique_output_) {
+    return filename;
+  }
+  std::string step = "_step_" + std::to_string(top.getStep());
+  std::string extension = tools::filesystem::GetFileExtension(filename);
+  if (extension.empty()) {
+    return filename + step;
+  }
+  return tools::filesystem::GetFileBase(filename) + step + "." + extension;
+}
+
 }  // namespace xtp
 }  // namespace votca
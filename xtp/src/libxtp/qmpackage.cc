@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -24,6 +24,7 @@
 #include "votca/tools/getline.h"
 #include "votca/tools/globals.h"
 #include "votca/xtp/ecpaobasis.h"
+#include "votca/xtp/externalprocesspool.h"
 #include "votca/xtp/orbitals.h"
 #include "votca/xtp/qmpackage.h"
 #include "votca/xtp/qmpackagefactory.h"
@@ -39,6 +40,10 @@ void QMPackage::Initialize(const tools::Property& options) {
 
   cleanup_ = options.get("cleanup").as<std::string>();
   scratch_dir_ = options.get("scratch").as<std::string>();
+  if (options.exists("max_parallel_runs")) {
+    ExternalProcessPool::Instance().setMaxProcesses(
+        options.get("max_parallel_runs").as<Index>());
+  }
 
   options_ = options;
 
@@ -46,13 +51,27 @@ void QMPackage::Initialize(const tools::Property& options) {
 }
 
 bool QMPackage::Run() {
-  std::chrono::time_point<std::chrono::system_clock> start =
-      std::chrono::system_clock::now();
+  Submit();
+  return Collect();
+}
 
-  bool error_value = RunDFT();
+void QMPackage::Submit() {
+  submitted_ = std::chrono::system_clock::now();
+  pending_run_ = StartDFT();
+}
+
+bool QMPackage::Ready() const {
+  return !pending_run_.valid() ||
+         pending_run_.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready;
+}
+
+bool QMPackage::Collect() {
+  bool error_value =
+      pending_run_.valid() ? FinishDFT(pending_run_.get()) : RunDFT();
 
   std::chrono::duration<double> elapsed_time =
-      std::chrono::system_clock::now() - start;
+      std::chrono::system_clock::now() - submitted_;
   XTP_LOG(Log::error, *pLog_) << TimeStamp() << " DFT calculation took "
                               << elapsed_time.count() << " seconds." << flush;
   return error_value;
@@ -1,6 +1,6 @@
 
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -38,6 +38,7 @@
 #include "votca/tools/tokenizer.h"
 #include "votca/xtp/basisset.h"
 #include "votca/xtp/ecpaobasis.h"
+#include "votca/xtp/externalprocesspool.h"
 #include "votca/xtp/molden.h"
 #include "votca/xtp/orbitals.h"
 
@@ -230,7 +231,11 @@ bool Orca::WriteInputFile(const Orbitals& orbitals) {
   inp_file.open(inp_file_name_full);
   // header
   inp_file << "* xyz  " << charge_ << " " << spin_ << endl;
-  Index threads = OPENMP::getMaxThreads();
+  Index threads = options_.ifExistsReturnElseReturnDefault<Index>(
+      "cores_per_run", 0);
+  if (threads <= 0) {
+    threads = OPENMP::getMaxThreads();
+  }
   const QMMolecule& qmatoms = orbitals.QMAtoms();
   // put coordinates
   WriteCoordinates(inp_file, qmatoms);
@@ -334,30 +339,32 @@ bool Orca::WriteShellScript() {
 /**
  * Runs the Orca job.
  */
-bool Orca::RunDFT() {
+bool Orca::RunDFT() { return FinishDFT(StartDFT().get()); }
+
+/**
+ * Starts the Orca job in the background, it waits for a free slot of the
+ * process pool if max_parallel_runs programs are running already.
+ */
+std::future<Index> Orca::StartDFT() {
 
   XTP_LOG(Log::error, *pLog_) << "Running Orca job\n" << flush;
 
-  if (std::system(nullptr)) {
+  return ExternalProcessPool::Instance().Submit("sh " + shell_file_name_,
+                                                run_dir_);
+}
 
-    std::string command = "cd " + run_dir_ + "; sh " + shell_file_name_;
-    Index check = std::system(command.c_str());
-    if (check == -1) {
-      XTP_LOG(Log::error, *pLog_)
-          << input_file_name_ << " failed to start" << flush;
-      return false;
-    }
-    if (CheckLogFile()) {
-      XTP_LOG(Log::error, *pLog_) << "Finished Orca job" << flush;
-      return true;
-    } else {
-      XTP_LOG(Log::error, *pLog_) << "Orca job failed" << flush;
-    }
-  } else {
+bool Orca::FinishDFT(Index check) {
+  if (check == -1) {
     XTP_LOG(Log::error, *pLog_)
         << input_file_name_ << " failed to start" << flush;
     return false;
   }
+  if (CheckLogFile()) {
+    XTP_LOG(Log::error, *pLog_) << "Finished Orca job" << flush;
+    return true;
+  } else {
+    XTP_LOG(Log::error, *pLog_) << "Orca job failed" << flush;
+  }
 
   return true;
 }
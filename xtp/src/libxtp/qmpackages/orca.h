@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -65,6 +65,8 @@ class Orca final : public QMPackage {
 
  protected:
   void ParseSpecificOptions(const tools::Property& options) final;
+  std::future<Index> StartDFT() final;
+  bool FinishDFT(Index exit_status) final;
   const std::array<Index, 49>& ShellMulitplier() const final {
     return multipliers_;
   }
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -53,8 +53,22 @@ bool XTPDFT::WriteInputFile(const Orbitals& orbitals) {
  */
 bool XTPDFT::RunDFT() {
   DFTEngine xtpdft;
-  xtpdft.Initialize(options_);
+  tools::Property options = options_;
+  if (restart_guess_) {
+    options.set("initial_guess", "orbfile");
+  }
+  if (scf_tolerance_factor_ != 1.0) {
+    for (const char* key :
+         {"xtpdft.convergence.energy", "xtpdft.convergence.error"}) {
+      double tolerance = options.get(key).as<double>() * scf_tolerance_factor_;
+      options.set(key, (boost::format("%e") % tolerance).str());
+    }
+    XTP_LOG(Log::error, *pLog_)
+        << "SCF thresholds scaled by " << scf_tolerance_factor_ << flush;
+  }
+  xtpdft.Initialize(options);
   xtpdft.setLogger(pLog_);
+  xtpdft.setSCFHistory(scf_history_);
 
   if (!externalsites_.empty()) {
     xtpdft.setExternalcharges(&externalsites_);
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2022 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -46,6 +46,10 @@ class XTPDFT final : public QMPackage {
 
   bool WriteInputFile(const Orbitals& orbitals) final;
 
+  bool SupportsRestartGuess() const final { return true; }
+
+  bool SupportsSCFHistory() const final { return true; }
+
   bool RunDFT() final;
 
   bool RunActiveDFT() final;
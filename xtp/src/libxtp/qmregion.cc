@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -17,6 +17,10 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
 // Local VOTCA includes
 #include "votca/xtp/qmregion.h"
 #include "votca/xtp/aomatrix.h"
@@ -68,12 +72,50 @@ void QMRegion::Initialize(const tools::Property& prop) {
   DeltaDmax_ = prop.get("tolerance_density_max").as<double>();
 
   dftoptions_ = prop.get("dftpackage");
+
+  std::string extrapolation =
+      prop.get("density_extrapolation").as<std::string>();
+  if (extrapolation != "none") {
+    use_scf_history_ = true;
+    Index order = 0;
+    if (extrapolation == "linear") {
+      order = 1;
+    } else if (extrapolation == "quadratic") {
+      order = 2;
+    }
+    scf_history_ = SCFHistory(order);
+  }
+  max_scf_tolerance_factor_ = prop.get("dft_tolerance_factor").as<double>();
+  if (max_scf_tolerance_factor_ < 1.0) {
+    throw std::runtime_error("dft_tolerance_factor must be at least 1");
+  }
+}
+
+// the SCF thresholds are loosened as long as the energy of the region still
+// changes by more than its tolerance and are the requested ones once the
+// change is within it
+double QMRegion::SCFToleranceFactor() const {
+  if (max_scf_tolerance_factor_ == 1.0) {
+    return 1.0;
+  }
+  if (evaluations_ < 2) {
+    return max_scf_tolerance_factor_;
+  }
+  double factor = std::abs(E_hist_.getDiff()) / DeltaE_;
+  return std::clamp(factor, 1.0, max_scf_tolerance_factor_);
 }
 
 bool QMRegion::Converged() const {
   if (!E_hist_.filled()) {
     return false;
   }
+  if (scf_tolerance_factor_ > 1.0) {
+    XTP_LOG(Log::error, log_)
+        << " Region:" << this->identify() << " " << this->getId()
+        << " is not converged, DFT thresholds were scaled by "
+        << scf_tolerance_factor_ << std::flush;
+    return false;
+  }
 
   double Echange = E_hist_.getDiff();
   double Dchange =
@@ -103,6 +145,17 @@ void QMRegion::Evaluate(std::vector<std::unique_ptr<Region> >& regions) {
       << e_ext << std::flush;
   XTP_LOG(Log::info, log_) << "Writing inputs" << std::flush;
   qmpackage_->setRunDir(workdir_);
+  if (use_scf_history_) {
+    if (qmpackage_->SupportsSCFHistory()) {
+      qmpackage_->setSCFHistory(&scf_history_);
+    } else {
+      XTP_LOG(Log::info, log_)
+          << "Density extrapolation is not supported by the dftpackage"
+          << std::flush;
+    }
+  }
+  scf_tolerance_factor_ = SCFToleranceFactor();
+  qmpackage_->setSCFToleranceFactor(scf_tolerance_factor_);
   qmpackage_->WriteInputFile(orb_);
   XTP_LOG(Log::error, log_) << "Running DFT calculation" << std::flush;
   bool run_success = qmpackage_->Run();
@@ -146,6 +199,7 @@ void QMRegion::Evaluate(std::vector<std::unique_ptr<Region> >& regions) {
   }
   E_hist_.push_back(energy);
   Dmat_hist_.push_back(orb_.DensityMatrixFull(state));
+  evaluations_++;
   return;
 }
 
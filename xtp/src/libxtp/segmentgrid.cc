@@ -0,0 +1,169 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+// Local VOTCA includes
+#include "votca/xtp/segment.h"
+#include "votca/xtp/segmentgrid.h"
+
+namespace votca {
+namespace xtp {
+
+namespace {
+std::vector<Eigen::Vector3d> Centers(const std::vector<Segment>& segments) {
+  // the id of a segment is its index in the topology
+  std::vector<Eigen::Vector3d> centers;
+  centers.reserve(segments.size());
+  for (const Segment& seg : segments) {
+    centers.push_back(seg.getPos());
+  }
+  return centers;
+}
+}  // namespace
+
+SegmentGrid::SegmentGrid(const std::vector<Segment>& segments,
+                         const csg::BoundaryCondition& bc)
+    : SegmentGrid(Centers(segments), bc) {}
+
+SegmentGrid::SegmentGrid(std::vector<Eigen::Vector3d> positions,
+                         const csg::BoundaryCondition& bc)
+    : bc_(bc.Clone()), positions_(std::move(positions)) {
+  periodic_ = (bc.getBoxType() != csg::BoundaryCondition::typeOpen);
+
+  Eigen::Matrix3d box;
+  if (periodic_) {
+    box = bc.getBox();
+  } else {
+    Eigen::Vector3d min = Eigen::Vector3d::Zero();
+    Eigen::Vector3d max = Eigen::Vector3d::Zero();
+    if (!positions_.empty()) {
+      min = positions_.front();
+      max = positions_.front();
+    }
+    for (const Eigen::Vector3d& pos : positions_) {
+      min = min.cwiseMin(pos);
+      max = max.cwiseMax(pos);
+    }
+    origin_ = min;
+    // planar or linear systems still need a finite cell
+    box = (max - min).cwiseMax(1.0).asDiagonal();
+  }
+  inv_box_ = box.inverse();
+  double volume = std::abs(box.determinant());
+  for (Index d = 0; d < 3; d++) {
+    width_[d] =
+        volume / box.col((d + 1) % 3).cross(box.col((d + 2) % 3)).norm();
+  }
+
+  // roughly four segments per cell, so a query visits not many more
+  // segments than it returns
+  double nsegs = double(std::max(NumberOfSegments(), Index(1)));
+  double cellsize = std::cbrt(4.0 * volume / nsegs);
+  for (Index d = 0; d < 3; d++) {
+    ncells_[d] = std::max(Index(1), Index(width_[d] / cellsize));
+  }
+
+  Index ncells_total = ncells_[0] * ncells_[1] * ncells_[2];
+  cell_start_ = std::vector<Index>(ncells_total + 1, 0);
+  std::vector<Index> cell_of_segment(positions_.size());
+  for (Index i = 0; i < NumberOfSegments(); i++) {
+    Eigen::Vector3d s = ToFractional(positions_[i]);
+    std::array<Index, 3> cell;
+    for (Index d = 0; d < 3; d++) {
+      cell[d] = std::clamp(Index(std::floor(s[d] * double(ncells_[d]))),
+                           Index(0), ncells_[d] - 1);
+    }
+    cell_of_segment[i] = CellIndex(cell);
+    cell_start_[cell_of_segment[i] + 1]++;
+  }
+  std::partial_sum(cell_start_.begin(), cell_start_.end(),
+                   cell_start_.begin());
+  cell_segments_.resize(positions_.size());
+  std::vector<Index> next = cell_start_;
+  for (Index i = 0; i < NumberOfSegments(); i++) {
+    cell_segments_[next[cell_of_segment[i]]++] = i;
+  }
+}
+
+Eigen::Vector3d SegmentGrid::ToFractional(const Eigen::Vector3d& pos) const {
+  Eigen::Vector3d s = inv_box_ * (pos - origin_);
+  if (periodic_) {
+    s = s.array() - s.array().floor();
+  }
+  return s;
+}
+
+std::vector<Index> SegmentGrid::FindSegmentsWithin(const Eigen::Vector3d& pos,
+                                                   double radius) const {
+  std::vector<Index> result;
+  if (positions_.empty() || radius <= 0.0) {
+    return result;
+  }
+  Eigen::Vector3d s = ToFractional(pos);
+
+  // a segment closer than radius has fractional coordinates which differ by
+  // less than radius/width in each direction
+  std::array<std::vector<Index>, 3> cells;
+  for (Index d = 0; d < 3; d++) {
+    double n = double(ncells_[d]);
+    double reach = radius / width_[d];
+    double lo = std::floor((s[d] - reach) * n);
+    double hi = std::floor((s[d] + reach) * n);
+    if (periodic_) {
+      if (hi - lo + 1 >= n) {
+        cells[d].resize(ncells_[d]);
+        std::iota(cells[d].begin(), cells[d].end(), 0);
+      } else {
+        for (Index c = Index(lo); c <= Index(hi); c++) {
+          cells[d].push_back(((c % ncells_[d]) + ncells_[d]) % ncells_[d]);
+        }
+      }
+    } else {
+      Index first = Index(std::max(lo, 0.0));
+      Index last = Index(std::min(hi, n - 1));
+      for (Index c = first; c <= last; c++) {
+        cells[d].push_back(c);
+      }
+    }
+  }
+
+  for (Index cx : cells[0]) {
+    for (Index cy : cells[1]) {
+      for (Index cz : cells[2]) {
+        Index cell = CellIndex({cx, cy, cz});
+        for (Index k = cell_start_[cell]; k < cell_start_[cell + 1]; k++) {
+          Index id = cell_segments_[k];
+          if (bc_->BCShortestConnection(pos, positions_[id]).norm() < radius) {
+            result.push_back(id);
+          }
+        }
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+}  // namespace xtp
+}  // namespace votca
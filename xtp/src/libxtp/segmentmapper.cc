@@ -1,5 +1,5 @@
 /*
- *            Copyright 2016 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -20,17 +20,58 @@
 // Standard includes
 #include <regex>
 
+// Third party includes
+#include <boost/filesystem.hpp>
+
 // Local VOTCA includes
 #include "votca/xtp/segmentmapper.h"
 
 namespace votca {
 namespace xtp {
 
+template <class AtomContainer>
+std::map<std::string, std::shared_ptr<const AtomContainer>>
+    SegmentMapper<AtomContainer>::templates_;
+
+template <class AtomContainer>
+std::mutex SegmentMapper<AtomContainer>::templates_mutex_;
+
 template <class AtomContainer>
 SegmentMapper<AtomContainer>::SegmentMapper(Logger& log) : log_(log) {
   FillMap();
 }
 
+template <class AtomContainer>
+void SegmentMapper<AtomContainer>::ClearTemplateCache() {
+  std::lock_guard<std::mutex> lock(templates_mutex_);
+  templates_.clear();
+}
+
+template <class AtomContainer>
+Index SegmentMapper<AtomContainer>::TemplateCacheSize() {
+  std::lock_guard<std::mutex> lock(templates_mutex_);
+  return Index(templates_.size());
+}
+
+template <class AtomContainer>
+std::shared_ptr<const AtomContainer> SegmentMapper<AtomContainer>::getTemplate(
+    const std::string& coordfilename) const {
+  std::string key = boost::filesystem::absolute(coordfilename).string();
+  {
+    std::lock_guard<std::mutex> lock(templates_mutex_);
+    auto it = templates_.find(key);
+    if (it != templates_.end()) {
+      return it->second;
+    }
+  }
+  // parsing happens outside the lock, if two threads load the same file the
+  // first one to finish wins
+  auto parsed = std::make_shared<AtomContainer>("", 0);
+  parsed->LoadFromFile(coordfilename);
+  std::lock_guard<std::mutex> lock(templates_mutex_);
+  return templates_.emplace(key, std::move(parsed)).first->second;
+}
+
 template <class AtomContainer>
 AtomContainer SegmentMapper<AtomContainer>::map(const Segment& seg,
                                                 const SegId& segid) const {
@@ -391,7 +432,7 @@ AtomContainer SegmentMapper<AtomContainer>::map(const Segment& seg,
     throw std::runtime_error(
         "Could not find a Segment of name: " + seg.getType() + " in mapfile.");
   }
-  Seginfo seginfo = segment_info_.at(seg.getType());
+  const Seginfo& seginfo = segment_info_.at(seg.getType());
   std::string coordsfiletag =
       mapatom_xml_.at("coords") + "_" + state.Type().ToString();
   if (seginfo.coordfiles.count(coordsfiletag) == 0) {
@@ -412,7 +453,7 @@ AtomContainer SegmentMapper<AtomContainer>::map(
     throw std::runtime_error(
         "Could not find a Segment of name: " + seg.getType() + " in mapfile.");
   }
-  Seginfo seginfo = segment_info_.at(seg.getType());
+  const Seginfo& seginfo = segment_info_.at(seg.getType());
   if (Index(seginfo.mdatoms.size()) != seg.size()) {
     throw std::runtime_error(
         "Segment '" + seg.getType() +
@@ -437,8 +478,9 @@ AtomContainer SegmentMapper<AtomContainer>::map(
 
   Index atomidoffset = minmax.first - minmax_map.first;
 
-  AtomContainer Result(seg.getType(), seg.getId());
-  Result.LoadFromFile(coordfilename);
+  AtomContainer Result = *getTemplate(coordfilename);
+  Result.setType(seg.getType());
+  Result.setId(seg.getId());
 
   if (Index(seginfo.mapatoms.size()) != Result.size()) {
     throw std::runtime_error(
@@ -448,11 +490,7 @@ AtomContainer SegmentMapper<AtomContainer>::map(
         std::to_string(Result.size()));
   }
 
-  for (FragInfo& frag : seginfo.fragments) {
-    for (atom_id& id : frag.mdatom_ids) {
-      id.first += atomidoffset;
-    }
-
+  for (const FragInfo& frag : seginfo.fragments) {
     std::vector<mapAtom*> fragment_mapatoms;
     for (const atom_id& id : frag.mapatom_ids) {
       if (id.second != Result[id.first].getElement()) {
@@ -465,11 +503,12 @@ AtomContainer SegmentMapper<AtomContainer>::map(
     }
     std::vector<const Atom*> fragment_mdatoms;
     for (const atom_id& id : frag.mdatom_ids) {
-      const Atom* atom = seg.getAtom(id.first);
+      const Atom* atom = seg.getAtom(id.first + atomidoffset);
       if (atom == nullptr) {
-        throw std::runtime_error(
-            "Could not find an atom with name:" + id.second + "id" +
-            std::to_string(id.first) + " in segment " + seg.getType());
+        throw std::runtime_error("Could not find an atom with name:" +
+                                 id.second + "id" +
+                                 std::to_string(id.first + atomidoffset) +
+                                 " in segment " + seg.getType());
       }
       fragment_mdatoms.push_back(atom);
     }
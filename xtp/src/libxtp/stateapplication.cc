@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -17,11 +17,16 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <exception>
+
 // Third party includes
 #include <boost/format.hpp>
 
 // Local VOTCA includes
 #include "votca/xtp/calculatorfactory.h"
+#include "votca/xtp/eigen.h"
 #include "votca/xtp/stateapplication.h"
 #include "votca/xtp/statesaver.h"
 #include "votca/xtp/version.h"
@@ -29,6 +34,23 @@
 namespace votca {
 namespace xtp {
 
+namespace {
+// nested parallel levels are only active while a batch of frames is
+// evaluated, afterwards the previous OpenMP setting is restored
+class NestedLevelsGuard {
+ public:
+  NestedLevelsGuard() : previous_(OPENMP::getMaxActiveLevels()) {
+    OPENMP::setMaxActiveLevels(std::max(previous_, Index(2)));
+  }
+  ~NestedLevelsGuard() { OPENMP::setMaxActiveLevels(previous_); }
+  NestedLevelsGuard(const NestedLevelsGuard&) = delete;
+  NestedLevelsGuard& operator=(const NestedLevelsGuard&) = delete;
+
+ private:
+  Index previous_;
+};
+}  // namespace
+
 void StateApplication::AddCommandLineOptions() {
 
   namespace propt = boost::program_options;
@@ -41,6 +63,9 @@ void StateApplication::AddCommandLineOptions() {
                       "  number of frames to process");
   AddProgramOptions()("save,s", propt::value<bool>()->default_value(true),
                       "  whether or not to save changes to state file");
+  AddProgramOptions()("frame-threads",
+                      propt::value<Index>()->default_value(1),
+                      "  number of frames to evaluate at the same time");
 
   AddCommandLineOpt();
 }
@@ -84,14 +109,58 @@ void StateApplication::execute() {
     nframes = Index(frames.size()) - fframe;
   }
 
-  for (Index i = fframe; i < nframes; i++) {
-    std::cout << "Evaluating frame " << frames[i] << std::endl;
-    Topology top = statsav.ReadFrame(frames[i]);
-    EvaluateFrame(top);
-    if (save && savetoStateFile()) {
-      statsav.WriteFrame(top);
+  Index frame_threads = std::min(
+      std::max(OptionsMap()["frame-threads"].as<Index>(), Index(1)), nframes);
+  if (frame_threads > 1) {
+    frame_threads = PrepareConcurrentFrames(frame_threads);
+  }
+  if (frame_threads > 1) {
+    std::cout << "Evaluating " << frame_threads << " frames at the same time"
+              << std::endl;
+  }
+
+  // at most frame_threads topologies are held in memory, reading and writing
+  // the state file stays serial
+  Index lastframe = fframe + nframes;
+  for (Index start = fframe; start < lastframe; start += frame_threads) {
+    Index batchsize = std::min(frame_threads, lastframe - start);
+    std::vector<Topology> tops;
+    tops.reserve(batchsize);
+    for (Index i = start; i < start + batchsize; i++) {
+      std::cout << "Evaluating frame " << frames[i] << std::endl;
+      tops.push_back(statsav.ReadFrame(frames[i]));
+    }
+
+    if (batchsize == 1) {
+      EvaluateFrame(tops[0]);
     } else {
-      std::cout << "Changes have not been written to state file." << std::endl;
+      // every frame opens its own team with the threads of its worker
+      NestedLevelsGuard nested;
+      std::vector<std::exception_ptr> errors(batchsize);
+#pragma omp parallel for num_threads(batchsize) schedule(static, 1)
+      for (Index i = 0; i < batchsize; i++) {
+        OPENMP::JobParallelLevels()++;
+        try {
+          EvaluateFrameOnWorker(tops[i], i);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+        OPENMP::JobParallelLevels()--;
+      }
+      for (const std::exception_ptr& error : errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+    }
+
+    for (const Topology& top : tops) {
+      if (save && savetoStateFile()) {
+        statsav.WriteFrame(top);
+      } else {
+        std::cout << "Changes have not been written to state file."
+                  << std::endl;
+      }
     }
   }
 }
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -40,123 +40,131 @@ void Overlap_filter::Info(Logger& log) const {
   }
 }
 
+namespace {
+const tools::EigenSystem& BSEStates(const Orbitals& orb, QMStateType type) {
+  return (type == QMStateType::Singlet) ? orb.BSESinglets()
+                                        : orb.BSETriplets();
+}
+}  // namespace
+
 Eigen::VectorXd Overlap_filter::CalculateOverlap(const Orbitals& orb,
                                                  QMStateType type) const {
   AOOverlap S_ao;
   S_ao.Fill(orb.getDftBasis());
 
-  Eigen::MatrixXd coeffs = CalcAOCoeffs(orb, type);
   if (type.isSingleParticleState()) {
+    Eigen::MatrixXd coeffs = CalcAOCoeffs(orb, type);
     return (coeffs.transpose() * S_ao.Matrix() * laststatecoeff_).cwiseAbs();
   } else {
-
-    Index basis = orb.getBasisSetSize();
-    Eigen::VectorXd overlap = Eigen::VectorXd::Zero(coeffs.cols());
-#pragma omp parallel for schedule(dynamic)
-    for (Index i = 0; i < coeffs.cols(); i++) {
-      {
-        Eigen::VectorXd state = coeffs.col(i).head(basis * basis);
-        Eigen::Map<const Eigen::MatrixXd> mat(state.data(), basis, basis);
-        Eigen::VectorXd laststate = laststatecoeff_.head(basis * basis);
-        Eigen::Map<const Eigen::MatrixXd> lastmat(laststate.data(), basis,
-                                                  basis);
-
-        overlap(i) = (mat * S_ao.Matrix() * lastmat.transpose())
-                         .cwiseProduct(S_ao.Matrix())
-                         .sum();
-      }
-      if (!orb.getTDAApprox()) {
-        Eigen::VectorXd state = coeffs.col(i).tail(basis * basis);
-        Eigen::Map<const Eigen::MatrixXd> mat(state.data(), basis, basis);
-        Eigen::VectorXd laststate = laststatecoeff_.tail(basis * basis);
-        Eigen::Map<const Eigen::MatrixXd> lastmat(laststate.data(), basis,
-                                                  basis);
-
-        overlap(i) -= (mat * S_ao.Matrix() * lastmat.transpose())
-                          .cwiseProduct(S_ao.Matrix())
-                          .sum();
-      }
-    }
-    return overlap.cwiseAbs();
+    return CalculateExcitonOverlap(orb, type, S_ao.Matrix());
   }
 }
 
-Eigen::MatrixXd Overlap_filter::CalcExcitonAORepresentation(
-    const Orbitals& orb, QMStateType type) const {
-  Eigen::MatrixXd coeffs;
-  Index nostates = orb.NumberofStates(type);
-  Index bse_cmax = orb.getBSEcmax();
-  Index bse_cmin = orb.getBSEcmin();
-  Index bse_vmax = orb.getBSEvmax();
-  Index bse_vmin = orb.getBSEvmin();
-  Index bse_vtotal = bse_vmax - bse_vmin + 1;
-  Index bse_ctotal = bse_cmax - bse_cmin + 1;
+Eigen::VectorXd Overlap_filter::CalculateExcitonOverlap(
+    const Orbitals& orb, QMStateType type, const Eigen::MatrixXd& S_ao) const {
+  Index bse_vtotal = orb.getBSEvmax() - orb.getBSEvmin() + 1;
+  Index bse_ctotal = orb.getBSEcmax() - orb.getBSEcmin() + 1;
+  Index bse_size = bse_vtotal * bse_ctotal;
+  Index last_vtotal = lastocclevels_.cols();
+  Index last_ctotal = lastvirtlevels_.cols();
+  Index last_size = last_vtotal * last_ctotal;
+  auto occlevels =
+      orb.MOs().eigenvectors().middleCols(orb.getBSEvmin(), bse_vtotal);
+  auto virtlevels =
+      orb.MOs().eigenvectors().middleCols(orb.getBSEcmin(), bse_ctotal);
+  const tools::EigenSystem& states = BSEStates(orb, type);
+
   Index basis = orb.getBasisSetSize();
-  Index bse_size_ao = basis * basis;
-  auto occlevels = orb.MOs().eigenvectors().middleCols(bse_vmin, bse_vtotal);
-  auto virtlevels = orb.MOs().eigenvectors().middleCols(bse_cmin, bse_ctotal);
+  Index ao_size = basis * basis;
+  if (last_size == 0 && ao_size > 0 &&
+      (laststatecoeff_.size() == ao_size ||
+       laststatecoeff_.size() == 2 * ao_size)) {
+    // checkpoints written by older versions store the previous exciton in
+    // the AO representation X_last, Tr(X S X_last^T S) then reduces to
+    // sum(A .* (C_c^T S X_last^T S C_v))
+    auto ProjectAO = [&](Index start) {
+      Eigen::Map<const Eigen::MatrixXd> lastmat(laststatecoeff_.data() + start,
+                                                basis, basis);
+      Eigen::MatrixXd projected = virtlevels.transpose() * S_ao *
+                                  lastmat.transpose() * S_ao * occlevels;
+      return Eigen::VectorXd(
+          Eigen::Map<const Eigen::VectorXd>(projected.data(), bse_size));
+    };
+    Eigen::VectorXd overlap = states.eigenvectors().transpose() * ProjectAO(0);
+    if (!orb.getTDAApprox() && laststatecoeff_.size() == 2 * ao_size) {
+      overlap -= states.eigenvectors2().transpose() * ProjectAO(ao_size);
+    }
+    return overlap.cwiseAbs();
+  }
 
-  if (orb.getTDAApprox()) {
-    coeffs.resize(bse_size_ao, nostates);
-  } else {
-    coeffs.resize(2 * bse_size_ao, nostates);
+  if (last_size == 0 || laststatecoeff_.size() < last_size) {
+    throw std::runtime_error(
+        "Overlap filter: previous state is not an exciton");
   }
-#pragma omp parallel for schedule(dynamic)
-  for (Index i = 0; i < nostates; i++) {
-    {
-      Eigen::VectorXd exciton;
-      if (type == QMStateType::Singlet) {
-        exciton = orb.BSESinglets().eigenvectors().col(i);
-      } else {
-        exciton = orb.BSETriplets().eigenvectors().col(i);
-      }
-      Eigen::Map<const Eigen::MatrixXd> mat(exciton.data(), bse_ctotal,
-                                            bse_vtotal);
-      const Eigen::MatrixXd aomatrix =
-          occlevels * mat.transpose() * virtlevels.transpose();
-      coeffs.col(i).head(bse_size_ao) =
-          Eigen::Map<const Eigen::VectorXd>(aomatrix.data(), bse_size_ao);
-    }
-    if (!orb.getTDAApprox()) {
-      Eigen::VectorXd exciton;
-      if (type == QMStateType::Singlet) {
-        exciton = orb.BSESinglets().eigenvectors2().col(i);
-      } else {
-        exciton = orb.BSETriplets().eigenvectors2().col(i);
-      }
-      Eigen::Map<const Eigen::MatrixXd> mat(exciton.data(), bse_ctotal,
-                                            bse_vtotal);
-      const Eigen::MatrixXd aomatrix =
-          occlevels * mat.transpose() * virtlevels.transpose();
-      coeffs.col(i).tail(bse_size_ao) =
-          Eigen::Map<const Eigen::VectorXd>(aomatrix.data(), bse_size_ao);
-    }
+
+  // with X = C_v A^T C_c^T the AO representation of an exciton A, the
+  // overlap Tr(X S X_last^T S) reduces to sum(A .* (S_cc A_last S_vv)),
+  // where S_cc and S_vv are the overlaps between the new and old MOs
+  const Eigen::MatrixXd S_cc = virtlevels.transpose() * S_ao * lastvirtlevels_;
+  const Eigen::MatrixXd S_vv = lastocclevels_.transpose() * S_ao * occlevels;
+
+  Eigen::Map<const Eigen::MatrixXd> lastmat(laststatecoeff_.data(),
+                                            last_ctotal, last_vtotal);
+  Eigen::MatrixXd projected = S_cc * lastmat * S_vv;
+  Eigen::VectorXd overlap =
+      states.eigenvectors().transpose() *
+      Eigen::Map<const Eigen::VectorXd>(projected.data(), bse_size);
+
+  if (!orb.getTDAApprox() && laststatecoeff_.size() == 2 * last_size) {
+    Eigen::Map<const Eigen::MatrixXd> lastmat2(
+        laststatecoeff_.data() + last_size, last_ctotal, last_vtotal);
+    projected = S_cc * lastmat2 * S_vv;
+    overlap -= states.eigenvectors2().transpose() *
+               Eigen::Map<const Eigen::VectorXd>(projected.data(), bse_size);
   }
-  return coeffs;
+  return overlap.cwiseAbs();
 }
 
 Eigen::MatrixXd Overlap_filter::CalcAOCoeffs(const Orbitals& orb,
                                              QMStateType type) const {
   Eigen::MatrixXd coeffs;
-  if (type.isSingleParticleState()) {
-    if (type == QMStateType::DQPstate) {
-      coeffs = orb.CalculateQParticleAORepresentation();
-    } else {
-      coeffs = orb.MOs().eigenvectors();
-    }
+  if (type == QMStateType::DQPstate) {
+    coeffs = orb.CalculateQParticleAORepresentation();
   } else {
-    coeffs = CalcExcitonAORepresentation(orb, type);
+    coeffs = orb.MOs().eigenvectors();
   }
   return coeffs;
 }
 
 void Overlap_filter::UpdateHist(const Orbitals& orb, QMState state) {
-  Eigen::MatrixXd aocoeffs = CalcAOCoeffs(orb, state.Type());
-  Index offset = 0;
-  if (state.Type() == QMStateType::DQPstate) {
-    offset = orb.getGWAmin();
+  if (state.Type().isSingleParticleState()) {
+    Eigen::MatrixXd aocoeffs = CalcAOCoeffs(orb, state.Type());
+    Index offset = 0;
+    if (state.Type() == QMStateType::DQPstate) {
+      offset = orb.getGWAmin();
+    }
+    laststatecoeff_ = aocoeffs.col(state.StateIdx() - offset);
+    lastocclevels_.resize(0, 0);
+    lastvirtlevels_.resize(0, 0);
+  } else {
+    Index bse_vtotal = orb.getBSEvmax() - orb.getBSEvmin() + 1;
+    Index bse_ctotal = orb.getBSEcmax() - orb.getBSEcmin() + 1;
+    lastocclevels_ =
+        orb.MOs().eigenvectors().middleCols(orb.getBSEvmin(), bse_vtotal);
+    lastvirtlevels_ =
+        orb.MOs().eigenvectors().middleCols(orb.getBSEcmin(), bse_ctotal);
+    const tools::EigenSystem& states = BSEStates(orb, state.Type());
+    Index bse_size = bse_vtotal * bse_ctotal;
+    if (orb.getTDAApprox()) {
+      laststatecoeff_ = states.eigenvectors().col(state.StateIdx());
+    } else {
+      laststatecoeff_.resize(2 * bse_size);
+      laststatecoeff_.head(bse_size) =
+          states.eigenvectors().col(state.StateIdx());
+      laststatecoeff_.tail(bse_size) =
+          states.eigenvectors2().col(state.StateIdx());
+    }
   }
-  laststatecoeff_ = aocoeffs.col(state.StateIdx() - offset);
 }
 
 std::vector<Index> Overlap_filter::CalcIndeces(const Orbitals& orb,
@@ -171,11 +179,22 @@ std::vector<Index> Overlap_filter::CalcIndeces(const Orbitals& orb,
 
 void Overlap_filter::WriteToCpt(CheckpointWriter& w) {
   w(laststatecoeff_, "laststatecoeff");
+  w(lastocclevels_, "lastocclevels");
+  w(lastvirtlevels_, "lastvirtlevels");
   w(threshold_, "threshold");
 }
 
 void Overlap_filter::ReadFromCpt(CheckpointReader& r) {
   r(laststatecoeff_, "laststatecoeff");
+  // older checkpoints have no MO levels, the previous exciton is then kept in
+  // its AO representation
+  if (r.exists("lastocclevels") && r.exists("lastvirtlevels")) {
+    r(lastocclevels_, "lastocclevels");
+    r(lastvirtlevels_, "lastvirtlevels");
+  } else {
+    lastocclevels_.resize(0, 0);
+    lastvirtlevels_.resize(0, 0);
+  }
   r(threshold_, "threshold");
 }
 
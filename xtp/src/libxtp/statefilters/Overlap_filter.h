@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -30,6 +30,10 @@ namespace xtp {
 /**
     \brief overlap_filter
     tracks states according to their overlap with a previous state
+
+    For excitons the overlap is evaluated in the space of the transitions
+    between occupied and virtual MOs, using the overlap between the old and
+    new MOs, so no basis x basis representation of the excitons is needed.
  */
 
 class Overlap_filter : public StateFilter_base {
@@ -55,11 +59,17 @@ class Overlap_filter : public StateFilter_base {
   Eigen::VectorXd CalculateOverlap(const Orbitals& orb, QMStateType type) const;
   Eigen::MatrixXd CalcAOCoeffs(const Orbitals& orb, QMStateType type) const;
 
-  Eigen::MatrixXd CalcExcitonAORepresentation(const Orbitals& orb,
-                                              QMStateType type) const;
+  Eigen::VectorXd CalculateExcitonOverlap(const Orbitals& orb,
+                                          QMStateType type,
+                                          const Eigen::MatrixXd& S_ao) const;
   double threshold_ = 0.0;
 
+  // AO coefficients of a single particle state or the BSE coefficients of an
+  // exciton, for which the occupied and virtual MOs of the BSE window are
+  // stored too
   Eigen::VectorXd laststatecoeff_;
+  Eigen::MatrixXd lastocclevels_;
+  Eigen::MatrixXd lastvirtlevels_;
 };
 
 }  // namespace xtp
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -26,6 +26,81 @@
 namespace votca {
 namespace xtp {
 
+Symmetric_Matrix TCMatrix_dft::operator[](Index i) const {
+  // zero initialised
+  Symmetric_Matrix result(basissize_);
+  for (const ShellPair& pair : pairs_) {
+    for (Index nu = 0; nu < pair.size2; nu++) {
+      for (Index mu = 0; mu < pair.size1; mu++) {
+        result(pair.start1 + mu, pair.start2 + nu) =
+            data_(i, pair.offset + mu + pair.size1 * nu);
+      }
+    }
+  }
+  return result;
+}
+
+Eigen::VectorXd TCMatrix_dft::ContractDensity(
+    const Eigen::MatrixXd& dmat) const {
+  Eigen::VectorXd packed(data_.cols());
+#pragma omp parallel for schedule(dynamic)
+  for (Index p = 0; p < NumberOfShellPairs(); p++) {
+    const ShellPair& pair = pairs_[p];
+    // the pair nu,mu is not stored, dmat is symmetric
+    const double factor = (pair.start1 == pair.start2) ? 1.0 : 2.0;
+    Eigen::Map<Eigen::MatrixXd> sub(packed.data() + pair.offset, pair.size1,
+                                    pair.size2);
+    sub = factor *
+          dmat.block(pair.start1, pair.start2, pair.size1, pair.size2);
+  }
+  return data_ * packed;
+}
+
+Eigen::MatrixXd TCMatrix_dft::ContractAux(const Eigen::VectorXd& gamma) const {
+  const Eigen::VectorXd packed = data_.transpose() * gamma;
+  Eigen::MatrixXd result = Eigen::MatrixXd::Zero(basissize_, basissize_);
+  // every pair writes to its own blocks
+#pragma omp parallel for schedule(dynamic)
+  for (Index p = 0; p < NumberOfShellPairs(); p++) {
+    const ShellPair& pair = pairs_[p];
+    Eigen::Map<const Eigen::MatrixXd> sub(packed.data() + pair.offset,
+                                          pair.size1, pair.size2);
+    result.block(pair.start1, pair.start2, pair.size1, pair.size2) = sub;
+    result.block(pair.start2, pair.start1, pair.size2, pair.size1) =
+        sub.transpose();
+  }
+  return result;
+}
+
+Eigen::MatrixXd TCMatrix_dft::MultiplyVectors(const Eigen::MatrixXd& V) const {
+  const Index nvec = V.cols();
+  Eigen::MatrixXd result = Eigen::MatrixXd::Zero(auxsize_ * nvec, basissize_);
+  for (const ShellPair& pair : pairs_) {
+    // B(P + naux * mu, nu) of the pair is contiguous in memory
+    Eigen::Map<const Eigen::MatrixXd> B(data_.col(pair.offset).data(),
+                                        auxsize_ * pair.size1, pair.size2);
+    // Z(P + naux * mu, k) = sum_nu B_P(mu,nu) V(nu,k)
+    const Eigen::MatrixXd Z = B * V.middleRows(pair.start2, pair.size2);
+    for (Index mu = 0; mu < pair.size1; mu++) {
+      Eigen::Map<Eigen::MatrixXd>(result.col(pair.start1 + mu).data(),
+                                  auxsize_, nvec) +=
+          Z.middleRows(auxsize_ * mu, auxsize_);
+    }
+    if (pair.start1 == pair.start2) {
+      continue;
+    }
+    const auto Vmu = V.middleRows(pair.start1, pair.size1);
+    for (Index nu = 0; nu < pair.size2; nu++) {
+      Eigen::Map<Eigen::MatrixXd>(result.col(pair.start2 + nu).data(),
+                                  auxsize_, nvec)
+          .noalias() += data_.middleCols(pair.offset + pair.size1 * nu,
+                                         pair.size1) *
+                        Vmu;
+    }
+  }
+  return result;
+}
+
 void TCMatrix_gwbse::Initialize(Index basissize, Index mmin, Index mmax,
                                 Index nmin, Index nmax) {
 
@@ -0,0 +1,435 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+
+// Third party includes
+#include <boost/format.hpp>
+
+// VOTCA includes
+#include <votca/tools/constants.h>
+#include <votca/tools/property.h>
+#include <votca/tools/tokenizer.h>
+
+// Local VOTCA includes
+#include "votca/xtp/ERIs.h"
+#include "votca/xtp/aomatrix.h"
+#include "votca/xtp/bse_operator.h"
+#include "votca/xtp/davidsonsolver.h"
+#include "votca/xtp/logger.h"
+#include "votca/xtp/rpa.h"
+#include "votca/xtp/sigmafactory.h"
+#include "votca/xtp/threecenter.h"
+#include "votca/xtp/vxc_grid.h"
+#include "votca/xtp/vxc_potential.h"
+
+// Local private VOTCA includes
+#include "cpu_benchmark.h"
+
+namespace votca {
+namespace xtp {
+
+namespace {
+
+struct Timing {
+  double mean = 0.0;
+  double std = 0.0;
+};
+
+template <class T>
+Timing TimeKernel(T&& payload, Index repetitions) {
+  std::vector<double> timings;
+  timings.reserve(repetitions);
+  for (Index i = 0; i < repetitions; i++) {
+    std::chrono::time_point<std::chrono::steady_clock> start =
+        std::chrono::steady_clock::now();
+    payload();
+    std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+    timings.push_back(time.count());
+  }
+  Timing result;
+  double n = double(timings.size());
+  result.mean = std::accumulate(timings.begin(), timings.end(), 0.0) / n;
+  double sq_sum =
+      std::inner_product(timings.begin(), timings.end(), timings.begin(), 0.0);
+  result.std = std::sqrt(std::max(0.0, sq_sum / n - result.mean * result.mean));
+  return result;
+}
+
+// slope of log(time) over log(size), i.e. t ~ size^exponent
+double ScalingExponent(const std::vector<double>& sizes,
+                       const std::vector<double>& times) {
+  Index n = Index(sizes.size());
+  if (n < 2) {
+    return 0.0;
+  }
+  Eigen::VectorXd x(n);
+  Eigen::VectorXd y(n);
+  for (Index i = 0; i < n; i++) {
+    x(i) = std::log(sizes[i]);
+    y(i) = std::log(std::max(times[i], 1e-12));
+  }
+  x.array() -= x.mean();
+  y.array() -= y.mean();
+  double norm = x.squaredNorm();
+  return (norm > 0.0) ? x.dot(y) / norm : 0.0;
+}
+
+}  // namespace
+
+QMMolecule CPUBenchmark::WaterCluster(Index nmolecules) {
+  QMMolecule mol("water_cluster", 0);
+  const Index edge =
+      Index(std::ceil(std::cbrt(double(std::max(nmolecules, Index(1))))));
+  const double spacing = 3.0;  // Angstrom
+  Index atomid = 0;
+  for (Index i = 0; i < nmolecules; i++) {
+    Eigen::Vector3d center(double(i % edge), double((i / edge) % edge),
+                           double(i / (edge * edge)));
+    center *= spacing;
+    const Eigen::Vector3d h1(0.757, 0.586, 0.0);
+    const Eigen::Vector3d h2(-0.757, 0.586, 0.0);
+    mol.push_back(QMAtom(atomid++, "O", center * tools::conv::ang2bohr));
+    mol.push_back(QMAtom(atomid++, "H", (center + h1) * tools::conv::ang2bohr));
+    mol.push_back(QMAtom(atomid++, "H", (center + h2) * tools::conv::ang2bohr));
+  }
+  return mol;
+}
+
+QMMolecule CPUBenchmark::Alkane(Index ncarbons) {
+  QMMolecule mol("alkane", 0);
+  // all-trans zigzag chain in the xy plane
+  const double dx = 1.258;  // Angstrom
+  const double dy = 0.889;
+  Index atomid = 0;
+  for (Index i = 0; i < ncarbons; i++) {
+    const double side = (i % 2 == 0) ? -1.0 : 1.0;
+    Eigen::Vector3d carbon(dx * double(i), 0.5 * dy * side, 0.0);
+    mol.push_back(QMAtom(atomid++, "C", carbon * tools::conv::ang2bohr));
+    for (double z : {-0.89, 0.89}) {
+      Eigen::Vector3d h = carbon + Eigen::Vector3d(0.0, 0.63 * side, z);
+      mol.push_back(QMAtom(atomid++, "H", h * tools::conv::ang2bohr));
+    }
+    if (i == 0 || i == ncarbons - 1) {
+      const double end = (i == 0) ? -1.0 : 1.0;
+      Eigen::Vector3d h = carbon + Eigen::Vector3d(1.09 * end, 0.0, 0.0);
+      mol.push_back(QMAtom(atomid++, "H", h * tools::conv::ang2bohr));
+    }
+  }
+  return mol;
+}
+
+void CPUBenchmark::ParseOptions(const tools::Property& options) {
+  outputfile_ = options.get(".outputfile").as<std::string>();
+  repetitions_ = options.get(".repetitions").as<Index>();
+  molecule_ = options.get(".molecule").as<std::string>();
+  sizes_ = tools::Tokenizer(options.get(".sizes").as<std::string>(), " ,")
+               .ToVector<Index>();
+  threads_ = tools::Tokenizer(options.get(".threads").as<std::string>(), " ,")
+                 .ToVector<Index>();
+  basisset_ = options.get(".basisset").as<std::string>();
+  auxbasisset_ = options.get(".auxbasisset").as<std::string>();
+  functional_ = options.get(".functional").as<std::string>();
+  grid_ = options.get(".grid").as<std::string>();
+  kernels_ = tools::Tokenizer(options.get(".kernels").as<std::string>(), " ,")
+                 .ToVector();
+  if (sizes_.empty() || threads_.empty()) {
+    throw std::runtime_error("cpu_benchmark: no sizes or threads given");
+  }
+}
+
+bool CPUBenchmark::DoKernel(const std::string& kernel) const {
+  return std::find(kernels_.begin(), kernels_.end(), kernel) != kernels_.end();
+}
+
+bool CPUBenchmark::Run() {
+
+  const Index maxthreads = OPENMP::getMaxThreads();
+  // the timings are collected per thread count, so every count may only
+  // appear once, 0 stands for the maximum
+  std::vector<Index> threadcounts;
+  for (Index threads : threads_) {
+    const Index nthreads = (threads > 0) ? threads : maxthreads;
+    if (std::find(threadcounts.begin(), threadcounts.end(), nthreads) !=
+        threadcounts.end()) {
+      throw std::runtime_error("cpu_benchmark: thread count " +
+                               std::to_string(nthreads) +
+                               " is given more than once");
+    }
+    threadcounts.push_back(nthreads);
+  }
+  Logger log;
+  Sigma().RegisterAll();
+
+  tools::Property output("CPU_Benchmark", "", "");
+  output.add("Repetitions", std::to_string(repetitions_));
+  output.add("MaxThreads", std::to_string(maxthreads));
+  output.add("MKL_overload", std::to_string(XTP_HAS_MKL_OVERLOAD()));
+  output.add("Molecule", molecule_);
+  output.add("Basisset", basisset_);
+  output.add("AuxBasisset", auxbasisset_);
+
+  std::cout << "\nBenchmarking " << molecule_ << " with " << basisset_ << "/"
+            << auxbasisset_ << ", " << repetitions_ << " repetitions"
+            << std::endl;
+
+  // timings[kernel][threads] over the sizes
+  std::map<std::string, std::map<Index, std::vector<double>>> timings;
+  std::vector<double> basissizes;
+
+  for (Index size : sizes_) {
+    QMMolecule mol =
+        (molecule_ == "alkane") ? Alkane(size) : WaterCluster(size);
+    BasisSet basisset;
+    basisset.Load(basisset_);
+    AOBasis basis;
+    basis.Fill(basisset, mol);
+    BasisSet auxbasisset;
+    auxbasisset.Load(auxbasisset_);
+    AOBasis auxbasis;
+    auxbasis.Fill(auxbasisset, mol);
+
+    const Index nbasis = basis.AOBasisSize();
+    const Index auxsize = auxbasis.AOBasisSize();
+    Index nelectrons = 0;
+    for (const QMAtom& atom : mol) {
+      nelectrons += atom.getElementNumber();
+    }
+    const Index nocc = nelectrons / 2;
+    const Index homo = nocc - 1;
+    basissizes.push_back(double(nbasis));
+
+    // random orbitals, orthonormal with respect to the overlap, no SCF is
+    // needed to time the kernels
+    AOOverlap overlap;
+    overlap.Fill(basis);
+    Eigen::MatrixXd Q = Eigen::HouseholderQR<Eigen::MatrixXd>(
+                            Eigen::MatrixXd::Random(nbasis, nbasis))
+                            .householderQ();
+    const Eigen::MatrixXd mos = overlap.Pseudo_InvSqrt(1e-8) * Q;
+    Eigen::VectorXd energies = Eigen::VectorXd::LinSpaced(nbasis, -1.0, 2.0);
+    energies.tail(nbasis - nocc).array() += 0.3;
+    const Eigen::MatrixXd occ = mos.leftCols(nocc);
+    const Eigen::MatrixXd dmat = 2.0 * occ * occ.transpose();
+
+    const Index qpmax = std::min(nbasis - 1, 2 * nocc - 1);
+    const Index qptotal = qpmax + 1;
+
+    std::cout << "\n"
+              << molecule_ << " " << size << ": atoms:" << mol.size()
+              << " basis:" << nbasis << " aux:" << auxsize
+              << " electrons:" << nelectrons << std::endl;
+    tools::Property& sizeprop = output.add("size", "");
+    sizeprop.setAttribute("n", size);
+    sizeprop.setAttribute("atoms", mol.size());
+    sizeprop.setAttribute("basis", nbasis);
+    sizeprop.setAttribute("aux", auxsize);
+
+    for (Index nthreads : threadcounts) {
+      OPENMP::setMaxThreads(nthreads);
+      tools::Property& threadprop = sizeprop.add("threads", "");
+      threadprop.setAttribute("n", nthreads);
+
+      auto record = [&](const std::string& name, const Timing& t) {
+        std::cout << boost::format("  %-24s threads:%3d  %12.4f s +- %.4f") %
+                         name % nthreads % t.mean % t.std
+                  << std::endl;
+        tools::Property& kernel = threadprop.add("kernel", "");
+        kernel.setAttribute("name", name);
+        kernel.add("avg", std::to_string(t.mean));
+        kernel.add("std", std::to_string(t.std));
+        timings[name][nthreads].push_back(t.mean);
+      };
+
+      if (DoKernel("aoints")) {
+        record("AO_integrals", TimeKernel(
+                                   [&]() {
+                                     AOOverlap s;
+                                     s.Fill(basis);
+                                     AOKinetic t;
+                                     t.Fill(basis);
+                                     AOCoulomb c;
+                                     c.Fill(auxbasis);
+                                   },
+                                   repetitions_));
+      }
+
+      if (DoKernel("ri")) {
+        ERIs eris;
+        record("RI_setup",
+               TimeKernel([&]() { eris.Initialize(basis, auxbasis); },
+                          repetitions_));
+        record("RI_coulomb_exchange",
+               TimeKernel([&]() { eris.CalculateERIs_EXX_3c(occ, dmat); },
+                          repetitions_));
+      }
+
+      if (DoKernel("4c")) {
+        ERIs eris;
+        record("4c_setup",
+               TimeKernel([&]() { eris.Initialize_4c(basis); }, repetitions_));
+        record("4c_coulomb_exchange",
+               TimeKernel([&]() { eris.CalculateERIs_EXX_4c(dmat, 1e-10); },
+                          repetitions_));
+      }
+
+      if (DoKernel("xc")) {
+        // GridSetup appends to the grid and reuses cached atomic grids, so
+        // every repetition builds a new grid from scratch
+        record("XC_grid", TimeKernel(
+                              [&]() {
+                                Vxc_Grid::ClearAtomGridCache();
+                                Vxc_Grid fresh;
+                                fresh.GridSetup(grid_, mol, basis);
+                              },
+                              repetitions_));
+        Vxc_Grid grid;
+        grid.GridSetup(grid_, mol, basis);
+        Vxc_Potential<Vxc_Grid> vxc(grid);
+        vxc.setXCfunctional(functional_);
+        record("XC_integration",
+               TimeKernel([&]() { vxc.IntegrateVXC(dmat); }, repetitions_));
+      }
+
+      bool needs_gw = DoKernel("rpa") || DoKernel("sigma") ||
+                      DoKernel("bse") || DoKernel("davidson");
+      if (!needs_gw) {
+        continue;
+      }
+      TCMatrix_gwbse Mmn;
+      Mmn.Initialize(auxsize, 0, qpmax, 0, nbasis - 1);
+      Timing fill = TimeKernel([&]() { Mmn.Fill(auxbasis, basis, mos); },
+                               DoKernel("rpa") ? repetitions_ : 1);
+      RPA rpa(log, Mmn);
+      rpa.configure(homo, 0, nbasis - 1);
+      rpa.setRPAInputEnergies(energies);
+
+      if (DoKernel("rpa")) {
+        record("ThreeCenter_MO", fill);
+        record("RPA_epsilon", TimeKernel(
+                                  [&]() {
+                                    rpa.calculate_epsilon_i(0.5);
+                                    rpa.calculate_epsilon_r(0.5);
+                                  },
+                                  repetitions_));
+      }
+
+      if (DoKernel("sigma")) {
+        std::unique_ptr<Sigma_base> sigma = Sigma().Create("ppm", Mmn, rpa);
+        Sigma_base::options opt;
+        opt.homo = homo;
+        opt.qpmin = 0;
+        opt.qpmax = qpmax;
+        opt.rpamin = 0;
+        opt.rpamax = nbasis - 1;
+        opt.eta = 1e-3;
+        opt.alpha = 1e-3;
+        opt.quadrature_scheme = "legendre";
+        opt.order = 12;
+        sigma->configure(opt);
+        record("Sigma_PPM", TimeKernel(
+                                [&]() {
+                                  sigma->PrepareScreening();
+                                  sigma->CalcExchangeMatrix();
+                                  sigma->CalcCorrelationDiag(
+                                      energies.head(qptotal));
+                                },
+                                repetitions_));
+      }
+
+      if (!DoKernel("bse") && !DoKernel("davidson")) {
+        continue;
+      }
+      BSEOperator_Options opt;
+      opt.homo = homo;
+      opt.rpamin = 0;
+      opt.qpmin = 0;
+      opt.vmin = 0;
+      opt.cmax = qpmax;
+      const Eigen::MatrixXd Hqp = energies.head(qptotal).asDiagonal();
+      const Eigen::VectorXd epsilon_0_inv = Eigen::VectorXd::Ones(auxsize);
+      SingletOperator_TDA s_op(epsilon_0_inv, Mmn, Hqp);
+      s_op.configure(opt);
+
+      if (DoKernel("bse")) {
+        const Index nstates = std::min(s_op.size(), Index(20));
+        const Eigen::MatrixXd state =
+            Eigen::MatrixXd::Random(s_op.size(), nstates);
+        record("BSE_matmul",
+               TimeKernel([&]() { Eigen::MatrixXd r = s_op * state; },
+                          repetitions_));
+      }
+
+      if (DoKernel("davidson")) {
+        const Index nroots = std::max(Index(1), std::min(Index(5),
+                                                         s_op.size() / 4));
+        record("Davidson", TimeKernel(
+                               [&]() {
+                                 DavidsonSolver DS(log);
+                                 DS.set_correction("DPR");
+                                 DS.set_tolerance("normal");
+                                 DS.set_size_update("safe");
+                                 DS.set_iter_max(50);
+                                 DS.set_max_search_space(10 * nroots);
+                                 DS.solve(s_op, nroots);
+                               },
+                               repetitions_));
+      }
+    }
+  }
+  OPENMP::setMaxThreads(maxthreads);
+
+  // scaling with the basis set size per thread count and the speedup of
+  // the largest molecule with the number of threads
+  std::cout << "\nScaling t ~ N_basis^x and speedup for the largest molecule"
+            << std::endl;
+  tools::Property& scaling = output.add("scaling", "");
+  for (const auto& [name, perthreads] : timings) {
+    const double reference = perthreads.begin()->second.back();
+    const Index reference_threads = perthreads.begin()->first;
+    for (const auto& [nthreads, times] : perthreads) {
+      double exponent = ScalingExponent(basissizes, times);
+      double speedup = (times.back() > 0.0) ? reference / times.back() : 0.0;
+      std::cout << boost::format("  %-24s threads:%3d  x=%5.2f  speedup "
+                                 "vs %d threads:%6.2f") %
+                       name % nthreads % exponent % reference_threads % speedup
+                << std::endl;
+      tools::Property& kernel = scaling.add("kernel", "");
+      kernel.setAttribute("name", name);
+      kernel.setAttribute("threads", nthreads);
+      kernel.add("exponent", std::to_string(exponent));
+      kernel.add("speedup", std::to_string(speedup));
+    }
+  }
+
+  std::ofstream outputfile(outputfile_);
+  outputfile << output << std::endl;
+  return true;
+}
+
+}  // namespace xtp
+}  // namespace votca
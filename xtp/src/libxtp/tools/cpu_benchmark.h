@@ -0,0 +1,75 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_CPUBENCHMARK_H
+#define VOTCA_XTP_CPUBENCHMARK_H
+
+// Standard includes
+#include <vector>
+
+// Local VOTCA includes
+#include "votca/xtp/qmmolecule.h"
+#include "votca/xtp/qmtool.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Times the DFT and GW-BSE kernels on generated water clusters or
+ * alkanes of increasing size and for several numbers of threads
+ *
+ * No SCF is run, the kernels work on random orthonormal orbitals, so the
+ * timings only depend on the molecule, the basis sets and the hardware. The
+ * timings, the fitted exponents of the scaling with the basis set size and the
+ * speedups with the number of threads are written to an xml file.
+ */
+class CPUBenchmark final : public QMTool {
+ public:
+  CPUBenchmark() = default;
+
+  ~CPUBenchmark() = default;
+  std::string Identify() const { return "cpu_benchmark"; }
+
+  static QMMolecule WaterCluster(Index nmolecules);
+  static QMMolecule Alkane(Index ncarbons);
+
+ protected:
+  void ParseOptions(const tools::Property &user_options);
+  bool Run();
+
+ private:
+  bool DoKernel(const std::string &kernel) const;
+
+  Index repetitions_;
+  std::string outputfile_;
+  std::string molecule_;
+  std::vector<Index> sizes_;
+  std::vector<Index> threads_;
+  std::string basisset_;
+  std::string auxbasisset_;
+  std::string functional_;
+  std::string grid_;
+  std::vector<std::string> kernels_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_CPUBENCHMARK_H
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -21,6 +21,7 @@
 // Local VOTCA includes
 #include "votca/xtp/geometry_optimization.h"
 #include "votca/xtp/gwbseengine.h"
+#include "votca/xtp/profiler.h"
 #include "votca/xtp/qmpackagefactory.h"
 #include "votca/xtp/segment.h"
 #include "votca/xtp/staticregion.h"
@@ -48,6 +49,12 @@ void DftGwBse::ParseOptions(const tools::Property& options) {
   // XML OUTPUT
   xml_output_ = job_name_ + "_summary.xml";
 
+  // timings of the kernels
+  profile_file_ = job_name_ + "_profile";
+  if (options.exists(".profiling")) {
+    do_profile_ = options.get(".profiling").as<bool>();
+  }
+
   if (options.exists(".mpsfile")) {
     mpsfile_ = options.get(".mpsfile").as<std::string>();
   }
@@ -74,6 +81,8 @@ bool DftGwBse::Run() {
   log_.setMultithreading(true);
   log_.setCommonPreface("\n... ...");
 
+  Profiler::Instance().Reset();
+
   // Get orbitals object
   Orbitals orbitals;
 
@@ -128,6 +137,15 @@ bool DftGwBse::Run() {
     ofout << (summary.get("output"));
     ofout.close();
   }
+
+  XTP_LOG(Log::info, log_) << "Kernel timings\n"
+                           << Profiler::Instance().Summary() << std::flush;
+  if (do_profile_) {
+    XTP_LOG(Log::error, log_) << "Writing kernel timings to " << profile_file_
+                              << ".json and .csv" << std::flush;
+    Profiler::Instance().WriteJSON(profile_file_ + ".json");
+    Profiler::Instance().WriteCSV(profile_file_ + ".csv");
+  }
   return true;
 }
 
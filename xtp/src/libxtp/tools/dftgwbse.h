@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -50,6 +50,7 @@ class DftGwBse final : public QMTool {
   std::string xyzfile_;
   std::string xml_output_;    // .xml output
   std::string archive_file_;  // .orb file to parse to
+  std::string profile_file_;  // .json/.csv kernel timings
 
   tools::Property package_options_;
   tools::Property gwbseengine_options_;
@@ -58,6 +59,7 @@ class DftGwBse final : public QMTool {
   Logger log_;
 
   bool do_optimize_;
+  bool do_profile_ = false;
 };
 
 }  // namespace xtp
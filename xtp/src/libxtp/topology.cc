@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -17,6 +17,9 @@
  *
  */
 
+// Standard includes
+#include <stdexcept>
+
 // Third party includes
 #include <boost/lexical_cast.hpp>
 
@@ -28,6 +31,7 @@
 #include "votca/xtp/atom.h"
 #include "votca/xtp/checkpointwriter.h"
 #include "votca/xtp/segment.h"
+#include "votca/xtp/segmentgrid.h"
 #include "votca/xtp/topology.h"
 #include "votca/xtp/version.h"
 
@@ -48,6 +52,7 @@ Topology::Topology(const Topology &top) {
 
 Topology &Topology::operator=(const Topology &top) {
   if (&top != this) {
+    ResetSegmentGrid();
     segments_ = top.segments_;
     time_ = top.time_;
     step_ = top.step_;
@@ -63,6 +68,7 @@ Topology &Topology::operator=(const Topology &top) {
 }
 
 Segment &Topology::AddSegment(std::string segment_name) {
+  ResetSegmentGrid();
   Index segment_id = Index(segments_.size());
   segments_.push_back(Segment(segment_name, segment_id));
   return segments_.back();
@@ -85,6 +91,7 @@ void Topology::setBox(const Eigen::Matrix3d &box,
     }
   }
   bc_.reset(nullptr);
+  ResetSegmentGrid();
   switch (boxtype) {
     case csg::BoundaryCondition::typeTriclinic:
       bc_.reset(new csg::TriclinicBox());
@@ -131,6 +138,18 @@ Eigen::Vector3d Topology::PbShortestConnect(const Eigen::Vector3d &r1,
   return bc_->BCShortestConnection(r1, r2);
 }
 
+std::shared_ptr<const SegmentGrid> Topology::getSegmentGrid() const {
+  std::lock_guard<std::mutex> lock(segment_grid_mutex_);
+  if (segment_grid_ == nullptr) {
+    if (bc_ == nullptr) {
+      throw std::runtime_error("Topology: box has to be set before searching "
+                               "for segments");
+    }
+    segment_grid_ = std::make_shared<const SegmentGrid>(segments_, *bc_);
+  }
+  return segment_grid_;
+}
+
 double Topology::GetShortestDist(const Segment &seg1,
                                  const Segment &seg2) const {
   double R2 = std::numeric_limits<double>::max();
@@ -202,6 +221,7 @@ void Topology::ReadFromCpt(CheckpointReader &r) {
   r(box, "box");
   setBox(box);
   CheckpointReader v = r.openChild("segments");
+  ResetSegmentGrid();
   segments_.clear();
   Index count = v.getNumDataSets();
   segments_.reserve(count);
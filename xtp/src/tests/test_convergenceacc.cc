@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -228,4 +228,81 @@ BOOST_AUTO_TEST_CASE(levelshift_test) {
   libint2::finalize();
 }
 
+BOOST_AUTO_TEST_CASE(continue_history) {
+  libint2::initialize();
+  // uses the molecule and basis set files of levelshift_test
+  Orbitals orbitals;
+  orbitals.QMAtoms().LoadFromFile("molecule.xyz");
+  BasisSet basis;
+  basis.Load("3-21G.xml");
+  AOBasis aobasis;
+  aobasis.Fill(basis, orbitals.QMAtoms());
+  AOOverlap overlap;
+  overlap.Fill(aobasis);
+  AOKinetic kinetic;
+  kinetic.Fill(aobasis);
+  AOMultipole esp;
+  esp.FillPotential(aobasis, orbitals.QMAtoms());
+
+  // a model of the two-electron part, which only depends on the density
+  const Eigen::MatrixXd& S = overlap.Matrix();
+  auto G = [&](const Eigen::MatrixXd& D) -> Eigen::MatrixXd {
+    return 0.05 * D * S * D + 0.1 * D;
+  };
+  auto Energy = [&](const Eigen::MatrixXd& H0, double E0,
+                    const Eigen::MatrixXd& D) {
+    return D.cwiseProduct(H0 + 0.5 * G(D)).sum() + E0;
+  };
+  Eigen::MatrixXd H0_old = kinetic.Matrix() + esp.Matrix();
+  double E0_old = 13.5;
+  // the external potential changes
+  Eigen::MatrixXd H0_new = kinetic.Matrix() + 1.1 * esp.Matrix();
+  double E0_new = 13.8;
+
+  Logger log;
+  ConvergenceAcc::options opt;
+  opt.mode = ConvergenceAcc::KSmode::closed;
+  opt.usediis = true;
+  opt.histlength = 4;
+  opt.maxout = false;
+  opt.adiis_start = 0.8;
+  opt.diis_start = 0.002;
+  opt.levelshift = 0.0;
+  opt.levelshiftend = 0.0;
+  opt.numberofelectrons = 10;
+  opt.mixingparameter = 0.7;
+  opt.Econverged = 1e-7;
+  opt.error_converged = 1e-7;
+
+  ConvergenceAcc previous;
+  previous.setLogger(&log);
+  previous.Configure(opt);
+  previous.setOverlap(overlap, 1e-8);
+  tools::EigenSystem MOs = previous.SolveFockmatrix(H0_old);
+  Eigen::MatrixXd D = previous.DensityMatrix(MOs);
+  for (Index i = 0; i < 6; i++) {
+    Eigen::MatrixXd H = H0_old + G(D);
+    D = previous.Iterate(D, H, MOs, Energy(H0_old, E0_old, D));
+  }
+  BOOST_CHECK_EQUAL(previous.HistorySize(), opt.histlength);
+
+  ConvergenceAcc next;
+  next.setLogger(&log);
+  next.Configure(opt);
+  next.setOverlap(overlap, 1e-8);
+  next.ContinueHistory(previous.getHistory(), H0_new - H0_old,
+                       E0_new - E0_old);
+
+  ConvergenceAcc::History history = next.getHistory();
+  BOOST_CHECK_EQUAL(history.fock.size(), opt.histlength);
+  for (Index i = 0; i < Index(history.fock.size()); i++) {
+    const Eigen::MatrixXd& Dmat = history.dmats[i];
+    Eigen::MatrixXd F_ref = H0_new + G(Dmat);
+    BOOST_CHECK(history.fock[i].isApprox(F_ref, 1e-10));
+    BOOST_CHECK_CLOSE(history.energies[i], Energy(H0_new, E0_new, Dmat),
+                      1e-8);
+  }
+  libint2::finalize();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
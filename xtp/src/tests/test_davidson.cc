@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -390,4 +390,91 @@ BOOST_AUTO_TEST_CASE(davidson_hamiltonian_matrix_free_large) {
   BOOST_CHECK_EQUAL(check_eigenvectors, 1);
 }
 
+BOOST_AUTO_TEST_CASE(davidson_full_matrix_guess) {
+
+  Index size = 200;
+  Index neigen = 10;
+  Eigen::MatrixXd A = init_matrix(size, 0.01);
+  Logger log;
+  DavidsonSolver DS(log);
+  DS.solve(A, neigen);
+
+  // a slightly different matrix, e.g. at a neighbouring geometry
+  Eigen::MatrixXd B = init_matrix(size, 0.012);
+  DavidsonSolver DS_cold(log);
+  DS_cold.solve(B, neigen);
+  DavidsonSolver DS_warm(log);
+  DS_warm.set_initial_guess(DS.eigenvectors());
+  DS_warm.solve(B, neigen);
+
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(B);
+  auto lambda_ref = es.eigenvalues().head(neigen);
+  BOOST_CHECK(DS_warm.eigenvalues().isApprox(lambda_ref, 1E-6));
+  BOOST_CHECK(DS_warm.num_iterations() <= DS_cold.num_iterations());
+}
+
+BOOST_AUTO_TEST_CASE(davidson_late_root) {
+
+  // the decoupled first unit vector converges right away, the lowest root
+  // has almost no overlap with the initial guess, shows up later and moves
+  // the converged root to the next index
+  Index size = 200;
+  Index neigen = 5;
+  Eigen::VectorXd w = Eigen::VectorXd::Ones(size);
+  w.head(50) *= 0.05;
+  w(0) = 0.0;
+  w.normalize();
+  Eigen::MatrixXd A = init_matrix(size, 0.01);
+  A.row(0).setZero();
+  A.col(0).setZero();
+  A(0, 0) = 0.5;
+  A -= 15 * w * w.transpose();
+
+  Logger log;
+  DavidsonSolver DS(log);
+  DS.set_tolerance("strict");
+  DS.set_iter_max(200);
+  DS.solve(A, neigen);
+
+  BOOST_CHECK(DS.info() == Eigen::ComputationInfo::Success);
+
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(A);
+  BOOST_CHECK(DS.eigenvalues().isApprox(es.eigenvalues().head(neigen), 1E-6));
+  Eigen::MatrixXd residues =
+      A * DS.eigenvectors() - DS.eigenvectors() * DS.eigenvalues().asDiagonal();
+  BOOST_CHECK(residues.colwise().norm().maxCoeff() < 1E-5);
+}
+
+BOOST_AUTO_TEST_CASE(davidson_dependent_guess) {
+
+  Index size = 200;
+  Index neigen = 10;
+  Eigen::MatrixXd A = init_matrix(size, 0.01);
+  Logger log;
+  DavidsonSolver DS(log);
+  DS.solve(A, neigen);
+
+  // all but the first columns are almost copies of the first one
+  Eigen::MatrixXd guess = DS.eigenvectors();
+  for (Index i = 1; i < neigen; i++) {
+    guess.col(i) = guess.col(0) + 1E-14 * DS.eigenvectors().col(i);
+  }
+
+  // a single iteration applies the operator to the initial guess only, so it
+  // must have the full size
+  DavidsonSolver DS_single(log);
+  DS_single.set_iter_max(1);
+  DS_single.set_initial_guess(guess);
+  DS_single.solve(A, neigen);
+  BOOST_CHECK_EQUAL(DS_single.num_operator_applications(), 2 * neigen);
+
+  DavidsonSolver DS_warm(log);
+  DS_warm.set_initial_guess(guess);
+  DS_warm.solve(A, neigen);
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(A);
+  BOOST_CHECK(DS_warm.info() == Eigen::ComputationInfo::Success);
+  BOOST_CHECK(
+      DS_warm.eigenvalues().isApprox(es.eigenvalues().head(neigen), 1E-6));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
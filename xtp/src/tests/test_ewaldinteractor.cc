@@ -0,0 +1,248 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE ewaldinteractor_test
+
+// Third party includes
+#include <boost/test/tools/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/xtp/dipoledipoleinteraction.h"
+#include "votca/xtp/eeinteractor.h"
+#include "votca/xtp/ewaldinteractor.h"
+
+using namespace votca::xtp;
+using namespace votca;
+
+BOOST_AUTO_TEST_SUITE(ewaldinteractor_test)
+
+std::vector<PolarSegment> NaClCell(double a) {
+  std::vector<PolarSegment> segments;
+  Index id = 0;
+  for (Index x = 0; x < 2; x++) {
+    for (Index y = 0; y < 2; y++) {
+      for (Index z = 0; z < 2; z++) {
+        Vector9d mpoles = Vector9d::Zero();
+        mpoles[0] = ((x + y + z) % 2 == 0) ? 1.0 : -1.0;
+        PolarSite site(0, "Na");
+        site.setMultipole(mpoles, 0);
+        site.setpolarization(Eigen::Matrix3d::Identity());
+        site.setPos(0.5 * a * Eigen::Vector3d(double(x), double(y), double(z)));
+        PolarSegment seg("ion", id);
+        seg.push_back(site);
+        segments.push_back(seg);
+        id++;
+      }
+    }
+  }
+  return segments;
+}
+
+BOOST_AUTO_TEST_CASE(madelung_nacl) {
+  double a = 10.0;
+  std::vector<PolarSegment> segments = NaClCell(a);
+  Eigen::Matrix3d box = a * Eigen::Matrix3d::Identity();
+  eeInteractor interactor;
+  // 4 ion pairs per conventional cell, nearest neighbour distance a/2
+  double madelung = 1.747564594633;
+  double e_ref = -4.0 * madelung / (0.5 * a);
+
+  EwaldInteractor ewald(box, 4.5, 1e-10, interactor, segments);
+  BOOST_CHECK_CLOSE(ewald.StaticEnergy(), e_ref, 1e-6);
+
+  // the result must not depend on the splitting between the two sums
+  EwaldInteractor ewald2(box, 3.0, 1e-12, interactor, segments);
+  BOOST_CHECK_CLOSE(ewald2.StaticEnergy(), e_ref, 1e-6);
+  BOOST_CHECK(ewald2.Alpha() > ewald.Alpha());
+
+  // the field vanishes at every ion by symmetry
+  BOOST_CHECK(ewald.StaticField().bottomRows<3>().isZero(1e-8));
+}
+
+std::vector<PolarSegment> TwoMolecules() {
+  Vector9d charge = Vector9d::Zero();
+  Vector9d dipole = Vector9d::Zero();
+  std::vector<PolarSegment> segments;
+
+  PolarSegment seg1("one", 0);
+  PolarSite a(0, "C", Eigen::Vector3d(0.0, 0.0, 0.0));
+  charge[0] = 0.4;
+  a.setMultipole(charge, 0);
+  a.setpolarization(2 * Eigen::Matrix3d::Identity());
+  PolarSite b(1, "O", Eigen::Vector3d(1.2, 0.3, -0.4));
+  charge[0] = -0.4;
+  b.setMultipole(charge, 0);
+  b.setpolarization(1.5 * Eigen::Matrix3d::Identity());
+  seg1.push_back(a);
+  seg1.push_back(b);
+  segments.push_back(seg1);
+
+  PolarSegment seg2("two", 1);
+  PolarSite c(2, "N", Eigen::Vector3d(3.5, 1.0, 0.5));
+  dipole << 0.1, 0.3, -0.2, 0.5, 0, 0, 0, 0, 0;
+  c.setMultipole(dipole, 1);
+  c.setpolarization(1.8 * Eigen::Matrix3d::Identity());
+  PolarSite d(3, "H", Eigen::Vector3d(4.2, 2.1, 1.1));
+  dipole << -0.1, -0.2, 0.1, 0.1, 0, 0, 0, 0, 0;
+  d.setMultipole(dipole, 1);
+  d.setpolarization(0.7 * Eigen::Matrix3d::Identity());
+  seg2.push_back(c);
+  seg2.push_back(d);
+  segments.push_back(seg2);
+  return segments;
+}
+
+BOOST_AUTO_TEST_CASE(large_box_limit) {
+  std::vector<PolarSegment> segments = TwoMolecules();
+  eeInteractor interactor(0.39);
+  // the periodic images are so far away that their influence is negligible
+  Eigen::Matrix3d box = 200 * Eigen::Matrix3d::Identity();
+  EwaldInteractor ewald(box, 60.0, 1e-8, interactor, segments);
+
+  double e_ref = interactor.CalcStaticEnergy(segments[0], segments[1]);
+  BOOST_CHECK_CLOSE(ewald.StaticEnergy(), e_ref, 1e-2);
+
+  std::vector<PolarSegment> ref = segments;
+  interactor.ApplyStaticField<PolarSegment, Estatic::noE_V>(ref[1], ref[0]);
+  interactor.ApplyStaticField<PolarSegment, Estatic::noE_V>(ref[0], ref[1]);
+  Index index = 0;
+  for (const PolarSegment& seg : ref) {
+    for (const PolarSite& site : seg) {
+      Eigen::Vector3d field = ewald.StaticField().block<3, 1>(1, index);
+      BOOST_CHECK(field.isApprox(site.V_noE(), 1e-4));
+      index++;
+    }
+  }
+
+  for (Index i = 0; i < 4; i++) {
+    const PolarSite& site1 = segments[i / 2][i % 2];
+    for (Index j = 0; j < 4; j++) {
+      if (i == j) {
+        BOOST_CHECK(ewald.DipoleTensor(i, i).isZero(1e-5));
+        continue;
+      }
+      const PolarSite& site2 = segments[j / 2][j % 2];
+      Eigen::Matrix3d ref_tensor =
+          interactor.FillTholeInteraction(site1, site2);
+      BOOST_CHECK(ewald.DipoleTensor(i, j).isApprox(ref_tensor, 1e-4));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(induced_field) {
+  std::vector<PolarSegment> segments = TwoMolecules();
+  eeInteractor interactor(0.39);
+  Eigen::Matrix3d box;
+  box << 8, 1, 0.5, 0, 9, 1, 0, 0, 10;
+  EwaldInteractor ewald(box, 3.5, 1e-9, interactor, segments);
+
+  Eigen::MatrixXd tensor = Eigen::MatrixXd::Zero(12, 12);
+  for (Index i = 0; i < 4; i++) {
+    for (Index j = 0; j < 4; j++) {
+      tensor.block<3, 3>(3 * i, 3 * j) = ewald.DipoleTensor(i, j);
+    }
+  }
+  BOOST_CHECK(tensor.isApprox(tensor.transpose(), 1e-10));
+
+  Eigen::VectorXd dipoles(12);
+  dipoles << 0.1, -0.2, 0.3, 0.05, 0.0, -0.1, 0.2, 0.2, 0.1, -0.3, 0.1, 0.0;
+  Eigen::VectorXd field = ewald.InducedField(dipoles);
+  Eigen::VectorXd field_ref = tensor * dipoles;
+  BOOST_CHECK(field.isApprox(field_ref, 1e-8));
+
+  // the operator for the solver is the same with and without matrix
+  // representation
+  DipoleDipoleInteraction A(interactor, segments, &ewald);
+  Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(12, 12);
+  for (Index i = 0; i < 12; i++) {
+    for (Index j = 0; j < 12; j++) {
+      dense(i, j) = A(i, j);
+    }
+  }
+  Eigen::VectorXd product = A * dipoles;
+  BOOST_CHECK(product.isApprox(dense * dipoles, 1e-8));
+}
+
+std::vector<PolarSegment> RandomMolecules(const Eigen::Matrix3d& box,
+                                          Index number) {
+  std::srand(7);
+  std::vector<PolarSegment> segments;
+  Index id = 0;
+  for (Index s = 0; s < number; s++) {
+    PolarSegment seg("mol", s);
+    Eigen::Vector3d center =
+        box * (0.5 * (Eigen::Vector3d::Random().array() + 1.0)).matrix();
+    for (Index k = 0; k < 2; k++) {
+      Vector9d mpoles = Vector9d::Zero();
+      mpoles[0] = (k == 0) ? 0.3 : -0.3;
+      mpoles.segment<3>(1) = 0.2 * Eigen::Vector3d::Random();
+      PolarSite site(id, "C", center + Eigen::Vector3d::Random());
+      site.setMultipole(mpoles, 1);
+      site.setpolarization(Eigen::Matrix3d::Identity());
+      seg.push_back(site);
+      id++;
+    }
+    segments.push_back(seg);
+  }
+  return segments;
+}
+
+BOOST_AUTO_TEST_CASE(particle_mesh) {
+  Eigen::Matrix3d box;
+  box << 20, 2, 1, 0, 18, 2, 0, 0, 22;
+  std::vector<PolarSegment> segments = RandomMolecules(box, 30);
+  eeInteractor interactor(0.39);
+  EwaldInteractor kvectors(box, 7.0, 1e-8, interactor, segments,
+                           EwaldInteractor::Reciprocal::kvectors);
+  EwaldInteractor mesh(box, 7.0, 1e-8, interactor, segments,
+                       EwaldInteractor::Reciprocal::mesh);
+  BOOST_CHECK(!kvectors.UsesMesh());
+  BOOST_CHECK(mesh.UsesMesh());
+  BOOST_CHECK(mesh.MeshSize().minCoeff() > 0);
+
+  double scale = kvectors.StaticField().cwiseAbs().maxCoeff();
+  BOOST_CHECK(
+      (mesh.StaticField() - kvectors.StaticField()).cwiseAbs().maxCoeff() <
+      1e-6 * scale);
+  BOOST_CHECK_CLOSE(mesh.StaticEnergy(), kvectors.StaticEnergy(), 1e-4);
+
+  Eigen::VectorXd dipoles = 0.1 * Eigen::VectorXd::Random(3 * 60);
+  Eigen::VectorXd field_ref = kvectors.InducedField(dipoles);
+  Eigen::VectorXd field = mesh.InducedField(dipoles);
+  BOOST_CHECK((field - field_ref).cwiseAbs().maxCoeff() <
+              1e-6 * field_ref.cwiseAbs().maxCoeff());
+
+  // the preconditioner only sees the diagonal blocks
+  DipoleDipoleInteraction A(interactor, segments, &mesh);
+  Index visited = 0;
+  for (DipoleDipoleInteraction::InnerIterator it(A, 4); it; ++it) {
+    BOOST_CHECK_EQUAL(it.row() / 3, 1);
+    visited++;
+  }
+  BOOST_CHECK_EQUAL(visited, 3);
+}
+
+BOOST_AUTO_TEST_CASE(reject_too_large_cutoff) {
+  std::vector<PolarSegment> segments = TwoMolecules();
+  eeInteractor interactor;
+  Eigen::Matrix3d box = 10 * Eigen::Matrix3d::Identity();
+  BOOST_CHECK_THROW(EwaldInteractor(box, 5.5, 1e-8, interactor, segments),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE externalprocesspool_test
+
+// Standard includes
+#include <fstream>
+#include <future>
+#include <thread>
+#include <vector>
+
+// Third party includes
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/xtp/externalprocesspool.h"
+
+using namespace votca::xtp;
+using namespace votca;
+
+BOOST_AUTO_TEST_SUITE(externalprocesspool_test)
+
+BOOST_AUTO_TEST_CASE(exit_status) {
+  ExternalProcessPool pool;
+  BOOST_CHECK_EQUAL(pool.Run("true", ""), 0);
+  BOOST_CHECK_EQUAL(pool.Run("exit 3", ""), 3);
+  BOOST_CHECK_EQUAL(pool.Running(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(workdir) {
+  boost::filesystem::path dir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("xtp_pool_%%%%-%%%%");
+  boost::filesystem::create_directories(dir);
+  ExternalProcessPool pool;
+  BOOST_CHECK_EQUAL(pool.Run("echo mock > out.log", dir.string()), 0);
+  std::ifstream in((dir / "out.log").string());
+  std::string line;
+  std::getline(in, line);
+  BOOST_CHECK_EQUAL(line, "mock");
+  BOOST_CHECK(pool.Run("true", (dir / "missing").string()) != 0);
+  boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(limit_in_flight) {
+  ExternalProcessPool pool;
+  pool.setMaxProcesses(2);
+  // one job thread per mock QM program, the pool lets only two run
+  std::vector<Index> results(6, -1);
+  std::vector<std::thread> jobs;
+  for (Index i = 0; i < 6; i++) {
+    jobs.emplace_back([&pool, &results, i]() {
+      results[i] = pool.Run("sleep 0.1; exit " + std::to_string(i), "");
+    });
+  }
+  for (std::thread& job : jobs) {
+    job.join();
+  }
+  for (Index i = 0; i < 6; i++) {
+    BOOST_CHECK_EQUAL(results[i], i);
+  }
+  BOOST_CHECK(pool.PeakRunning() <= 2);
+  BOOST_CHECK(pool.PeakRunning() >= 1);
+  BOOST_CHECK_EQUAL(pool.Running(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(submit_from_one_thread) {
+  ExternalProcessPool pool;
+  pool.setMaxProcesses(3);
+  // a single job thread keeps several mock QM programs in flight
+  std::vector<std::future<Index>> runs;
+  for (Index i = 0; i < 6; i++) {
+    runs.push_back(pool.Submit("sleep 0.2; exit " + std::to_string(i), ""));
+  }
+  for (Index i = 0; i < 6; i++) {
+    BOOST_CHECK_EQUAL(runs[i].get(), i);
+  }
+  BOOST_CHECK_EQUAL(pool.PeakRunning(), 3);
+  BOOST_CHECK_EQUAL(pool.Running(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -24,6 +24,7 @@
 #include <boost/test/unit_test.hpp>
 
 // Local VOTCA includes
+#include <votca/xtp/checkpoint.h>
 #include <votca/xtp/filterfactory.h>
 
 // VOTCA includes
@@ -118,6 +119,37 @@ BOOST_AUTO_TEST_CASE(coeffs_test) {
     BOOST_CHECK_EQUAL(ref3[i], results3[i]);
   }
 
+  // older checkpoints only contain the AO representation of the exciton
+  {
+    Eigen::MatrixXd occ = A.MOs().eigenvectors().middleCols(0, 5);
+    Eigen::MatrixXd virt = A.MOs().eigenvectors().middleCols(5, 12);
+    Eigen::VectorXd exciton = spsi_ref.col(1);
+    Eigen::Map<const Eigen::MatrixXd> mat(exciton.data(), 12, 5);
+    Eigen::MatrixXd ao = occ * mat.transpose() * virt.transpose();
+    Eigen::VectorXd aocoeffs =
+        Eigen::Map<const Eigen::VectorXd>(ao.data(), ao.size());
+    double threshold = 0.0045;
+    {
+      CheckpointFile cpf("overlap_filter_legacy.hdf5",
+                         CheckpointAccessLevel::CREATE);
+      CheckpointWriter w = cpf.getWriter();
+      w(aocoeffs, "laststatecoeff");
+      w(threshold, "threshold");
+    }
+    CheckpointFile cpf("overlap_filter_legacy.hdf5",
+                       CheckpointAccessLevel::READ);
+    CheckpointReader r = cpf.getReader();
+    std::unique_ptr<StateFilter_base> legacy =
+        std::unique_ptr<StateFilter_base>(Filter().Create("overlap"));
+    legacy->ReadFromCpt(r);
+    std::vector<votca::Index> results_legacy =
+        legacy->CalcIndeces(A, QMStateType::Singlet);
+    BOOST_CHECK_EQUAL(results_legacy.size(), ref2.size());
+    for (votca::Index i = 0; i < votca::Index(ref2.size()); i++) {
+      BOOST_CHECK_EQUAL(ref2[i], results_legacy[i]);
+    }
+  }
+
   // reference energy
   Eigen::VectorXd se_ref_btda = Eigen::VectorXd::Zero(3);
   se_ref_btda << 0.0887758, 0.0887758, 0.0887758;
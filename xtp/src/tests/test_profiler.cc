@@ -0,0 +1,101 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE profiler_test
+
+// Standard includes
+#include <fstream>
+#include <sstream>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/xtp/profiler.h"
+
+using namespace votca::xtp;
+using namespace votca;
+
+BOOST_AUTO_TEST_SUITE(profiler_test)
+
+BOOST_AUTO_TEST_CASE(record_kernels) {
+  Profiler::Instance().Reset();
+  for (Index i = 0; i < 3; i++) {
+    ProfileScope profile("outer", 100.0);
+    {
+      ProfileScope inner("inner");
+      inner.addFlops(10.0);
+      Eigen::MatrixXd a = Eigen::MatrixXd::Random(50, 50);
+      Eigen::MatrixXd b = a * a;
+    }
+  }
+  std::map<std::string, Profiler::Kernel> kernels =
+      Profiler::Instance().Kernels();
+  BOOST_REQUIRE_EQUAL(Index(kernels.size()), 2);
+  BOOST_CHECK_EQUAL(kernels["outer"].calls, 3);
+  BOOST_CHECK_EQUAL(kernels["inner"].calls, 3);
+  BOOST_CHECK_CLOSE(kernels["outer"].flops, 300.0, 1e-10);
+  BOOST_CHECK_CLOSE(kernels["inner"].flops, 30.0, 1e-10);
+  // times are inclusive
+  BOOST_CHECK(kernels["outer"].wall >= kernels["inner"].wall);
+  BOOST_CHECK(kernels["outer"].peak_memory > 0);
+
+  std::string summary = Profiler::Instance().Summary();
+  BOOST_CHECK(summary.find("outer") != std::string::npos);
+  BOOST_CHECK(summary.find("inner") != std::string::npos);
+
+  Profiler::Instance().Reset();
+  BOOST_CHECK(Profiler::Instance().Kernels().empty());
+}
+
+BOOST_AUTO_TEST_CASE(inside_parallel_region) {
+  Profiler::Instance().Reset();
+#pragma omp parallel for
+  for (Index i = 0; i < 4; i++) {
+    ProfileScope profile("parallel");
+  }
+  if (OPENMP::getMaxThreads() > 1) {
+    BOOST_CHECK(Profiler::Instance().Kernels().empty());
+  }
+  Profiler::Instance().Reset();
+}
+
+BOOST_AUTO_TEST_CASE(write_files) {
+  Profiler::Instance().Reset();
+  { ProfileScope profile("kernel", 42.0); }
+  Profiler::Instance().WriteCSV("profiler_test.csv");
+  Profiler::Instance().WriteJSON("profiler_test.json");
+
+  std::ifstream csv("profiler_test.csv");
+  std::string header;
+  std::string line;
+  std::getline(csv, header);
+  std::getline(csv, line);
+  BOOST_CHECK_EQUAL(header,
+                    "name,calls,wall,cpu,flops,peak_memory_kb,"
+                    "memory_growth_kb");
+  BOOST_CHECK_EQUAL(line.substr(0, 9), "kernel,1,");
+
+  std::ifstream json("profiler_test.json");
+  std::stringstream content;
+  content << json.rdbuf();
+  BOOST_CHECK(content.str().find("\"name\": \"kernel\"") != std::string::npos);
+  BOOST_CHECK(content.str().find("\"flops\": 42") != std::string::npos);
+  Profiler::Instance().Reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE scfhistory_test
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/xtp/scfhistory.h"
+
+using namespace votca::xtp;
+using namespace votca;
+
+BOOST_AUTO_TEST_SUITE(scfhistory_test)
+
+BOOST_AUTO_TEST_CASE(extrapolation) {
+  Eigen::MatrixXd D0 = Eigen::MatrixXd::Random(5, 5);
+  Eigen::MatrixXd step = 0.01 * Eigen::MatrixXd::Random(5, 5);
+  Eigen::MatrixXd curve = 0.001 * Eigen::MatrixXd::Random(5, 5);
+  auto density = [&](double t) { return D0 + t * step + t * t * curve; };
+
+  ConvergenceAcc acc;
+  Mat_p_Energy H0(5, 5);
+
+  SCFHistory constant(0);
+  SCFHistory linear(1);
+  SCFHistory quadratic(2);
+  BOOST_CHECK(!linear.Compatible(5, 10));
+  for (Index i = 0; i < 4; i++) {
+    constant.Store(acc, H0, density(double(i)), 10);
+    linear.Store(acc, H0, density(double(i)), 10);
+    quadratic.Store(acc, H0, density(double(i)), 10);
+  }
+  BOOST_CHECK_EQUAL(constant.size(), 1);
+  BOOST_CHECK_EQUAL(linear.size(), 2);
+  BOOST_CHECK_EQUAL(quadratic.size(), 3);
+  BOOST_CHECK(linear.Compatible(5, 10));
+  BOOST_CHECK(!linear.Compatible(5, 12));
+  BOOST_CHECK(!linear.Compatible(6, 10));
+
+  BOOST_CHECK(constant.ExtrapolatedDensity().isApprox(density(3.0), 1e-12));
+  // a quadratic extrapolation is exact for a quadratic sequence
+  BOOST_CHECK(quadratic.ExtrapolatedDensity().isApprox(density(4.0), 1e-10));
+  Eigen::MatrixXd linear_ref = 2 * density(3.0) - density(2.0);
+  BOOST_CHECK(linear.ExtrapolatedDensity().isApprox(linear_ref, 1e-12));
+}
+
+BOOST_AUTO_TEST_CASE(lower_order_at_start) {
+  ConvergenceAcc acc;
+  Mat_p_Energy H0(3, 3);
+  SCFHistory quadratic(2);
+  Eigen::MatrixXd D = Eigen::MatrixXd::Identity(3, 3);
+  quadratic.Store(acc, H0, D, 2);
+  BOOST_CHECK(quadratic.ExtrapolatedDensity().isApprox(D, 1e-12));
+  quadratic.Store(acc, H0, 2 * D, 2);
+  BOOST_CHECK(quadratic.ExtrapolatedDensity().isApprox(3 * D, 1e-12));
+
+  // a different molecule starts a new history
+  quadratic.Store(acc, H0, Eigen::MatrixXd::Identity(4, 4), 2);
+  BOOST_CHECK_EQUAL(quadratic.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE segmentgrid_test
+
+// Standard includes
+#include <random>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/xtp/atom.h"
+#include "votca/xtp/segment.h"
+#include "votca/xtp/segmentgrid.h"
+#include "votca/xtp/topology.h"
+
+using namespace votca::xtp;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(segmentgrid_test)
+
+Topology RandomTopology(const Eigen::Matrix3d& box, Index nsegs) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  Topology top;
+  top.setBox(box);
+  Eigen::Matrix3d cell = box;
+  if (box.isApproxToConstant(0)) {
+    cell = 20 * Eigen::Matrix3d::Identity();
+  }
+  for (Index i = 0; i < nsegs; i++) {
+    Segment& seg = top.AddSegment("A");
+    // also place some segments outside the box
+    Eigen::Vector3d s(1.4 * dist(gen) - 0.2, 1.4 * dist(gen) - 0.2,
+                      1.4 * dist(gen) - 0.2);
+    seg.push_back(Atom(i, "C", i, cell * s, "C"));
+  }
+  return top;
+}
+
+void CheckAgainstBruteForce(const Topology& top, double radius) {
+  std::shared_ptr<const SegmentGrid> grid = top.getSegmentGrid();
+  BOOST_CHECK_EQUAL(grid->NumberOfSegments(), Index(top.Segments().size()));
+  for (const Segment& center : top.Segments()) {
+    std::vector<Index> ref;
+    for (const Segment& other : top.Segments()) {
+      if (top.PbShortestConnect(center.getPos(), other.getPos()).norm() <
+          radius) {
+        ref.push_back(other.getId());
+      }
+    }
+    std::vector<Index> result =
+        grid->FindSegmentsWithin(center.getPos(), radius);
+    BOOST_REQUIRE_EQUAL(result.size(), ref.size());
+    for (Index i = 0; i < Index(ref.size()); i++) {
+      BOOST_CHECK_EQUAL(result[i], ref[i]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(orthorhombic_test) {
+  Eigen::Matrix3d box = Eigen::Matrix3d::Zero();
+  box.diagonal() << 20, 25, 30;
+  Topology top = RandomTopology(box, 400);
+  CheckAgainstBruteForce(top, 3.0);
+  CheckAgainstBruteForce(top, 9.9);
+}
+
+BOOST_AUTO_TEST_CASE(triclinic_test) {
+  Eigen::Matrix3d box;
+  box << 20, 6, 4, 0, 22, 5, 0, 0, 24;
+  Topology top = RandomTopology(box, 400);
+  BOOST_CHECK(top.getSegmentGrid()->NumberOfCells()[0] > 1);
+  CheckAgainstBruteForce(top, 3.0);
+  CheckAgainstBruteForce(top, 9.9);
+}
+
+BOOST_AUTO_TEST_CASE(open_test) {
+  Topology top = RandomTopology(Eigen::Matrix3d::Zero(), 400);
+  CheckAgainstBruteForce(top, 3.0);
+  CheckAgainstBruteForce(top, 50.0);
+  // far away from all segments
+  BOOST_CHECK(top.getSegmentGrid()
+                  ->FindSegmentsWithin(Eigen::Vector3d::Constant(1000), 3.0)
+                  .empty());
+}
+
+BOOST_AUTO_TEST_CASE(invalidate_test) {
+  Eigen::Matrix3d box = 10 * Eigen::Matrix3d::Identity();
+  Topology top = RandomTopology(box, 10);
+  std::shared_ptr<const SegmentGrid> old = top.getSegmentGrid();
+  BOOST_CHECK_EQUAL(old->NumberOfSegments(), 10);
+  Segment& seg = top.AddSegment("B");
+  seg.push_back(Atom(10, "C", 10, Eigen::Vector3d::Constant(5), "C"));
+  // the grid handed out before the change is still alive
+  BOOST_CHECK_EQUAL(old->NumberOfSegments(), 10);
+  std::shared_ptr<const SegmentGrid> grid = top.getSegmentGrid();
+  BOOST_CHECK_EQUAL(grid->NumberOfSegments(), 11);
+  std::vector<Index> found =
+      grid->FindSegmentsWithin(Eigen::Vector3d::Constant(5), 1e-3);
+  BOOST_REQUIRE_EQUAL(found.size(), 1);
+  BOOST_CHECK_EQUAL(found[0], 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -205,4 +205,56 @@ BOOST_AUTO_TEST_CASE(mapping_test_no_weights) {
     BOOST_CHECK_EQUAL(qmmol[i].getId(), id_ref[i]);
   }
 }
+
+BOOST_AUTO_TEST_CASE(template_cache_test) {
+
+  Logger log;
+  QMMapper mapper = QMMapper(log);
+  mapper.LoadMappingFile(std::string(XTP_TEST_DATA_FOLDER) +
+                         "/segmentmapper/ch4.xml");
+  QMMapper::ClearTemplateCache();
+  BOOST_CHECK_EQUAL(QMMapper::TemplateCacheSize(), 0);
+
+  std::string coordfile =
+      std::string(XTP_TEST_DATA_FOLDER) + "/segmentmapper/molecule.xyz";
+  std::vector<Segment> segs;
+  for (Index segid = 0; segid < 2; segid++) {
+    Segment seg("Methane", segid);
+    Index offset = 5 * segid;
+    Eigen::Vector3d shift = 3.0 * double(segid) * Eigen::Vector3d::UnitZ();
+    seg.push_back(Atom(1, "CB", 5 + offset, shift, "C"));
+    seg.push_back(Atom(1, "HB1", 6 + offset, Eigen::Vector3d::UnitX() + shift,
+                       "H"));
+    seg.push_back(Atom(1, "HB2", 7 + offset, Eigen::Vector3d::UnitY() + shift,
+                       "H"));
+    seg.push_back(Atom(1, "HB3", 8 + offset,
+                       -Eigen::Vector3d::UnitX() + shift, "H"));
+    seg.push_back(Atom(1, "HB4", 9 + offset,
+                       -Eigen::Vector3d::UnitY() + shift, "H"));
+    segs.push_back(seg);
+  }
+
+  QMMolecule mol0 = mapper.map(segs[0], coordfile);
+  QMMolecule mol1 = mapper.map(segs[1], coordfile);
+  // the file is only parsed once
+  BOOST_CHECK_EQUAL(QMMapper::TemplateCacheSize(), 1);
+  // mapping again from the cache gives the same result
+  QMMolecule mol0_again = mapper.map(segs[0], coordfile);
+
+  BOOST_CHECK_EQUAL(mol0.getId(), 0);
+  BOOST_CHECK_EQUAL(mol1.getId(), 1);
+  BOOST_CHECK_EQUAL(mol1.getType(), "Methane");
+  BOOST_REQUIRE_EQUAL(mol0.size(), mol1.size());
+  BOOST_REQUIRE_EQUAL(mol0.size(), mol0_again.size());
+  Eigen::Vector3d shift = 3.0 * Eigen::Vector3d::UnitZ();
+  for (Index i = 0; i < mol0.size(); i++) {
+    BOOST_CHECK_EQUAL(mol0[i].getElement(), mol1[i].getElement());
+    BOOST_CHECK(mol0[i].getPos().isApprox(mol0_again[i].getPos(), 1e-12));
+    BOOST_CHECK(mol1[i].getPos().isApprox(mol0[i].getPos() + shift, 1e-5));
+  }
+
+  QMMapper::ClearTemplateCache();
+  BOOST_CHECK_EQUAL(QMMapper::TemplateCacheSize(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
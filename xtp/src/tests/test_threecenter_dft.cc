@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -73,6 +73,45 @@ BOOST_AUTO_TEST_CASE(small_basis) {
   libint2::finalize();
 }
 
+BOOST_AUTO_TEST_CASE(contractions) {
+  libint2::initialize();
+  QMMolecule mol(" ", 0);
+  mol.LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) +
+                   "/threecenter_dft/molecule.xyz");
+  BasisSet basis;
+  basis.Load(std::string(XTP_TEST_DATA_FOLDER) + "/threecenter_dft/3-21G.xml");
+  AOBasis aobasis;
+  aobasis.Fill(basis, mol);
+  TCMatrix_dft threec;
+  threec.Fill(aobasis, aobasis);
+
+  Index size = aobasis.AOBasisSize();
+  Eigen::MatrixXd dmat = Eigen::MatrixXd::Random(size, size);
+  dmat = (dmat + dmat.transpose()).eval();
+  Eigen::MatrixXd V = Eigen::MatrixXd::Random(size, 2);
+
+  Eigen::VectorXd gamma_ref = Eigen::VectorXd::Zero(threec.size());
+  Eigen::MatrixXd J_ref = Eigen::MatrixXd::Zero(size, size);
+  Eigen::MatrixXd Y_ref = Eigen::MatrixXd::Zero(2 * threec.size(), size);
+  for (Index i = 0; i < threec.size(); i++) {
+    Eigen::MatrixXd B = threec[i].FullMatrix();
+    gamma_ref(i) = B.cwiseProduct(dmat).sum();
+    Y_ref.row(i) = (B * V.col(0)).transpose();
+    Y_ref.row(threec.size() + i) = (B * V.col(1)).transpose();
+  }
+  for (Index i = 0; i < threec.size(); i++) {
+    J_ref += gamma_ref(i) * threec[i].FullMatrix();
+  }
+
+  Eigen::VectorXd gamma = threec.ContractDensity(dmat);
+  BOOST_CHECK(gamma.isApprox(gamma_ref, 1e-10));
+  BOOST_CHECK(threec.ContractAux(gamma).isApprox(J_ref, 1e-10));
+  BOOST_CHECK(threec.MultiplyVectors(V).isApprox(Y_ref, 1e-10));
+  BOOST_CHECK(threec.NumberOfShellPairs() <= threec.NumberOfAllShellPairs());
+
+  libint2::finalize();
+}
+
 /*BOOST_AUTO_TEST_CASE(large_l_test) {
 
   QMMolecule mol("C", 0);
@@ -1,6 +1,6 @@
 
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2023 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -42,6 +42,8 @@ class XtpRun final : public xtp::StateApplication {
   bool savetoStateFile() const final { return calc_->WriteToStateFile(); }
 
   bool EvaluateFrame(votca::xtp::Topology& top) final;
+  Index PrepareConcurrentFrames(Index requested) final;
+  bool EvaluateFrameOnWorker(votca::xtp::Topology& top, Index worker) final;
   std::string CalculatorType() const { return "Calculator"; }
   void CheckOptions() final{};
   std::vector<std::string> CalculatorNames() const {
@@ -52,6 +54,8 @@ class XtpRun final : public xtp::StateApplication {
 
  private:
   std::unique_ptr<xtp::QMCalculator> calc_ = nullptr;
+  // instances of calc_ with a share of the threads for concurrent frames
+  std::vector<std::unique_ptr<xtp::QMCalculator>> workers_;
 };
 
 void XtpRun::CreateCalculator(const std::string& name) {
@@ -70,6 +74,34 @@ bool XtpRun::EvaluateFrame(xtp::Topology& top) {
   return calc_->EvaluateFrame(top);
 }
 
+Index XtpRun::PrepareConcurrentFrames(Index requested) {
+  if (!calc_->AllowsConcurrentFrames()) {
+    std::cout << "Calculator " << calc_->Identify()
+              << " writes shared output files, frames are evaluated one "
+                 "after another."
+              << std::endl;
+    return 1;
+  }
+  // the threads are split between the workers, calc_ keeps all of them for
+  // frames that are evaluated alone
+  Index nThreads =
+      std::max(OptionsMap()["nthreads"].as<Index>() / requested, Index(1));
+  workers_.clear();
+  for (Index i = 0; i < requested; i++) {
+    std::unique_ptr<xtp::QMCalculator> worker =
+        xtp::Calculators().Create(calc_->Identify());
+    worker->setnThreads(nThreads);
+    worker->setFrameUniqueOutput(true);
+    worker->Initialize(options_);
+    workers_.push_back(std::move(worker));
+  }
+  return requested;
+}
+
+bool XtpRun::EvaluateFrameOnWorker(xtp::Topology& top, Index worker) {
+  return workers_[worker]->EvaluateFrame(top);
+}
+
 int main(int argc, char** argv) {
 
   XtpRun xtprun;